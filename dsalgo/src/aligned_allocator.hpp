@@ -0,0 +1,48 @@
+// dsalgo/src/aligned_allocator.hpp
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include "hardware.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// std::allocator replacement that hands out `Align`-byte aligned storage, for
+// vectors whose first element has to start on a cache line.
+template <typename T, usize Align = cache_line_bytes>
+struct AlignedAllocator
+{
+    static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0, "Align must be a power of two >= alignof(T)");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept
+    {
+    }
+
+    [[nodiscard]] T* allocate(usize n)
+    {
+        if (n > std::numeric_limits<usize>::max() / sizeof(T)) throw std::bad_array_new_length();
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Align}));
+    }
+
+    void deallocate(T* p, usize) noexcept { ::operator delete(p, std::align_val_t{Align}); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Align>&) const noexcept
+    {
+        return true;
+    }
+};
+} // namespace dsalgo
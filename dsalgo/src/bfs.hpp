@@ -0,0 +1,263 @@
+// dsalgo/src/bfs.hpp
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <expected>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "graph.hpp"
+#include "hardware.hpp"
+#include "parallel.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// Hop distances and BFS-tree parents per dense vertex. The source is its own
+// parent; unreached vertices have distance `unreachable` and parent `invalid_vertex`.
+struct BfsResult
+{
+    static constexpr u32 unreachable = std::numeric_limits<u32>::max();
+
+    std::vector<u32> distance;
+    std::vector<VertexId> parent;
+
+    [[nodiscard]] bool reached(VertexId v) const noexcept { return distance[v] != unreachable; }
+};
+
+enum class BfsDirection
+{
+    Auto,
+    TopDown,  // frontier vertices claim their out-neighbours
+    BottomUp, // unvisited vertices search their in-neighbours
+};
+
+// Direction switch thresholds from Beamer et al.: go bottom-up once the
+// frontier's out-edges exceed 1/alpha of the unexplored edges, go back
+// top-down once the frontier shrinks below 1/beta of the vertices. Both are
+// only consulted for Auto, and 0 is treated as 1.
+struct BfsOptions
+{
+    BfsDirection direction = BfsDirection::Auto;
+    u64 alpha = 15;
+    u64 beta = 18;
+};
+
+namespace detail
+{
+// Per-worker scratch, padded so counters of neighbouring workers do not share a line.
+struct alignas(cache_line_bytes) BfsWorker
+{
+    std::vector<VertexId> next;
+    u64 frontier_edges = 0;
+    u64 frontier_size = 0;
+};
+
+inline bool test_bit(std::span<const u64> bits, VertexId v) noexcept
+{
+    return (bits[v / 64] >> (v % 64)) & 1u;
+}
+
+// Top-down step: every frontier vertex claims its unvisited out-neighbours
+// with a CAS on the parent slot, the winner records the distance.
+inline void bfs_top_down(const CsrAdjacency& out, std::span<const VertexId> frontier, u32 level,
+                         BfsResult& r, std::vector<BfsWorker>& workers)
+{
+    for (BfsWorker& w : workers)
+    {
+        w.next.clear();
+        w.frontier_edges = 0;
+    }
+
+    parallel_for_range(0, frontier.size(), 256, [&](usize lo, usize hi, usize worker) {
+        BfsWorker& w = workers[worker];
+        for (usize i = lo; i < hi; ++i)
+        {
+            const VertexId u = frontier[i];
+            for (VertexId v : out.neighbors(u))
+            {
+                std::atomic_ref<VertexId> slot{r.parent[v]};
+                VertexId expected = invalid_vertex;
+                if (slot.load(std::memory_order_relaxed) == invalid_vertex &&
+                    slot.compare_exchange_strong(expected, u, std::memory_order_relaxed))
+                {
+                    r.distance[v] = level + 1;
+                    w.next.push_back(v);
+                    w.frontier_edges += out.degree(v);
+                }
+            }
+        }
+    });
+}
+
+// Bottom-up step: every unvisited vertex looks for any parent in the
+// frontier bitmap and stops at the first hit. Chunks are word aligned so
+// each worker owns the bitmap words it writes.
+inline void bfs_bottom_up(const CsrAdjacency& out, const CsrAdjacency& in, std::span<const u64> frontier,
+                          std::span<u64> next, u32 level, BfsResult& r, std::vector<BfsWorker>& workers)
+{
+    for (BfsWorker& w : workers)
+    {
+        w.frontier_edges = 0;
+        w.frontier_size = 0;
+    }
+    std::ranges::fill(next, 0);
+
+    const usize n = out.vertex_count();
+    parallel_for_range(0, n, 64 * 64, [&](usize lo, usize hi, usize worker) {
+        BfsWorker& w = workers[worker];
+        for (usize i = lo; i < hi; ++i)
+        {
+            const auto v = static_cast<VertexId>(i);
+            if (r.parent[v] != invalid_vertex) continue;
+            for (VertexId u : in.neighbors(v))
+            {
+                if (test_bit(frontier, u))
+                {
+                    r.parent[v] = u;
+                    r.distance[v] = level + 1;
+                    next[v / 64] |= u64{1} << (v % 64);
+                    ++w.frontier_size;
+                    w.frontier_edges += out.degree(v);
+                    break;
+                }
+            }
+        }
+    });
+}
+} // namespace detail
+
+// Direction-optimizing BFS over a CSR adjacency and its transpose (see
+// CsrAdjacency::transposed). Both directions run on the default thread pool.
+[[nodiscard]] inline BfsResult bfs(const CsrAdjacency& out, const CsrAdjacency& in, VertexId source,
+                                   BfsOptions options = {})
+{
+    const usize n = out.vertex_count();
+    BfsResult r;
+    r.distance.assign(n, BfsResult::unreachable);
+    r.parent.assign(n, invalid_vertex);
+    if (source >= n) return r;
+
+    r.distance[source] = 0;
+    r.parent[source] = source;
+
+    std::vector<detail::BfsWorker> workers(default_thread_pool().thread_count());
+    std::vector<VertexId> frontier{source};
+    std::vector<u64> front_bits;
+    std::vector<u64> next_bits;
+    bool bottom_up = false;
+    const u64 alpha = std::max<u64>(options.alpha, 1);
+    const u64 beta = std::max<u64>(options.beta, 1);
+
+    u64 frontier_edges = out.degree(source);
+    u64 frontier_size = 1;
+    u64 unexplored_edges = out.edge_count();
+
+    for (u32 level = 0; frontier_size != 0; ++level)
+    {
+        unexplored_edges -= std::min(unexplored_edges, frontier_edges);
+
+        const bool want_bottom_up = options.direction == BfsDirection::Auto
+                                        ? (bottom_up ? frontier_size >= n / beta : frontier_edges > unexplored_edges / alpha)
+                                        : options.direction == BfsDirection::BottomUp;
+        if (!bottom_up && want_bottom_up)
+        {
+            bottom_up = true;
+            front_bits.assign((n + 63) / 64, 0);
+            next_bits.assign(front_bits.size(), 0);
+            for (VertexId v : frontier) front_bits[v / 64] |= u64{1} << (v % 64);
+        }
+        else if (bottom_up && !want_bottom_up)
+        {
+            bottom_up = false;
+            frontier.clear();
+            for (usize word = 0; word < front_bits.size(); ++word)
+            {
+                for (u64 bits = front_bits[word]; bits != 0; bits &= bits - 1)
+                {
+                    frontier.push_back(static_cast<VertexId>(word * 64 + static_cast<usize>(std::countr_zero(bits))));
+                }
+            }
+        }
+
+        frontier_edges = 0;
+        frontier_size = 0;
+        if (bottom_up)
+        {
+            detail::bfs_bottom_up(out, in, front_bits, next_bits, level, r, workers);
+            std::swap(front_bits, next_bits);
+            for (const detail::BfsWorker& w : workers)
+            {
+                frontier_edges += w.frontier_edges;
+                frontier_size += w.frontier_size;
+            }
+        }
+        else
+        {
+            detail::bfs_top_down(out, frontier, level, r, workers);
+            frontier.clear();
+            for (const detail::BfsWorker& w : workers)
+            {
+                frontier.insert(frontier.end(), w.next.begin(), w.next.end());
+                frontier_edges += w.frontier_edges;
+            }
+            frontier_size = frontier.size();
+        }
+    }
+    return r;
+}
+
+template <typename T>
+[[nodiscard]] BfsResult bfs(const CsrGraph<T>& g, VertexId source, BfsOptions options = {})
+{
+    return bfs(g.adjacency(), g.in_adjacency(), source, options);
+}
+
+// BFS on a mutable Graph: freezes it and keeps the snapshot so results can
+// be queried by GraphIndex. Every call freezes again; for repeated queries
+// freeze once and use the CsrGraph overload, which reuses the in-adjacency.
+template <typename T>
+struct GraphBfs
+{
+    CsrGraph<T> graph;
+    BfsResult result;
+
+    [[nodiscard]] std::optional<u32> distance(GraphIndex idx) const noexcept
+    {
+        const auto v = graph.dense_id(idx);
+        if (!v || !result.reached(*v)) return std::nullopt;
+        return result.distance[*v];
+    }
+
+    [[nodiscard]] std::optional<GraphIndex> parent(GraphIndex idx) const noexcept
+    {
+        const auto v = graph.dense_id(idx);
+        if (!v || !result.reached(*v)) return std::nullopt;
+        return graph.external_id(result.parent[*v]);
+    }
+};
+
+enum class BfsError
+{
+    SourceMissing,
+    FreezeFailed,
+};
+
+template <typename T>
+[[nodiscard]] std::expected<GraphBfs<T>, BfsError> bfs(const Graph<T>& g, GraphIndex source, BfsOptions options = {})
+{
+    auto frozen = g.freeze();
+    if (!frozen) return std::unexpected(BfsError::FreezeFailed);
+    const auto src = frozen->dense_id(source);
+    if (!src) return std::unexpected(BfsError::SourceMissing);
+
+    BfsResult result = bfs(*frozen, *src, options);
+    return GraphBfs<T>{std::move(*frozen), std::move(result)};
+}
+} // namespace dsalgo
@@ -3,16 +3,27 @@
 
 #include <format>
 #include <memory>
-#include <string>
 #include <string_view>
 #include <utility>
 
+#include "tree_format.hpp"
+
 namespace dsalgo {
 template <typename T>
 struct BinaryTreeNode
 {
     explicit BinaryTreeNode(T value) : m_value(std::move(value)) {}
 
+    BinaryTreeNode(BinaryTreeNode&&) noexcept = default;
+    // The old subtrees go through ~BinaryTreeNode, which does not recurse.
+    BinaryTreeNode& operator=(BinaryTreeNode&&) noexcept = default;
+
+    ~BinaryTreeNode()
+    {
+        free_subtree(std::move(m_left));
+        free_subtree(std::move(m_right));
+    }
+
     T m_value;
 
     void set_left(T value)
@@ -33,9 +44,58 @@ struct BinaryTreeNode
     const BinaryTreeNode* right() const noexcept { return m_right.get(); }
 
 private:
+    // Rotates left children up until the top node has none, then frees it
+    // and moves down its right link: a loop with no allocation, whatever
+    // the shape of the tree.
+    static void free_subtree(std::unique_ptr<BinaryTreeNode> node) noexcept
+    {
+        while (node)
+        {
+            if (node->m_left)
+            {
+                std::unique_ptr<BinaryTreeNode> left = std::move(node->m_left);
+                node->m_left = std::move(left->m_right);
+                left->m_right = std::move(node);
+                node = std::move(left);
+            }
+            else
+            {
+                node = std::move(node->m_right);
+            }
+        }
+    }
+
     std::unique_ptr<BinaryTreeNode> m_left = nullptr;
     std::unique_ptr<BinaryTreeNode> m_right = nullptr;
 };
+
+namespace detail
+{
+template <typename T>
+struct BinaryTreeNodeFormatAdaptor
+{
+    using handle = const BinaryTreeNode<T>*;
+    // 0 = left, 1 = right, 2 = past the end
+    using cursor = unsigned;
+
+    handle m_root;
+
+    handle root() const noexcept { return m_root; }
+    cursor first(handle h) const noexcept { return h->left() ? 0u : next(h, 0u); }
+    bool valid(handle, cursor c) const noexcept { return c < 2u; }
+    cursor next(handle h, cursor c) const noexcept { return (c == 0u && h->right()) ? 1u : 2u; }
+    handle child(handle h, cursor c) const noexcept { return c == 0u ? h->left() : h->right(); }
+    bool is_last(handle h, cursor c) const noexcept { return next(h, c) == 2u; }
+    std::string_view label(handle, cursor c, size_t) const noexcept { return c == 0u ? "L" : "R"; }
+    const T& value(handle h) const noexcept { return h->m_value; }
+};
+} // namespace detail
+
+template <typename T>
+detail::BinaryTreeNodeFormatAdaptor<T> format_adaptor(const BinaryTreeNode<T>& node) noexcept
+{
+    return {&node};
+}
 } // namespace dsalgo
 
 template <typename T>
@@ -52,48 +112,6 @@ struct std::formatter<dsalgo::BinaryTreeNode<T>>
 
     auto format(const dsalgo::BinaryTreeNode<T>& node, std::format_context& ctx) const
     {
-        auto out = ctx.out();
-        out = std::format_to(out, "root: {}\n", node.m_value);
-
-        const auto* l = node.left();
-        const auto* r = node.right();
-        const bool has_l = (l != nullptr);
-        const bool has_r = (r != nullptr);
-
-        if (has_l) out = format_child(*l, out, "", "L", !has_r);
-        if (has_r) out = format_child(*r, out, "", "R", true);
-
-        return out;
-    }
-
-private:
-    static auto format_child(
-        const dsalgo::BinaryTreeNode<T>& node,
-        std::format_context::iterator out,
-        const std::string& prefix,
-        std::string_view label,
-        bool is_last
-    ) -> std::format_context::iterator
-    {
-        out = std::format_to(
-            out,
-            "{}{}── {}: {}\n",
-            prefix,
-            (is_last ? "└" : "├"),
-            label,
-            node.m_value
-        );
-
-        std::string next_prefix = prefix + (is_last ? "    " : "│   ");
-
-        const auto* l = node.left();
-        const auto* r = node.right();
-        const bool has_l = (l != nullptr);
-        const bool has_r = (r != nullptr);
-
-        if (has_l) out = format_child(*l, out, next_prefix, "L", !has_r);
-        if (has_r) out = format_child(*r, out, next_prefix, "R", true);
-
-        return out;
+        return dsalgo::detail::format_tree(dsalgo::format_adaptor(node), ctx.out(), [] { return true; });
     }
 };
\ No newline at end of file
@@ -0,0 +1,457 @@
+// dsalgo/src/bplus_tree.hpp
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "hardware.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// In-memory B+ tree for arithmetic keys. Every node occupies a whole number
+// of cache lines (`NodeBytes`, bplus_node_bytes by default), so a lookup
+// touches one node per level instead of one per binary split. Unused key slots are
+// padded with the largest key, which lets the in-node search count
+// `keys[i] < x` over the full fixed-width array: no branches, no early exit,
+// and a loop the compiler turns into vector compares.
+//
+// Leaves are chained for range scans. erase() only removes the entry from its
+// leaf (no merging), which keeps separators valid; rebuild with bulk_load()
+// after heavy deletion.
+// Default node width, derived from the line and page sizes in hardware.hpp.
+// A disk B-tree sizes nodes to a page because it reads whole pages; here the
+// unit of transfer is the cache line and the in-node search scans every slot,
+// so a node is a few lines: four give a fan-out of 15-20 for 8-byte keys while
+// the lines of one node are fetched in parallel. The page size only bounds
+// the node from above: nodes are aligned to their power-of-two width, so a
+// node no wider than a page never spans two and costs one TLB entry.
+inline constexpr usize bplus_node_bytes = std::min<usize>(4 * cache_line_bytes, page_bytes);
+
+template <typename K, typename V, usize NodeBytes = bplus_node_bytes>
+    requires(std::is_arithmetic_v<K> && std::is_trivially_copyable_v<V> && std::default_initializable<V>)
+class BPlusTree
+{
+    static_assert(NodeBytes % cache_line_bytes == 0, "NodeBytes must be a multiple of the cache line");
+    static_assert(NodeBytes <= page_bytes, "a node wider than a page costs one TLB entry per page it spans");
+
+    using index_type = u32;
+    static constexpr index_type npos = std::numeric_limits<index_type>::max();
+    static constexpr K key_pad = std::numeric_limits<K>::max();
+
+public:
+    static constexpr usize leaf_capacity = (NodeBytes - 2 * sizeof(index_type)) / (sizeof(K) + sizeof(V));
+    static constexpr usize inner_capacity = (NodeBytes - 2 * sizeof(index_type)) / (sizeof(K) + sizeof(index_type));
+    static_assert(leaf_capacity >= 2 && inner_capacity >= 2, "NodeBytes too small for K/V");
+
+private:
+    // Power-of-two widths are aligned to themselves, so a node never
+    // straddles a page; other widths fall back to line alignment.
+    static constexpr usize node_align = std::has_single_bit(NodeBytes) ? NodeBytes : cache_line_bytes;
+
+    struct alignas(node_align) Leaf
+    {
+        K keys[leaf_capacity];
+        V values[leaf_capacity];
+        index_type count = 0;
+        index_type next = npos;
+
+        Leaf() { std::fill_n(keys, leaf_capacity, key_pad); }
+    };
+
+    struct alignas(node_align) Inner
+    {
+        K keys[inner_capacity];
+        index_type children[inner_capacity + 1];
+        index_type count = 0; // number of keys, children = count + 1
+
+        Inner() { std::fill_n(keys, inner_capacity, key_pad); }
+    };
+
+    static_assert(sizeof(Leaf) <= NodeBytes && sizeof(Inner) <= NodeBytes);
+
+    // Branch-free in-node search over the whole padded key array. The clamp
+    // only matters for keys at or beyond the padding value.
+    template <usize N>
+    static usize rank_less(const K (&keys)[N], usize count, K x) noexcept
+    {
+        usize r = 0;
+        for (usize i = 0; i < N; ++i) r += static_cast<usize>(keys[i] < x);
+        return std::min(r, count);
+    }
+
+    template <usize N>
+    static usize rank_less_equal(const K (&keys)[N], usize count, K x) noexcept
+    {
+        usize r = 0;
+        for (usize i = 0; i < N; ++i) r += static_cast<usize>(!(x < keys[i]));
+        return std::min(r, count);
+    }
+
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<K, V>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const K&, const V&>;
+
+        const_iterator() = default;
+
+        reference operator*() const noexcept
+        {
+            const Leaf& l = m_tree->m_leaves[m_leaf];
+            return {l.keys[m_pos], l.values[m_pos]};
+        }
+
+        const_iterator& operator++() noexcept
+        {
+            ++m_pos;
+            skip_exhausted();
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept
+        {
+            const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const const_iterator& a, const const_iterator& b) noexcept
+        {
+            return a.m_leaf == b.m_leaf && a.m_pos == b.m_pos;
+        }
+
+    private:
+        friend class BPlusTree;
+
+        const_iterator(const BPlusTree* tree, index_type leaf, usize pos) noexcept
+            : m_tree(tree), m_leaf(leaf), m_pos(pos)
+        {
+            skip_exhausted();
+        }
+
+        // Moves past the end of a leaf (and past leaves emptied by erase).
+        void skip_exhausted() noexcept
+        {
+            while (m_leaf != npos && m_pos >= m_tree->m_leaves[m_leaf].count)
+            {
+                m_leaf = m_tree->m_leaves[m_leaf].next;
+                m_pos = 0;
+            }
+        }
+
+        const BPlusTree* m_tree = nullptr;
+        index_type m_leaf = npos;
+        usize m_pos = 0;
+    };
+
+    BPlusTree() { m_leaves.emplace_back(); }
+
+    // Builds the tree bottom-up from strictly increasing keys, filling every node.
+    [[nodiscard]]
+    static BPlusTree bulk_load(std::span<const K> keys, std::span<const V> values)
+    {
+        if (keys.size() != values.size()) throw std::invalid_argument("BPlusTree::bulk_load: size mismatch");
+        if (std::ranges::adjacent_find(keys, std::ranges::greater_equal{}) != keys.end())
+        {
+            throw std::invalid_argument("BPlusTree::bulk_load: keys must be strictly increasing");
+        }
+
+        BPlusTree t;
+        if (keys.empty()) return t;
+
+        t.m_leaves.clear();
+        t.m_leaves.reserve((keys.size() + leaf_capacity - 1) / leaf_capacity);
+
+        // level holds (node index, smallest key below it)
+        std::vector<std::pair<index_type, K>> level;
+        for (usize i = 0; i < keys.size(); i += leaf_capacity)
+        {
+            const usize n = std::min(leaf_capacity, keys.size() - i);
+            const auto idx = t.new_leaf();
+            Leaf& l = t.m_leaves[idx];
+            std::copy_n(keys.begin() + static_cast<isize>(i), n, l.keys);
+            std::copy_n(values.begin() + static_cast<isize>(i), n, l.values);
+            l.count = static_cast<index_type>(n);
+            if (idx > 0) t.m_leaves[idx - 1].next = idx;
+            level.emplace_back(idx, keys[i]);
+        }
+
+        while (level.size() > 1)
+        {
+            // Spread children evenly so no parent ends up with a single child.
+            const usize parent_count = (level.size() + inner_capacity) / (inner_capacity + 1);
+            std::vector<std::pair<index_type, K>> parents;
+            parents.reserve(parent_count);
+
+            usize begin = 0;
+            for (usize p = 0; p < parent_count; ++p)
+            {
+                const usize end = (level.size() * (p + 1)) / parent_count;
+                const auto idx = t.new_inner();
+                Inner& in = t.m_inners[idx];
+                for (usize c = begin; c < end; ++c)
+                {
+                    in.children[c - begin] = level[c].first;
+                    if (c > begin) in.keys[c - begin - 1] = level[c].second;
+                }
+                in.count = static_cast<index_type>(end - begin - 1);
+                parents.emplace_back(idx, level[begin].second);
+                begin = end;
+            }
+            level = std::move(parents);
+            ++t.m_height;
+        }
+
+        t.m_root = level.front().first;
+        t.m_size = keys.size();
+        return t;
+    }
+
+    // Returns true if the key was new, otherwise overwrites the value and returns false.
+    bool insert(K key, V value)
+    {
+        index_type path_nodes[max_height];
+        usize path_slots[max_height];
+
+        index_type node = m_root;
+        for (usize level = 0; level < m_height; ++level)
+        {
+            const Inner& in = m_inners[node];
+            const usize slot = rank_less_equal(in.keys, in.count, key);
+            path_nodes[level] = node;
+            path_slots[level] = slot;
+            node = in.children[slot];
+        }
+
+        Leaf& leaf = m_leaves[node];
+        const usize pos = rank_less(leaf.keys, leaf.count, key);
+        if (pos < leaf.count && !(key < leaf.keys[pos]))
+        {
+            leaf.values[pos] = value;
+            return false;
+        }
+        ++m_size;
+
+        if (leaf.count < leaf_capacity)
+        {
+            insert_into_leaf(leaf, pos, key, value);
+            return true;
+        }
+
+        auto [sep, right] = split_leaf(node, pos, key, value);
+        for (usize level = m_height; level-- > 0;)
+        {
+            Inner& in = m_inners[path_nodes[level]];
+            if (in.count < inner_capacity)
+            {
+                insert_into_inner(in, path_slots[level], sep, right);
+                return true;
+            }
+            std::tie(sep, right) = split_inner(path_nodes[level], path_slots[level], sep, right);
+        }
+
+        // The root split: grow the tree by one level.
+        if (m_height + 1 >= max_height) throw std::length_error("BPlusTree: height limit reached");
+        const auto root = new_inner();
+        Inner& r = m_inners[root];
+        r.keys[0] = sep;
+        r.children[0] = m_root;
+        r.children[1] = right;
+        r.count = 1;
+        m_root = root;
+        ++m_height;
+        return true;
+    }
+
+    bool erase(K key)
+    {
+        Leaf& leaf = m_leaves[find_leaf(key)];
+        const usize pos = rank_less(leaf.keys, leaf.count, key);
+        if (pos >= leaf.count || key < leaf.keys[pos]) return false;
+
+        std::copy(leaf.keys + pos + 1, leaf.keys + leaf.count, leaf.keys + pos);
+        std::copy(leaf.values + pos + 1, leaf.values + leaf.count, leaf.values + pos);
+        --leaf.count;
+        leaf.keys[leaf.count] = key_pad;
+        --m_size;
+        return true;
+    }
+
+    [[nodiscard]] const V* find(K key) const noexcept
+    {
+        const Leaf& leaf = m_leaves[find_leaf(key)];
+        const usize pos = rank_less(leaf.keys, leaf.count, key);
+        if (pos >= leaf.count || key < leaf.keys[pos]) return nullptr;
+        return &leaf.values[pos];
+    }
+
+    [[nodiscard]] V* find(K key) noexcept { return const_cast<V*>(std::as_const(*this).find(key)); }
+
+    [[nodiscard]] bool contains(K key) const noexcept { return find(key) != nullptr; }
+
+    // First entry whose key is not less than `key`.
+    [[nodiscard]] const_iterator lower_bound(K key) const noexcept
+    {
+        const index_type leaf = find_leaf(key);
+        return const_iterator{this, leaf, rank_less(m_leaves[leaf].keys, m_leaves[leaf].count, key)};
+    }
+
+    // Entries with keys in [lo, hi), walked along the leaf chain.
+    [[nodiscard]] auto range(K lo, K hi) const noexcept
+    {
+        return std::ranges::subrange(lower_bound(lo), lower_bound(hi));
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept { return const_iterator{this, leftmost_leaf(), 0}; }
+    [[nodiscard]] const_iterator end() const noexcept { return const_iterator{}; }
+
+    [[nodiscard]] usize size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] usize height() const noexcept { return m_height + 1; }
+
+private:
+    static constexpr usize max_height = 32;
+
+    index_type new_leaf()
+    {
+        if (m_leaves.size() >= npos) throw std::length_error("BPlusTree: too many leaves");
+        m_leaves.emplace_back();
+        return static_cast<index_type>(m_leaves.size() - 1);
+    }
+
+    index_type new_inner()
+    {
+        if (m_inners.size() >= npos) throw std::length_error("BPlusTree: too many inner nodes");
+        m_inners.emplace_back();
+        return static_cast<index_type>(m_inners.size() - 1);
+    }
+
+    index_type find_leaf(K key) const noexcept
+    {
+        index_type node = m_root;
+        for (usize level = 0; level < m_height; ++level)
+        {
+            const Inner& in = m_inners[node];
+            node = in.children[rank_less_equal(in.keys, in.count, key)];
+        }
+        return node;
+    }
+
+    index_type leftmost_leaf() const noexcept
+    {
+        index_type node = m_root;
+        for (usize level = 0; level < m_height; ++level) node = m_inners[node].children[0];
+        return node;
+    }
+
+    static void insert_into_leaf(Leaf& leaf, usize pos, K key, V value) noexcept
+    {
+        std::copy_backward(leaf.keys + pos, leaf.keys + leaf.count, leaf.keys + leaf.count + 1);
+        std::copy_backward(leaf.values + pos, leaf.values + leaf.count, leaf.values + leaf.count + 1);
+        leaf.keys[pos] = key;
+        leaf.values[pos] = value;
+        ++leaf.count;
+    }
+
+    static void insert_into_inner(Inner& in, usize slot, K sep, index_type right) noexcept
+    {
+        // `right` becomes the child after `slot`, `sep` the key between them.
+        std::copy_backward(in.keys + slot, in.keys + in.count, in.keys + in.count + 1);
+        std::copy_backward(in.children + slot + 1, in.children + in.count + 1, in.children + in.count + 2);
+        in.keys[slot] = sep;
+        in.children[slot + 1] = right;
+        ++in.count;
+    }
+
+    // Splits a full leaf while inserting (key, value) at pos; returns (separator, new right leaf).
+    std::pair<K, index_type> split_leaf(index_type idx, usize pos, K key, V value)
+    {
+        K keys[leaf_capacity + 1];
+        V values[leaf_capacity + 1];
+        {
+            const Leaf& l = m_leaves[idx];
+            std::copy_n(l.keys, pos, keys);
+            std::copy_n(l.values, pos, values);
+            keys[pos] = key;
+            values[pos] = value;
+            std::copy(l.keys + pos, l.keys + leaf_capacity, keys + pos + 1);
+            std::copy(l.values + pos, l.values + leaf_capacity, values + pos + 1);
+        }
+
+        const index_type right_idx = new_leaf(); // may reallocate m_leaves
+        Leaf& left = m_leaves[idx];
+        Leaf& right = m_leaves[right_idx];
+
+        constexpr usize total = leaf_capacity + 1;
+        constexpr usize mid = total / 2;
+
+        std::copy_n(keys, mid, left.keys);
+        std::copy_n(values, mid, left.values);
+        std::fill(left.keys + mid, left.keys + leaf_capacity, key_pad);
+        left.count = static_cast<index_type>(mid);
+
+        std::copy(keys + mid, keys + total, right.keys);
+        std::copy(values + mid, values + total, right.values);
+        right.count = static_cast<index_type>(total - mid);
+
+        right.next = left.next;
+        left.next = right_idx;
+        return {right.keys[0], right_idx};
+    }
+
+    // Splits a full inner node while inserting (sep, right) at slot; returns (key pushed up, new node).
+    std::pair<K, index_type> split_inner(index_type idx, usize slot, K sep, index_type right_child)
+    {
+        K keys[inner_capacity + 1];
+        index_type children[inner_capacity + 2];
+        {
+            const Inner& in = m_inners[idx];
+            std::copy_n(in.keys, slot, keys);
+            keys[slot] = sep;
+            std::copy(in.keys + slot, in.keys + inner_capacity, keys + slot + 1);
+
+            std::copy_n(in.children, slot + 1, children);
+            children[slot + 1] = right_child;
+            std::copy(in.children + slot + 1, in.children + inner_capacity + 1, children + slot + 2);
+        }
+
+        const index_type right_idx = new_inner(); // may reallocate m_inners
+        Inner& left = m_inners[idx];
+        Inner& right = m_inners[right_idx];
+
+        constexpr usize total = inner_capacity + 1; // keys
+        constexpr usize mid = total / 2;
+
+        std::copy_n(keys, mid, left.keys);
+        std::fill(left.keys + mid, left.keys + inner_capacity, key_pad);
+        std::copy_n(children, mid + 1, left.children);
+        left.count = static_cast<index_type>(mid);
+
+        std::copy(keys + mid + 1, keys + total, right.keys);
+        std::copy(children + mid + 1, children + total + 1, right.children);
+        right.count = static_cast<index_type>(total - mid - 1);
+
+        return {keys[mid], right_idx};
+    }
+
+    std::vector<Leaf> m_leaves;
+    std::vector<Inner> m_inners;
+    index_type m_root = 0;
+    usize m_height = 0; // number of inner levels above the leaves
+    usize m_size = 0;
+};
+} // namespace dsalgo
@@ -0,0 +1,207 @@
+// dsalgo/src/components.hpp
+#pragma once
+
+#include <algorithm>
+#include <expected>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "graph.hpp"
+#include "parallel.hpp"
+#include "types.hpp"
+#include "union_find.hpp"
+#include "util.hpp"
+
+namespace dsalgo
+{
+// Component label per dense vertex and the number of components. What a
+// label means depends on the algorithm, see below.
+struct Components
+{
+    std::vector<VertexId> label;
+    usize count = 0;
+};
+
+// Weakly connected components, Afforest style (Sutton et al.): link a couple
+// of sampled neighbors per vertex, guess the giant component from a random
+// sample, then only vertices outside it link their remaining edges. On
+// power-law graphs that skips most of the edge list. `in` is the transpose of
+// `out`; it lets skipped vertices still be reached from outside the giant
+// component. Each label is the smallest vertex id in its component.
+[[nodiscard]] inline Components weakly_connected_components(const CsrAdjacency& out, const CsrAdjacency& in,
+                                                             usize neighbor_rounds = 2)
+{
+    const usize n = out.vertex_count();
+    ConcurrentUnionFind uf{n};
+
+    for (usize round = 0; round < neighbor_rounds; ++round)
+    {
+        parallel_for(0, n, [&](usize i) {
+            const auto v = static_cast<VertexId>(i);
+            const auto ns = out.neighbors(v);
+            if (round < ns.size()) uf.unite(v, ns[round]);
+        });
+    }
+
+    // Most frequent root among a fixed pseudo-random sample.
+    VertexId giant = invalid_vertex;
+    if (n > 0)
+    {
+        std::unordered_map<VertexId, usize> votes;
+        usize best = 0;
+        u64 state = 0x5eed;
+        for (usize i = 0; i < std::min<usize>(n, 1024); ++i)
+        {
+            state = hash_int(state);
+            const VertexId root = uf.find(static_cast<VertexId>(state % n));
+            if (const usize c = ++votes[root]; c > best)
+            {
+                best = c;
+                giant = root;
+            }
+        }
+    }
+
+    parallel_for(0, n, [&](usize i) {
+        const auto v = static_cast<VertexId>(i);
+        if (uf.find(v) == giant) return;
+        const auto ns = out.neighbors(v);
+        for (usize k = neighbor_rounds; k < ns.size(); ++k) uf.unite(v, ns[k]);
+        for (VertexId u : in.neighbors(v)) uf.unite(v, u);
+    }, 256);
+
+    Components c;
+    c.label = uf.labels();
+    for (usize v = 0; v < n; ++v) c.count += c.label[v] == v;
+    return c;
+}
+
+// Strongly connected components with an iterative Tarjan (explicit DFS
+// stack, so deep graphs cannot overflow the call stack). Labels are
+// component indices 0 .. count - 1 in reverse topological order of the
+// condensation: an edge between components always goes to a lower label.
+[[nodiscard]] inline Components strongly_connected_components(const CsrAdjacency& g)
+{
+    constexpr VertexId unvisited = invalid_vertex;
+    const usize n = g.vertex_count();
+
+    struct Frame
+    {
+        VertexId v;
+        u64 cursor;
+    };
+
+    Components c;
+    c.label.assign(n, invalid_vertex);
+    std::vector<VertexId> index(n, unvisited);
+    std::vector<VertexId> low(n);
+    std::vector<VertexId> stack;
+    std::vector<Frame> frames;
+    VertexId next_index = 0;
+
+    const auto visit = [&](VertexId v) {
+        index[v] = low[v] = next_index++;
+        stack.push_back(v);
+        frames.push_back({v, g.offsets[v]});
+    };
+
+    for (usize s = 0; s < n; ++s)
+    {
+        if (index[s] != unvisited) continue;
+        visit(static_cast<VertexId>(s));
+
+        while (!frames.empty())
+        {
+            Frame& f = frames.back();
+            if (f.cursor < g.offsets[f.v + 1])
+            {
+                const VertexId w = g.edges[f.cursor++];
+                if (index[w] == unvisited) visit(w);
+                // Still on the stack iff visited but not yet assigned a component.
+                else if (c.label[w] == invalid_vertex) low[f.v] = std::min(low[f.v], index[w]);
+                continue;
+            }
+
+            const VertexId v = f.v;
+            frames.pop_back();
+            if (low[v] == index[v])
+            {
+                const auto id = static_cast<VertexId>(c.count++);
+                VertexId w = invalid_vertex;
+                do
+                {
+                    w = stack.back();
+                    stack.pop_back();
+                    c.label[w] = id;
+                } while (w != v);
+            }
+            if (!frames.empty())
+            {
+                const VertexId parent = frames.back().v;
+                low[parent] = std::min(low[parent], low[v]);
+            }
+        }
+    }
+    return c;
+}
+
+template <typename T>
+[[nodiscard]] Components weakly_connected_components(const CsrGraph<T>& g)
+{
+    return weakly_connected_components(g.adjacency(), g.in_adjacency());
+}
+
+template <typename T>
+[[nodiscard]] Components strongly_connected_components(const CsrGraph<T>& g)
+{
+    return strongly_connected_components(g.adjacency());
+}
+
+// Components of a mutable Graph: freezes it and keeps the snapshot so
+// results can be queried by GraphIndex.
+template <typename T>
+struct GraphComponents
+{
+    CsrGraph<T> graph;
+    Components components;
+
+    [[nodiscard]] std::optional<VertexId> component_of(GraphIndex idx) const noexcept
+    {
+        const auto v = graph.dense_id(idx);
+        if (!v) return std::nullopt;
+        return components.label[*v];
+    }
+
+    [[nodiscard]] bool same_component(GraphIndex a, GraphIndex b) const noexcept
+    {
+        const auto ca = component_of(a);
+        return ca && ca == component_of(b);
+    }
+};
+
+enum class ComponentsError
+{
+    FreezeFailed,
+};
+
+template <typename T>
+[[nodiscard]] std::expected<GraphComponents<T>, ComponentsError> weakly_connected_components(const Graph<T>& g)
+{
+    auto frozen = g.freeze();
+    if (!frozen) return std::unexpected(ComponentsError::FreezeFailed);
+    Components c = weakly_connected_components(*frozen);
+    return GraphComponents<T>{std::move(*frozen), std::move(c)};
+}
+
+template <typename T>
+[[nodiscard]] std::expected<GraphComponents<T>, ComponentsError> strongly_connected_components(const Graph<T>& g)
+{
+    auto frozen = g.freeze();
+    if (!frozen) return std::unexpected(ComponentsError::FreezeFailed);
+    Components c = strongly_connected_components(*frozen);
+    return GraphComponents<T>{std::move(*frozen), std::move(c)};
+}
+} // namespace dsalgo
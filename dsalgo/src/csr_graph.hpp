@@ -0,0 +1,256 @@
+// dsalgo/src/csr_graph.hpp
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "static_search_tree.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+using GraphIndex = u64;
+
+// Dense vertex id of a frozen graph, 0 .. vertex_count() - 1.
+using VertexId = u32;
+inline constexpr VertexId invalid_vertex = std::numeric_limits<VertexId>::max();
+
+// Edges added without an explicit weight weigh 1, so hop counts and
+// weighted distances agree on unweighted graphs.
+//
+// Repeated arcs are never summed or minimised: every way of building a graph
+// (Graph::add_edge / add_edges, the graph_io loaders, the benchmark
+// generators) keeps the first occurrence in input order with its weight and
+// drops the later ones, so one edge list always yields one weighted graph.
+using EdgeWeight = u32;
+inline constexpr EdgeWeight default_edge_weight = 1;
+
+// Compressed sparse row adjacency: the neighbors of v are
+// edges[offsets[v] .. offsets[v + 1]). Two flat arrays, no per-vertex allocation.
+// `weights` is either empty (every edge weighs default_edge_weight) or
+// parallel to `edges`.
+struct CsrAdjacency
+{
+    std::vector<u64> offsets{0};
+    std::vector<VertexId> edges;
+    std::vector<EdgeWeight> weights;
+
+    // Unweighted adjacency with lists[v] as the out-neighbors of v, kept in
+    // the given order.
+    [[nodiscard]] static CsrAdjacency from_lists(const std::vector<std::vector<VertexId>>& lists)
+    {
+        CsrAdjacency adj;
+        adj.offsets.reserve(lists.size() + 1);
+        for (const auto& list : lists)
+        {
+            adj.edges.insert(adj.edges.end(), list.begin(), list.end());
+            adj.offsets.push_back(adj.edges.size());
+        }
+        return adj;
+    }
+
+    [[nodiscard]] usize vertex_count() const noexcept { return offsets.size() - 1; }
+    [[nodiscard]] usize edge_count() const noexcept { return edges.size(); }
+
+    [[nodiscard]] std::span<const VertexId> neighbors(VertexId v) const noexcept
+    {
+        return {edges.data() + offsets[v], edges.data() + offsets[v + 1]};
+    }
+
+    [[nodiscard]] usize degree(VertexId v) const noexcept
+    {
+        return static_cast<usize>(offsets[v + 1] - offsets[v]);
+    }
+
+    [[nodiscard]] bool weighted() const noexcept { return !weights.empty(); }
+
+    // Weights of v's out-edges, parallel to neighbors(v); empty if unweighted.
+    [[nodiscard]] std::span<const EdgeWeight> edge_weights(VertexId v) const noexcept
+    {
+        if (!weighted()) return {};
+        return {weights.data() + offsets[v], weights.data() + offsets[v + 1]};
+    }
+
+    [[nodiscard]] EdgeWeight weight(u64 edge) const noexcept
+    {
+        return weighted() ? weights[edge] : default_edge_weight;
+    }
+
+    // Edge list with every edge reversed, i.e. the in-neighbors of each vertex.
+    // Neighbor lists stay sorted because sources are visited in increasing order.
+    [[nodiscard]] CsrAdjacency transposed() const
+    {
+        const usize n = vertex_count();
+        CsrAdjacency t;
+        t.offsets.assign(n + 1, 0);
+        t.edges.resize(edges.size());
+        if (weighted()) t.weights.resize(weights.size());
+
+        for (VertexId dst : edges) ++t.offsets[dst + 1];
+        for (usize v = 0; v < n; ++v) t.offsets[v + 1] += t.offsets[v];
+
+        std::vector<u64> cursor(t.offsets.begin(), t.offsets.end() - 1);
+        for (usize u = 0; u < n; ++u)
+        {
+            for (u64 e = offsets[u]; e < offsets[u + 1]; ++e)
+            {
+                const u64 slot = cursor[edges[e]]++;
+                t.edges[slot] = static_cast<VertexId>(u);
+                if (weighted()) t.weights[slot] = weights[e];
+            }
+        }
+        return t;
+    }
+
+    // Undirected view: u and v are adjacent if either edge exists. Rows stay
+    // sorted and duplicate-free, self-loops are dropped and weights are not kept.
+    [[nodiscard]] CsrAdjacency symmetrized() const
+    {
+        const usize n = vertex_count();
+        const CsrAdjacency in = transposed();
+        CsrAdjacency s;
+        s.offsets.reserve(n + 1);
+        s.edges.reserve(2 * edges.size());
+        for (usize v = 0; v < n; ++v)
+        {
+            const auto id = static_cast<VertexId>(v);
+            const auto a = neighbors(id);
+            const auto b = in.neighbors(id);
+            usize i = 0;
+            usize j = 0;
+            while (i < a.size() || j < b.size())
+            {
+                VertexId next;
+                if (j == b.size() || (i < a.size() && a[i] < b[j])) next = a[i++];
+                else if (i == a.size() || b[j] < a[i]) next = b[j++];
+                else
+                {
+                    next = a[i++];
+                    ++j;
+                }
+                if (next != id) s.edges.push_back(next);
+            }
+            s.offsets.push_back(s.edges.size());
+        }
+        return s;
+    }
+};
+
+// Read-only snapshot of a Graph (see Graph::freeze). Vertices are renumbered
+// to dense 32-bit ids in increasing order of their GraphIndex, so sorted
+// neighbor lists stay sorted; values live in a parallel array and the
+// external ids are searchable through a StaticSearchTree. Reordering passes
+// (reorder.hpp) build snapshots with any other dense numbering through
+// relabeled(). The in-adjacency (edges reversed) is built on first use and
+// kept, so repeated BFS / component / PageRank queries on one snapshot pay
+// for the transpose once; copies of a snapshot share it.
+template <typename T>
+class CsrGraph
+{
+public:
+    CsrGraph() = default;
+
+    // `ids` must be strictly increasing; adjacency holds dense ids.
+    CsrGraph(std::vector<GraphIndex> ids, std::vector<T> values, CsrAdjacency adjacency)
+        : CsrGraph(std::move(ids), std::move(values), std::move(adjacency), false)
+    {
+    }
+
+    // As the constructor, but `ids` only have to be unique: dense id v need
+    // not follow the order of the external ids.
+    [[nodiscard]] static CsrGraph relabeled(std::vector<GraphIndex> ids, std::vector<T> values, CsrAdjacency adjacency)
+    {
+        return CsrGraph(std::move(ids), std::move(values), std::move(adjacency), true);
+    }
+
+    [[nodiscard]] usize vertex_count() const noexcept { return m_ids.size(); }
+    [[nodiscard]] usize edge_count() const noexcept { return m_out.edge_count(); }
+
+    [[nodiscard]] std::span<const VertexId> neighbors(VertexId v) const noexcept { return m_out.neighbors(v); }
+    [[nodiscard]] usize degree(VertexId v) const noexcept { return m_out.degree(v); }
+    [[nodiscard]] std::span<const EdgeWeight> edge_weights(VertexId v) const noexcept { return m_out.edge_weights(v); }
+
+    [[nodiscard]] bool contains_edge(VertexId from, VertexId to) const noexcept
+    {
+        const auto ns = neighbors(from);
+        const VertexId* it = branchless_lower_bound(ns, to);
+        return it != ns.data() + ns.size() && *it == to;
+    }
+
+    [[nodiscard]] const T& value(VertexId v) const noexcept { return m_values[v]; }
+    [[nodiscard]] GraphIndex external_id(VertexId v) const noexcept { return m_ids[v]; }
+
+    [[nodiscard]] std::optional<VertexId> dense_id(GraphIndex idx) const noexcept
+    {
+        const usize pos = m_lookup.find(idx);
+        if (pos == StaticSearchTree<GraphIndex>::npos) return std::nullopt;
+        return m_sorted_to_dense.empty() ? static_cast<VertexId>(pos) : m_sorted_to_dense[pos];
+    }
+
+    [[nodiscard]] const CsrAdjacency& adjacency() const noexcept { return m_out; }
+
+    // adjacency().transposed(), computed once. Safe to call from several threads.
+    [[nodiscard]] const CsrAdjacency& in_adjacency() const
+    {
+        std::call_once(m_in->once, [this] { m_in->adjacency = m_out.transposed(); });
+        return m_in->adjacency;
+    }
+    [[nodiscard]] std::span<const GraphIndex> external_ids() const noexcept { return m_ids; }
+    [[nodiscard]] std::span<const T> values() const noexcept { return m_values; }
+
+private:
+    CsrGraph(std::vector<GraphIndex> ids, std::vector<T> values, CsrAdjacency adjacency, bool any_order)
+        : m_ids(std::move(ids)), m_values(std::move(values)), m_out(std::move(adjacency))
+    {
+        if (m_ids.size() != m_values.size() || m_ids.size() != m_out.vertex_count())
+        {
+            throw std::invalid_argument("CsrGraph: ids, values and adjacency disagree on vertex count");
+        }
+        if (m_out.weighted() && m_out.weights.size() != m_out.edges.size())
+        {
+            throw std::invalid_argument("CsrGraph: weights must be empty or parallel to edges");
+        }
+        if (m_ids.size() >= invalid_vertex) throw std::length_error("CsrGraph: too many vertices");
+
+        if (std::ranges::adjacent_find(m_ids, std::ranges::greater_equal{}) == m_ids.end())
+        {
+            m_lookup = StaticSearchTree<GraphIndex>{m_ids};
+            return;
+        }
+        if (!any_order) throw std::invalid_argument("CsrGraph: ids must be strictly increasing");
+
+        m_sorted_to_dense.resize(m_ids.size());
+        for (usize v = 0; v < m_ids.size(); ++v) m_sorted_to_dense[v] = static_cast<VertexId>(v);
+        std::ranges::sort(m_sorted_to_dense, {}, [this](VertexId v) { return m_ids[v]; });
+
+        std::vector<GraphIndex> sorted(m_ids.size());
+        for (usize i = 0; i < sorted.size(); ++i) sorted[i] = m_ids[m_sorted_to_dense[i]];
+        if (std::ranges::adjacent_find(sorted) != sorted.end())
+        {
+            throw std::invalid_argument("CsrGraph: ids must be unique");
+        }
+        m_lookup = StaticSearchTree<GraphIndex>{sorted};
+    }
+
+    struct InAdjacency
+    {
+        std::once_flag once;
+        CsrAdjacency adjacency;
+    };
+
+    std::vector<GraphIndex> m_ids;
+    std::vector<T> m_values;
+    CsrAdjacency m_out;
+    std::shared_ptr<InAdjacency> m_in = std::make_shared<InAdjacency>();
+    StaticSearchTree<GraphIndex> m_lookup;
+    // Sorted-id position -> dense id; empty when dense ids follow id order.
+    std::vector<VertexId> m_sorted_to_dense;
+};
+} // namespace dsalgo
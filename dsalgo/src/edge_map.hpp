@@ -0,0 +1,307 @@
+// dsalgo/src/edge_map.hpp
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "hardware.hpp"
+#include "parallel.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// Atomic helpers for edge_map update functions, which may run concurrently
+// for the same destination. All are relaxed: edge_map's round boundaries
+// are the synchronisation points.
+
+// slot = desired if it still equals `expected`; true if this call wrote it.
+template <std::integral T>
+bool compare_and_swap(T& slot, T expected, T desired) noexcept
+{
+    return std::atomic_ref<T>{slot}.compare_exchange_strong(expected, desired, std::memory_order_relaxed);
+}
+
+// slot = min(slot, value); true if this call lowered it.
+template <typename T>
+    requires std::integral<T> || std::floating_point<T>
+bool write_min(T& slot, T value) noexcept
+{
+    std::atomic_ref<T> ref{slot};
+    T cur = ref.load(std::memory_order_relaxed);
+    while (value < cur)
+    {
+        if (ref.compare_exchange_weak(cur, value, std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+template <typename T>
+    requires std::integral<T> || std::floating_point<T>
+T fetch_add(T& slot, T value) noexcept
+{
+    return std::atomic_ref<T>{slot}.fetch_add(value, std::memory_order_relaxed);
+}
+
+// A set of vertices out of [0, universe), stored either sparse (sorted id
+// list, cheap when small) or dense (one bit per vertex, cheap to test and to
+// fill in parallel). edge_map picks whichever the direction it runs in needs
+// and converts on the fly, so callers never have to.
+class VertexSubset
+{
+public:
+    explicit VertexSubset(usize universe = 0) : m_universe(universe) {}
+
+    VertexSubset(usize universe, VertexId v) : m_universe(universe), m_size(1), m_ids{v} {}
+
+    // Ids must be distinct.
+    VertexSubset(usize universe, std::vector<VertexId> ids)
+        : m_universe(universe), m_size(ids.size()), m_ids(std::move(ids))
+    {
+        std::ranges::sort(m_ids);
+    }
+
+    [[nodiscard]] static VertexSubset all(usize universe)
+    {
+        VertexSubset s{universe};
+        s.m_dense = true;
+        s.m_size = universe;
+        s.m_bits.assign((universe + 63) / 64, ~u64{0});
+        if (universe % 64 != 0) s.m_bits.back() = (u64{1} << (universe % 64)) - 1;
+        return s;
+    }
+
+    // Bits past `universe` must be clear; `size` is the number of set bits.
+    [[nodiscard]] static VertexSubset from_bits(usize universe, std::vector<u64> bits, usize size)
+    {
+        VertexSubset s{universe};
+        s.m_dense = true;
+        s.m_size = size;
+        s.m_bits = std::move(bits);
+        return s;
+    }
+
+    [[nodiscard]] usize universe() const noexcept { return m_universe; }
+    [[nodiscard]] usize size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] bool is_dense() const noexcept { return m_dense; }
+
+    [[nodiscard]] bool contains(VertexId v) const noexcept
+    {
+        if (m_dense) return (m_bits[v / 64] >> (v % 64)) & 1u;
+        return std::ranges::binary_search(m_ids, v);
+    }
+
+    // Only valid in the matching representation.
+    [[nodiscard]] std::span<const VertexId> ids() const noexcept { return m_ids; }
+    [[nodiscard]] std::span<const u64> bits() const noexcept { return m_bits; }
+
+    void to_dense()
+    {
+        if (m_dense) return;
+        m_bits.assign((m_universe + 63) / 64, 0);
+        for (VertexId v : m_ids) m_bits[v / 64] |= u64{1} << (v % 64);
+        m_ids = {};
+        m_dense = true;
+    }
+
+    void to_sparse()
+    {
+        if (!m_dense) return;
+        m_ids.clear();
+        m_ids.reserve(m_size);
+        for (usize w = 0; w < m_bits.size(); ++w)
+        {
+            for (u64 word = m_bits[w]; word != 0; word &= word - 1)
+            {
+                m_ids.push_back(static_cast<VertexId>(64 * w + static_cast<usize>(std::countr_zero(word))));
+            }
+        }
+        m_bits = {};
+        m_dense = false;
+    }
+
+    // Calls f(v) for every member, in parallel.
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        if (!m_dense)
+        {
+            parallel_for(0, m_ids.size(), [&](usize i) { f(m_ids[i]); });
+            return;
+        }
+        parallel_for_range(0, m_bits.size(), 64, [&](usize lo, usize hi, usize) {
+            for (usize w = lo; w < hi; ++w)
+            {
+                for (u64 word = m_bits[w]; word != 0; word &= word - 1)
+                {
+                    f(static_cast<VertexId>(64 * w + static_cast<usize>(std::countr_zero(word))));
+                }
+            }
+        });
+    }
+
+private:
+    usize m_universe = 0;
+    usize m_size = 0;
+    bool m_dense = false;
+    std::vector<VertexId> m_ids; // sorted
+    std::vector<u64> m_bits;
+};
+
+enum class EdgeMapDirection
+{
+    Auto,
+    Push, // sparse: frontier vertices scatter along out-edges
+    Pull, // dense: every candidate gathers from in-edges
+};
+
+struct EdgeMapOptions
+{
+    EdgeMapDirection direction = EdgeMapDirection::Auto;
+    // Auto pulls once the frontier plus its out-edges exceed edge_count / this.
+    u64 dense_divisor = 20;
+};
+
+namespace detail
+{
+struct alignas(cache_line_bytes) EdgeMapWorker
+{
+    std::vector<VertexId> out;
+};
+} // namespace detail
+
+// Ligra's edgeMap (Shun & Blelloch): for every edge u -> v with u in the
+// frontier and cond(v) true, call update(u, v); the returned subset holds the
+// v for which some update returned true. `in` is the transpose of `out` (the
+// same adjacency for symmetric graphs).
+//
+// Small frontiers are pushed along out-edges, where update(u, v) can run
+// concurrently for the same v and must use the atomic helpers above (or
+// otherwise tolerate it). Large ones switch to pulling: each v checks its
+// in-neighbours on one thread and stops as soon as cond(v) turns false, so
+// there updates never race. Push results come back sparse and sorted, pull
+// results dense.
+template <typename Update, typename Cond>
+[[nodiscard]] VertexSubset edge_map(const CsrAdjacency& out, const CsrAdjacency& in, const VertexSubset& frontier,
+                                    Update&& update, Cond&& cond, EdgeMapOptions options = {})
+{
+    const usize n = out.vertex_count();
+    if (frontier.empty()) return VertexSubset{n};
+
+    bool pull = options.direction == EdgeMapDirection::Pull;
+    if (options.direction == EdgeMapDirection::Auto)
+    {
+        u64 work = frontier.size();
+        if (frontier.is_dense()) work = out.edge_count(); // already large, no need to count
+        else
+        {
+            const auto ids = frontier.ids();
+            work += parallel_sum<u64>(0, ids.size(), [&](usize i) { return static_cast<u64>(out.degree(ids[i])); });
+        }
+        pull = work > out.edge_count() / std::max<u64>(options.dense_divisor, 1);
+    }
+
+    if (pull)
+    {
+        VertexSubset dense_copy{0};
+        const VertexSubset* src = &frontier;
+        if (!frontier.is_dense())
+        {
+            dense_copy = frontier;
+            dense_copy.to_dense();
+            src = &dense_copy;
+        }
+        const std::span<const u64> in_bits = src->bits();
+        std::vector<u64> next((n + 63) / 64, 0);
+
+        // 64-aligned chunks, so every bitmap word of `next` has a single writer.
+        const usize added = parallel_sum<usize>(0, n, [&](usize i) -> usize {
+            const auto v = static_cast<VertexId>(i);
+            if (!cond(v)) return 0;
+            bool hit = false;
+            for (VertexId u : in.neighbors(v))
+            {
+                if (((in_bits[u / 64] >> (u % 64)) & 1u) != 0 && update(u, v)) hit = true;
+                if (!cond(v)) break;
+            }
+            if (!hit) return 0;
+            next[v / 64] |= u64{1} << (v % 64);
+            return 1;
+        }, 64 * 64);
+        return VertexSubset::from_bits(n, std::move(next), added);
+    }
+
+    VertexSubset sparse_copy{0};
+    const VertexSubset* src = &frontier;
+    if (frontier.is_dense())
+    {
+        sparse_copy = frontier;
+        sparse_copy.to_sparse();
+        src = &sparse_copy;
+    }
+    const auto ids = src->ids();
+    std::vector<detail::EdgeMapWorker> workers(default_thread_pool().thread_count());
+    parallel_for_range(0, ids.size(), 64, [&](usize lo, usize hi, usize worker) {
+        auto& buffer = workers[worker].out;
+        for (usize i = lo; i < hi; ++i)
+        {
+            const VertexId u = ids[i];
+            for (VertexId v : out.neighbors(u))
+            {
+                if (cond(v) && update(u, v)) buffer.push_back(v);
+            }
+        }
+    });
+
+    std::vector<VertexId> next;
+    for (const detail::EdgeMapWorker& w : workers) next.insert(next.end(), w.out.begin(), w.out.end());
+    std::ranges::sort(next);
+    const auto dups = std::ranges::unique(next);
+    next.erase(dups.begin(), dups.end());
+    return VertexSubset{n, std::move(next)};
+}
+
+// Calls f(v) for every vertex in the subset, in parallel.
+template <typename F>
+void vertex_map(const VertexSubset& subset, F&& f)
+{
+    subset.for_each(f);
+}
+
+// The members for which pred(v) holds, in the subset's representation.
+template <typename Pred>
+[[nodiscard]] VertexSubset vertex_filter(const VertexSubset& subset, Pred&& pred)
+{
+    const usize n = subset.universe();
+    if (!subset.is_dense())
+    {
+        const auto ids = subset.ids();
+        std::vector<u8> keep(ids.size());
+        parallel_for(0, ids.size(), [&](usize i) { keep[i] = pred(ids[i]) ? 1 : 0; });
+        std::vector<VertexId> kept;
+        for (usize i = 0; i < ids.size(); ++i)
+        {
+            if (keep[i] != 0) kept.push_back(ids[i]);
+        }
+        return VertexSubset{n, std::move(kept)};
+    }
+
+    const auto bits = subset.bits();
+    std::vector<u64> kept(bits.size(), 0);
+    const usize size = parallel_sum<usize>(0, bits.size(), [&](usize w) -> usize {
+        for (u64 word = bits[w]; word != 0; word &= word - 1)
+        {
+            const auto b = static_cast<usize>(std::countr_zero(word));
+            if (pred(static_cast<VertexId>(64 * w + b))) kept[w] |= u64{1} << b;
+        }
+        return static_cast<usize>(std::popcount(kept[w]));
+    }, 64);
+    return VertexSubset::from_bits(n, std::move(kept), size);
+}
+} // namespace dsalgo
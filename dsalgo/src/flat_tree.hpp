@@ -0,0 +1,143 @@
+// dsalgo/src/flat_tree.hpp
+#pragma once
+
+#include <concepts>
+#include <format>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "tree_format.hpp"
+#include "tree_node.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// General tree stored in a single contiguous array. Nodes are linked through
+// 32-bit first-child / next-sibling indices instead of owning pointers, so
+// adding a node is an amortised push_back and no node owns an allocation.
+template <typename T>
+class FlatTree
+{
+public:
+    using index_type = u32;
+    static constexpr index_type npos = std::numeric_limits<index_type>::max();
+
+    explicit FlatTree(T root_value) { m_nodes.push_back(Node{std::move(root_value)}); }
+
+    // Lays the nodes out in BFS order, which keeps every sibling group adjacent in memory.
+    [[nodiscard]]
+    static FlatTree from_tree_node(const TreeNode<T>& root)
+        requires std::copy_constructible<T>
+    {
+        FlatTree out{root.value()};
+        std::vector<const TreeNode<T>*> source{&root};
+
+        for (usize i = 0; i < source.size(); ++i)
+        {
+            for (const auto& child : source[i]->children())
+            {
+                (void)out.create_new_child(static_cast<index_type>(i), child->value());
+                source.push_back(child.get());
+            }
+        }
+        return out;
+    }
+
+    void reserve(usize node_count) { m_nodes.reserve(node_count); }
+
+    index_type create_new_child(index_type parent, T value)
+    {
+        if (parent >= m_nodes.size()) throw std::out_of_range("FlatTree: parent index out of range");
+        if (m_nodes.size() >= npos) throw std::length_error("FlatTree: index space exhausted");
+
+        const auto idx = static_cast<index_type>(m_nodes.size());
+        m_nodes.push_back(Node{std::move(value)});
+
+        Node& p = m_nodes[parent];
+        if (p.last_child == npos) p.first_child = idx;
+        else m_nodes[p.last_child].next_sibling = idx;
+        p.last_child = idx;
+        ++p.child_count;
+        return idx;
+    }
+
+    // Walks the sibling chain, so this is O(idx); iterate with first_child/next_sibling instead.
+    [[nodiscard]] index_type child(index_type node, usize idx) const
+    {
+        const Node& n = m_nodes.at(node);
+        if (idx >= n.child_count) throw std::out_of_range("FlatTree: child index out of range");
+
+        index_type c = n.first_child;
+        for (usize i = 0; i < idx; ++i) c = m_nodes[c].next_sibling;
+        return c;
+    }
+
+    [[nodiscard]] static constexpr index_type root() noexcept { return 0; }
+    [[nodiscard]] usize size() const noexcept { return m_nodes.size(); }
+
+    [[nodiscard]] const T& value(index_type node) const { return m_nodes.at(node).value; }
+    [[nodiscard]] T& value(index_type node) { return m_nodes.at(node).value; }
+    [[nodiscard]] usize child_count(index_type node) const { return m_nodes.at(node).child_count; }
+    [[nodiscard]] index_type first_child(index_type node) const { return m_nodes.at(node).first_child; }
+    [[nodiscard]] index_type next_sibling(index_type node) const { return m_nodes.at(node).next_sibling; }
+
+private:
+    struct Node
+    {
+        T value;
+        index_type first_child = npos;
+        index_type last_child = npos;
+        index_type next_sibling = npos;
+        index_type child_count = 0;
+    };
+
+    std::vector<Node> m_nodes;
+};
+
+namespace detail
+{
+template <typename T>
+struct FlatTreeFormatAdaptor
+{
+    using handle = typename FlatTree<T>::index_type;
+    using cursor = typename FlatTree<T>::index_type;
+
+    const FlatTree<T>* m_tree;
+
+    handle root() const noexcept { return FlatTree<T>::root(); }
+    cursor first(handle h) const { return m_tree->first_child(h); }
+    bool valid(handle, cursor c) const noexcept { return c != FlatTree<T>::npos; }
+    cursor next(handle, cursor c) const { return m_tree->next_sibling(c); }
+    handle child(handle, cursor c) const noexcept { return c; }
+    bool is_last(handle, cursor c) const { return m_tree->next_sibling(c) == FlatTree<T>::npos; }
+    usize label(handle, cursor, usize idx) const noexcept { return idx; }
+    const T& value(handle h) const { return m_tree->value(h); }
+};
+} // namespace detail
+
+template <typename T>
+detail::FlatTreeFormatAdaptor<T> format_adaptor(const FlatTree<T>& tree) noexcept
+{
+    return {&tree};
+}
+} // namespace dsalgo
+
+template <typename T>
+struct std::formatter<dsalgo::FlatTree<T>>
+{
+    constexpr auto parse(std::format_parse_context& ctx)
+    {
+        auto it = ctx.begin();
+        if (it != ctx.end() && *it != '}') {
+            throw std::format_error("invalid format for FlatTree");
+        }
+        return it;
+    }
+
+    auto format(const dsalgo::FlatTree<T>& tree, std::format_context& ctx) const
+    {
+        return dsalgo::detail::format_tree(dsalgo::format_adaptor(tree), ctx.out(), [] { return true; });
+    }
+};
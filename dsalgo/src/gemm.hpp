@@ -0,0 +1,274 @@
+// dsalgo/src/gemm.hpp
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "hardware.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// Blocking parameters, following the BLIS decomposition (Van Zee & van de
+// Geijn). The micro-tile MR x NR is sized to the register file: MR rows of two
+// vectors each, 12 accumulators plus two B vectors and one broadcast. The
+// cache blocks come from hardware.hpp:
+//   kc: an MR x kc sliver of A plus a kc x NR sliver of B fill half of L1,
+//   mc: the packed mc x kc block of A fills half of L2,
+//   nc: the packed kc x nc panel of B fills half of L3 (L2 if there is none).
+template <std::floating_point T>
+struct GemmBlocking
+{
+    static constexpr usize mr = 6;
+    static constexpr usize nr = 2 * Simd<T>::lanes;
+
+    static constexpr usize kc = std::max<usize>(64, l1d_bytes / 2 / ((mr + nr) * sizeof(T)) / 16 * 16);
+    static constexpr usize mc = std::max<usize>(mr, (l2_bytes / 2 / (kc * sizeof(T))) / mr * mr);
+    static constexpr usize nc = std::max<usize>(nr, ((l3_bytes != 0 ? l3_bytes : l2_bytes) / 2 / (kc * sizeof(T))) / nr * nr);
+};
+
+namespace detail
+{
+template <typename T>
+using GemmBuffer = std::vector<T, AlignedAllocator<T>>;
+
+// A[0..mc) x [0..kc) into MR-row slivers, each stored column by column so the
+// micro-kernel reads it front to back; rows past mc are zero.
+template <std::floating_point T>
+void pack_a(usize mc, usize kc, const T* a, usize lda, T* out)
+{
+    constexpr usize mr = GemmBlocking<T>::mr;
+    for (usize i0 = 0; i0 < mc; i0 += mr)
+    {
+        const usize rows = std::min(mr, mc - i0);
+        for (usize p = 0; p < kc; ++p)
+        {
+            for (usize i = 0; i < rows; ++i) out[i] = a[(i0 + i) * lda + p];
+            for (usize i = rows; i < mr; ++i) out[i] = T{0};
+            out += mr;
+        }
+    }
+}
+
+// B[0..kc) x [0..nc) into NR-column slivers, row by row; columns past nc are zero.
+template <std::floating_point T>
+void pack_b(usize kc, usize nc, const T* b, usize ldb, T* out)
+{
+    constexpr usize nr = GemmBlocking<T>::nr;
+    for (usize j0 = 0; j0 < nc; j0 += nr)
+    {
+        const usize cols = std::min(nr, nc - j0);
+        for (usize p = 0; p < kc; ++p)
+        {
+            const T* src = b + p * ldb + j0;
+            std::copy_n(src, cols, out);
+            std::fill(out + cols, out + nr, T{0});
+            out += nr;
+        }
+    }
+}
+
+// C[MR x NR] (+)= A sliver * B sliver. The MR x 2 accumulators stay in
+// registers for all kc steps; each step is one broadcast of an A element and
+// two FMAs per row, with no dependency between the twelve chains.
+template <std::floating_point T>
+void micro_kernel(usize kc, const T* a, const T* b, T* c, usize ldc, bool accumulate)
+{
+    using S = Simd<T>;
+    constexpr usize mr = GemmBlocking<T>::mr;
+    constexpr usize lanes = S::lanes;
+
+    typename S::Reg acc[mr][2];
+    for (auto& row : acc) row[0] = row[1] = S::zero();
+
+    for (usize p = 0; p < kc; ++p)
+    {
+        const typename S::Reg b0 = S::load(b);
+        const typename S::Reg b1 = S::load(b + lanes);
+        for (usize i = 0; i < mr; ++i)
+        {
+            const typename S::Reg ai = S::broadcast(a[i]);
+            acc[i][0] = S::fma(ai, b0, acc[i][0]);
+            acc[i][1] = S::fma(ai, b1, acc[i][1]);
+        }
+        a += mr;
+        b += 2 * lanes;
+    }
+
+    for (usize i = 0; i < mr; ++i)
+    {
+        T* out = c + i * ldc;
+        if (accumulate)
+        {
+            acc[i][0] = S::add(acc[i][0], S::load(out));
+            acc[i][1] = S::add(acc[i][1], S::load(out + lanes));
+        }
+        S::store(out, acc[i][0]);
+        S::store(out + lanes, acc[i][1]);
+    }
+}
+
+// One mc x nc block of C from packed A and B. Edge tiles go through a
+// scratch tile so the kernel can always write a full MR x NR.
+template <std::floating_point T>
+void macro_kernel(usize mc, usize nc, usize kc, const T* packed_a, const T* packed_b, T* c, usize ldc, bool accumulate)
+{
+    constexpr usize mr = GemmBlocking<T>::mr;
+    constexpr usize nr = GemmBlocking<T>::nr;
+    alignas(64) T edge[mr * nr];
+
+    for (usize j0 = 0; j0 < nc; j0 += nr)
+    {
+        const usize cols = std::min(nr, nc - j0);
+        for (usize i0 = 0; i0 < mc; i0 += mr)
+        {
+            const usize rows = std::min(mr, mc - i0);
+            const T* a = packed_a + i0 * kc;
+            const T* b = packed_b + j0 * kc;
+            T* tile = c + i0 * ldc + j0;
+            if (rows == mr && cols == nr)
+            {
+                micro_kernel(kc, a, b, tile, ldc, accumulate);
+                continue;
+            }
+            micro_kernel(kc, a, b, edge, nr, false);
+            for (usize i = 0; i < rows; ++i)
+            {
+                for (usize j = 0; j < cols; ++j)
+                {
+                    T& dst = tile[i * ldc + j];
+                    dst = accumulate ? dst + edge[i * nr + j] : edge[i * nr + j];
+                }
+            }
+        }
+    }
+}
+} // namespace detail
+
+// C = A * B, or C += A * B with `accumulate`, for row-major m x k A, k x n B
+// and m x n C with leading dimensions lda, ldb, ldc (elements per row).
+// Five loops around the micro-kernel: nc-wide panels of B stay in L3, kc-deep
+// slices are packed once per panel, mc-tall blocks of A are packed into L2,
+// and every kernel call streams an A sliver from L2 against a B sliver in L1.
+template <std::floating_point T>
+void gemm(usize m, usize n, usize k, const T* a, usize lda, const T* b, usize ldb, T* c, usize ldc,
+          bool accumulate = false)
+{
+    using B = GemmBlocking<T>;
+    if (m == 0 || n == 0) return;
+    if (k == 0)
+    {
+        if (!accumulate)
+        {
+            for (usize i = 0; i < m; ++i) std::fill_n(c + i * ldc, n, T{0});
+        }
+        return;
+    }
+
+    thread_local detail::GemmBuffer<T> packed_a;
+    thread_local detail::GemmBuffer<T> packed_b;
+    packed_a.resize(std::max(packed_a.size(), (B::mc + B::mr) * B::kc));
+    packed_b.resize(std::max(packed_b.size(), (B::nc + B::nr) * B::kc));
+
+    for (usize jc = 0; jc < n; jc += B::nc)
+    {
+        const usize nc = std::min(B::nc, n - jc);
+        for (usize pc = 0; pc < k; pc += B::kc)
+        {
+            const usize kc = std::min(B::kc, k - pc);
+            detail::pack_b(kc, nc, b + pc * ldb + jc, ldb, packed_b.data());
+            const bool acc = accumulate || pc > 0;
+            for (usize ic = 0; ic < m; ic += B::mc)
+            {
+                const usize mc = std::min(B::mc, m - ic);
+                detail::pack_a(mc, kc, a + ic * lda + pc, lda, packed_a.data());
+                detail::macro_kernel(mc, nc, kc, packed_a.data(), packed_b.data(), c + ic * ldc + jc, ldc, acc);
+            }
+        }
+    }
+}
+
+// gemm on a thread pool. For every (nc, kc) panel the workers first pack the
+// shared B panel together, one NR sliver each, then split C into a grid of
+// macro-tiles: MR-aligned row blocks of at most mc, and as many NR-aligned
+// column groups as it takes to reach gemm_tasks_per_thread tasks per
+// worker, so a grid that does not divide evenly still keeps every worker
+// busy. Every worker packs A into its own buffer, so the only shared data is
+// the read-only B panel and each C element has exactly one writer. Small
+// products and single-thread pools take the serial path.
+inline constexpr usize gemm_tasks_per_thread = 2;
+
+template <std::floating_point T>
+void gemm_parallel(usize m, usize n, usize k, const T* a, usize lda, const T* b, usize ldb, T* c, usize ldc,
+                   bool accumulate = false, ThreadPool& pool = default_thread_pool())
+{
+    using B = GemmBlocking<T>;
+    const usize threads = pool.thread_count();
+    if (threads == 1 || k == 0 || m * n * k < 64 * 64 * 64)
+    {
+        gemm(m, n, k, a, lda, b, ldb, c, ldc, accumulate);
+        return;
+    }
+
+    const auto ceil_div = [](usize x, usize y) { return (x + y - 1) / y; };
+    const auto round_up = [&](usize x, usize to) { return ceil_div(x, to) * to; };
+    const usize target = gemm_tasks_per_thread * threads;
+    const usize row_block =
+        std::min(B::mc, round_up(ceil_div(m, std::min(target, ceil_div(m, B::mr))), B::mr));
+    const usize row_blocks = ceil_div(m, row_block);
+    const usize col_groups = ceil_div(target, row_blocks);
+
+    detail::GemmBuffer<T> packed_b((B::nc + B::nr) * B::kc);
+    std::vector<detail::GemmBuffer<T>> packed_a(threads);
+
+    for (usize jc = 0; jc < n; jc += B::nc)
+    {
+        const usize nc = std::min(B::nc, n - jc);
+        const usize col_block = round_up(ceil_div(nc, col_groups), B::nr);
+        const usize col_blocks = ceil_div(nc, col_block);
+
+        for (usize pc = 0; pc < k; pc += B::kc)
+        {
+            const usize kc = std::min(B::kc, k - pc);
+            const usize slivers = (nc + B::nr - 1) / B::nr;
+            pool.run(slivers, [&](usize s, usize) {
+                const usize j0 = s * B::nr;
+                detail::pack_b(kc, std::min(B::nr, nc - j0), b + pc * ldb + jc + j0, ldb, packed_b.data() + j0 * kc);
+            });
+
+            const bool acc = accumulate || pc > 0;
+            pool.run(row_blocks * col_blocks, [&](usize task, usize worker) {
+                const usize ic = (task / col_blocks) * row_block;
+                const usize j0 = (task % col_blocks) * col_block;
+                const usize mc = std::min(row_block, m - ic);
+                const usize width = std::min(col_block, nc - j0);
+
+                detail::GemmBuffer<T>& buf = packed_a[worker];
+                buf.resize((row_block + B::mr) * B::kc);
+                detail::pack_a(mc, kc, a + ic * lda + pc, lda, buf.data());
+                detail::macro_kernel(mc, width, kc, buf.data(), packed_b.data() + j0 * kc, c + ic * ldc + jc + j0, ldc, acc);
+            });
+        }
+    }
+}
+
+// Textbook i-j-k loop, kept as the reference the blocked kernel is tested
+// and benchmarked against.
+template <std::floating_point T>
+void gemm_naive(usize m, usize n, usize k, const T* a, usize lda, const T* b, usize ldb, T* c, usize ldc)
+{
+    for (usize i = 0; i < m; ++i)
+    {
+        for (usize j = 0; j < n; ++j)
+        {
+            T accum{0};
+            for (usize p = 0; p < k; ++p) accum += a[i * lda + p] * b[p * ldb + j];
+            c[i * ldc + j] = accum;
+        }
+    }
+}
+} // namespace dsalgo
@@ -1,18 +1,29 @@
 // graph.hpp
+#pragma once
+
 #include <algorithm>
+#include <cassert>
 #include <expected>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
 #include <print>
 #include <ranges>
 #include <span>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <optional>
 
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+#include "static_search_tree.hpp"
 #include "types.hpp"
+#include "util.hpp"
 
 namespace dsalgo
 {
-using GraphIndex = u64;
 
 template <typename T>
 class GraphNode
@@ -27,9 +38,23 @@ public:
     GraphIndex get_idx() const noexcept { return m_idx; }
 
     std::span<const GraphIndex> neighbors() const noexcept { return m_neighbors; }
+    // Parallel to neighbors().
+    std::span<const EdgeWeight> weights() const noexcept { return m_weights; }
+
+    // Calls f(neighbors(), weights()); VersionedNode splits the same call
+    // over its blocks, so freezing code can take either.
+    template <typename F>
+    void for_each_run(F&& f) const { f(neighbors(), weights()); }
+
+    std::optional<EdgeWeight> weight_to(GraphIndex idx) const noexcept {
+        const GraphIndex* it = branchless_lower_bound(neighbors(), idx);
+        if (it == m_neighbors.data() + m_neighbors.size() || *it != idx) return std::nullopt;
+        return m_weights[static_cast<usize>(it - m_neighbors.data())];
+    }
 
     bool contains_edge(GraphIndex idx) const noexcept {
-        return std::ranges::binary_search(m_neighbors, idx);
+        const GraphIndex* it = branchless_lower_bound(neighbors(), idx);
+        return it != m_neighbors.data() + m_neighbors.size() && *it == idx;
     }
 
     enum class AddNeighborError
@@ -40,7 +65,7 @@ public:
     
     [[nodiscard]]
     std::expected<void, AddNeighborError>
-    add_neighbor(GraphIndex idx)
+    add_neighbor(GraphIndex idx, EdgeWeight weight = default_edge_weight)
     {
         if (idx == m_idx)
         {
@@ -51,10 +76,81 @@ public:
         {
             return std::unexpected(AddNeighborError::DuplicateNeighbor);
         }
+        m_weights.insert(m_weights.begin() + (insertion_slot - m_neighbors.begin()), weight);
         m_neighbors.insert(insertion_slot, idx);
         return {};
     }
 
+    // Merges a sorted, duplicate-free batch not containing this node's own
+    // index in one linear pass; `weights` is parallel to `sorted`. Existing
+    // edges keep their weight. Returns how many were already neighbors.
+    usize merge_neighbors(std::span<const GraphIndex> sorted, std::span<const EdgeWeight> weights)
+    {
+        assert(sorted.size() == weights.size());
+        assert(std::ranges::adjacent_find(sorted, std::ranges::greater_equal{}) == sorted.end());
+        assert(!std::ranges::binary_search(sorted, m_idx));
+        if (sorted.empty()) return 0;
+
+        std::vector<GraphIndex> merged;
+        std::vector<EdgeWeight> merged_weights;
+        merged.reserve(m_neighbors.size() + sorted.size());
+        merged_weights.reserve(m_neighbors.size() + sorted.size());
+
+        usize i = 0;
+        usize j = 0;
+        usize existing = 0;
+        while (i < m_neighbors.size() || j < sorted.size())
+        {
+            if (j == sorted.size() || (i < m_neighbors.size() && m_neighbors[i] < sorted[j]))
+            {
+                merged.push_back(m_neighbors[i]);
+                merged_weights.push_back(m_weights[i++]);
+            }
+            else if (i == m_neighbors.size() || sorted[j] < m_neighbors[i])
+            {
+                merged.push_back(sorted[j]);
+                merged_weights.push_back(weights[j++]);
+            }
+            else
+            {
+                merged.push_back(m_neighbors[i]);
+                merged_weights.push_back(m_weights[i++]);
+                ++j;
+                ++existing;
+            }
+        }
+        m_neighbors = std::move(merged);
+        m_weights = std::move(merged_weights);
+        return existing;
+    }
+
+    bool remove_neighbor(GraphIndex idx)
+    {
+        const auto it = std::ranges::lower_bound(m_neighbors, idx);
+        if (it == m_neighbors.end() || *it != idx) return false;
+        m_weights.erase(m_weights.begin() + (it - m_neighbors.begin()));
+        m_neighbors.erase(it);
+        return true;
+    }
+
+    // Drops every neighbor for which pred(idx) holds in one compacting pass,
+    // weights staying aligned. Returns how many were removed.
+    template <typename Pred>
+    usize erase_neighbors_if(Pred pred)
+    {
+        usize kept = 0;
+        for (usize i = 0; i < m_neighbors.size(); ++i)
+        {
+            if (pred(m_neighbors[i])) continue;
+            m_neighbors[kept] = m_neighbors[i];
+            m_weights[kept++] = m_weights[i];
+        }
+        const usize removed = m_neighbors.size() - kept;
+        m_neighbors.resize(kept);
+        m_weights.resize(kept);
+        return removed;
+    }
+
     enum class ValidationError
     {
         UnsortedNeighbors,
@@ -84,6 +180,27 @@ private:
     T m_value;
     GraphIndex m_idx;
     std::vector<GraphIndex> m_neighbors;
+    std::vector<EdgeWeight> m_weights;
+};
+
+struct WeightedEdge
+{
+    GraphIndex from;
+    GraphIndex to;
+    EdgeWeight weight = default_edge_weight;
+};
+
+// A set of updates applied together by Graph::apply / VersionedGraph::apply,
+// in this order: edge removals, node removals (with all their edges), node
+// insertions, edge insertions. So a batch can drop a node and re-create it
+// without its old edges, and new edges may refer to nodes added alongside.
+template <typename T>
+struct GraphBatch
+{
+    std::vector<std::pair<GraphIndex, GraphIndex>> remove_edges;
+    std::vector<GraphIndex> remove_nodes;
+    std::vector<std::pair<GraphIndex, T>> add_nodes;
+    std::vector<WeightedEdge> add_edges;
 };
 
 template <typename T>
@@ -106,7 +223,7 @@ public:
     };
     [[nodiscard]]
     std::expected<void, AddEdgeError>
-    add_edge(GraphIndex idx0, GraphIndex idx1) {
+    add_edge(GraphIndex idx0, GraphIndex idx1, EdgeWeight weight = default_edge_weight) {
         using E = AddEdgeError;
 
         if(idx0 == idx1) return std::unexpected(E::SelfLoop);
@@ -117,7 +234,7 @@ public:
 
         if(!m_nodes.contains(idx1)) return std::unexpected(E::NodeToMissing);
 
-        auto res = node0.add_neighbor(idx1);
+        auto res = node0.add_neighbor(idx1, weight);
         if(!res) {
             using EE = GraphNode<T>::AddNeighborError;
             switch(res.error()) {
@@ -131,6 +248,148 @@ public:
         return {};
     }
 
+    // Outcome of add_edges: how many edges went in and how many were
+    // rejected for each AddEdgeError, classified as add_edge would have.
+    struct AddEdgesReport
+    {
+        usize added = 0;
+        usize node_from_missing = 0;
+        usize node_to_missing = 0;
+        usize edge_exists = 0; // already present or repeated within the batch
+        usize self_loop = 0;
+
+        [[nodiscard]] usize count(AddEdgeError e) const noexcept
+        {
+            switch (e)
+            {
+                case AddEdgeError::NodeFromMissing: return node_from_missing;
+                case AddEdgeError::NodeToMissing: return node_to_missing;
+                case AddEdgeError::EdgeExists: return edge_exists;
+                case AddEdgeError::SelfLoop: return self_loop;
+            }
+            return 0;
+        }
+
+        [[nodiscard]] usize rejected() const noexcept
+        {
+            return node_from_missing + node_to_missing + edge_exists + self_loop;
+        }
+
+        AddEdgesReport& operator+=(const AddEdgesReport& o) noexcept
+        {
+            added += o.added;
+            node_from_missing += o.node_from_missing;
+            node_to_missing += o.node_to_missing;
+            edge_exists += o.edge_exists;
+            self_loop += o.self_loop;
+            return *this;
+        }
+    };
+
+    using WeightedEdge = dsalgo::WeightedEdge;
+
+    // Bulk add_edge. Edges are bucketed by a hash of their source so every
+    // node lands in exactly one bucket; buckets are then sorted, deduplicated
+    // and merged into the neighbor lists in parallel, one linear merge per
+    // source instead of one sorted insert per edge.
+    [[nodiscard]]
+    AddEdgesReport add_edges(std::span<const std::pair<GraphIndex, GraphIndex>> edges)
+    {
+        return add_edges_impl(edges, [](const std::pair<GraphIndex, GraphIndex>& e) {
+            return WeightedEdge{e.first, e.second};
+        });
+    }
+
+    // As above; when an edge repeats within the batch the first weight wins,
+    // matching a sequence of add_edge calls (see EdgeWeight).
+    [[nodiscard]]
+    AddEdgesReport add_edges(std::span<const WeightedEdge> edges)
+    {
+        return add_edges_impl(edges, [](const WeightedEdge& e) { return e; });
+    }
+
+    enum class RemoveEdgeError
+    {
+        NodeFromMissing,
+        EdgeMissing,
+    };
+    [[nodiscard]]
+    std::expected<void, RemoveEdgeError>
+    remove_edge(GraphIndex idx0, GraphIndex idx1)
+    {
+        auto it = m_nodes.find(idx0);
+        if (it == m_nodes.end()) return std::unexpected(RemoveEdgeError::NodeFromMissing);
+        if (!it->second->remove_neighbor(idx1)) return std::unexpected(RemoveEdgeError::EdgeMissing);
+        return {};
+    }
+
+    struct RemoveEdgesReport
+    {
+        usize removed = 0;
+        usize node_from_missing = 0;
+        usize edge_missing = 0; // not present, or already removed earlier in the batch
+
+        [[nodiscard]] usize rejected() const noexcept { return node_from_missing + edge_missing; }
+
+        RemoveEdgesReport& operator+=(const RemoveEdgesReport& o) noexcept
+        {
+            removed += o.removed;
+            node_from_missing += o.node_from_missing;
+            edge_missing += o.edge_missing;
+            return *this;
+        }
+    };
+
+    // Bulk remove_edge, bucketed by source like add_edges so each touched
+    // neighbor list is compacted once.
+    [[nodiscard]]
+    RemoveEdgesReport remove_edges(std::span<const std::pair<GraphIndex, GraphIndex>> edges)
+    {
+        RemoveEdgesReport report;
+        if (edges.empty()) return report;
+
+        std::vector<WeightedEdge> bucketed;
+        const std::vector<usize> offsets = bucket_by_source(
+            edges, bucketed, [](const std::pair<GraphIndex, GraphIndex>& e) { return WeightedEdge{e.first, e.second}; },
+            [](const WeightedEdge&) { return true; });
+
+        std::vector<RemoveEdgesReport> partial(offsets.size() - 1);
+        default_thread_pool().run(partial.size(), [&](usize b, usize) {
+            const std::span<WeightedEdge> bucket{bucketed.data() + offsets[b], bucketed.data() + offsets[b + 1]};
+            std::ranges::sort(bucket, {}, [](const WeightedEdge& e) { return std::pair{e.from, e.to}; });
+            RemoveEdgesReport& r = partial[b];
+            std::vector<GraphIndex> targets;
+
+            for (usize i = 0; i < bucket.size();)
+            {
+                const GraphIndex from = bucket[i].from;
+                usize end = i;
+                while (end < bucket.size() && bucket[end].from == from) ++end;
+
+                auto it = m_nodes.find(from);
+                if (it == m_nodes.end())
+                {
+                    r.node_from_missing += end - i;
+                    i = end;
+                    continue;
+                }
+
+                targets.clear();
+                for (; i < end; ++i) targets.push_back(bucket[i].to);
+                const auto dups = std::ranges::unique(targets);
+                r.edge_missing += static_cast<usize>(dups.size());
+                targets.erase(dups.begin(), dups.end());
+
+                const usize removed = it->second->erase_neighbors_if(
+                    [&](GraphIndex nb) { return std::ranges::binary_search(targets, nb); });
+                r.removed += removed;
+                r.edge_missing += targets.size() - removed;
+            }
+        });
+
+        for (const RemoveEdgesReport& r : partial) report += r;
+        return report;
+    }
 
     enum class CreateNodeError
     {
@@ -146,16 +405,7 @@ public:
         {
             return std::unexpected(CreateNodeError::IndexExists);
         }
-
-        auto ptr = std::unique_ptr<GraphNode<T>>(new (std::nothrow) GraphNode<T>(value, idx));
-        if (!ptr)
-        {
-            return std::unexpected(CreateNodeError::CreationFailed);
-        }
-
-        GraphNode<T> *raw = ptr.get();
-        m_nodes.emplace(idx, std::move(ptr));
-        return raw;
+        return insert_node(std::move(value), idx);
     }
 
     [[nodiscard]]
@@ -167,9 +417,107 @@ public:
         {
             return std::unexpected(idx_or_err.error());
         }
-        return create_node(value, *idx_or_err);
+        return insert_node(std::move(value), *idx_or_err);
+    }
+
+    // Creates one node per value with consecutive fresh indices and returns
+    // them as the half-open range [first, last). If an allocation fails the
+    // nodes created so far are kept.
+    [[nodiscard]]
+    std::expected<std::pair<GraphIndex, GraphIndex>, CreateNodeError>
+    create_nodes(std::span<const T> values)
+    {
+        const auto first_or_err = next_index();
+        if (!first_or_err)
+        {
+            return std::unexpected(first_or_err.error());
+        }
+        const GraphIndex first = *first_or_err;
+        // `last` has to be representable as well.
+        if (values.size() > std::numeric_limits<GraphIndex>::max() - first)
+        {
+            return std::unexpected(CreateNodeError::IndexOverflowing);
+        }
+
+        m_nodes.reserve(m_nodes.size() + values.size());
+        GraphIndex idx = first;
+        for (const T& value : values)
+        {
+            // Every index at or above m_next_idx is unused, no lookup needed.
+            if (auto r = insert_node(value, idx); !r)
+            {
+                return std::unexpected(r.error());
+            }
+            ++idx;
+        }
+        return std::pair{first, static_cast<GraphIndex>(first + values.size())};
     }
 
+    enum class RemoveNodeError
+    {
+        NodeMissing,
+    };
+    // Removes the node and every edge pointing at it. Finding those edges
+    // takes a sweep over all nodes, so prefer remove_nodes for many at once.
+    // Removed indices are not handed out again by create_node(value).
+    [[nodiscard]]
+    std::expected<void, RemoveNodeError>
+    remove_node(GraphIndex idx)
+    {
+        if (remove_nodes(std::span{&idx, 1}) == 0) return std::unexpected(RemoveNodeError::NodeMissing);
+        return {};
+    }
+
+    // Removes every listed node that exists, plus their incoming edges, with
+    // one parallel sweep over the remaining nodes. Returns how many were removed.
+    usize remove_nodes(std::span<const GraphIndex> idxs)
+    {
+        std::vector<GraphIndex> gone;
+        for (GraphIndex idx : idxs)
+        {
+            if (m_nodes.erase(idx) != 0) gone.push_back(idx);
+        }
+        if (gone.empty()) return 0;
+        std::ranges::sort(gone);
+
+        std::vector<GraphNode<T>*> nodes;
+        nodes.reserve(m_nodes.size());
+        for (const auto& [_, node_ptr] : m_nodes) nodes.push_back(node_ptr.get());
+        parallel_for(0, nodes.size(), [&](usize i) {
+            (void)nodes[i]->erase_neighbors_if([&](GraphIndex nb) { return std::ranges::binary_search(gone, nb); });
+        }, 256);
+        return gone.size();
+    }
+
+    // Outcome of apply: the edge reports plus node counts.
+    struct BatchReport
+    {
+        usize nodes_added = 0;
+        usize nodes_rejected = 0; // create_node failed, usually IndexExists
+        usize nodes_removed = 0;
+        usize nodes_missing = 0;  // not present, or listed twice
+        RemoveEdgesReport removed_edges;
+        AddEdgesReport added_edges;
+    };
+
+    // Applies a GraphBatch in its documented order.
+    BatchReport apply(const GraphBatch<T>& batch)
+    {
+        BatchReport report;
+        report.removed_edges = remove_edges(batch.remove_edges);
+        report.nodes_removed = remove_nodes(batch.remove_nodes);
+        report.nodes_missing = batch.remove_nodes.size() - report.nodes_removed;
+        for (const auto& [idx, value] : batch.add_nodes)
+        {
+            if (create_node(value, idx)) ++report.nodes_added;
+            else ++report.nodes_rejected;
+        }
+        report.added_edges = add_edges(std::span<const WeightedEdge>{batch.add_edges});
+        return report;
+    }
+
+    void reserve(usize node_count) { m_nodes.reserve(node_count); }
+
     void print() const
     {
         std::println("Graph:");
@@ -206,29 +554,191 @@ public:
         return {};
     }
 
-private:
+    [[nodiscard]] usize node_count() const noexcept { return m_nodes.size(); }
+
+    enum class FreezeError
+    {
+        TooManyNodes,
+        DanglingEdge,
+    };
+    // Compacts the graph into a read-only CSR snapshot with dense 32-bit ids.
     [[nodiscard]]
-    std::expected<GraphIndex, CreateNodeError>
-    next_index() const
+    std::expected<CsrGraph<T>, FreezeError> freeze() const
+    {
+        std::vector<GraphIndex> ids;
+        ids.reserve(m_nodes.size());
+        for (const auto& [idx, _] : m_nodes) ids.push_back(idx);
+        return freeze_nodes(std::move(ids), [&](GraphIndex idx) -> const GraphNode<T>& { return *m_nodes.find(idx)->second; });
+    }
+
+    // freeze() over any node store: `ids` lists every node once and
+    // node_at(idx) returns its node, a GraphNode or anything else with
+    // value() and for_each_run(). Shared with GraphSnapshot.
+    template <typename NodeAt>
+    [[nodiscard]]
+    static std::expected<CsrGraph<T>, FreezeError> freeze_nodes(std::vector<GraphIndex> ids, NodeAt node_at)
     {
-        if (m_nodes.empty())
+        if (ids.size() >= invalid_vertex)
         {
-            return GraphIndex{0};
+            return std::unexpected(FreezeError::TooManyNodes);
         }
 
-        GraphIndex max_idx = 0;
-        for (const auto &[idx, _] : m_nodes)
+        std::ranges::sort(ids);
+        const StaticSearchTree<GraphIndex> to_dense{ids};
+
+        std::vector<T> values;
+        values.reserve(ids.size());
+        CsrAdjacency adj;
+        adj.offsets.reserve(ids.size() + 1);
+
+        for (GraphIndex idx : ids)
         {
-            max_idx = std::max(max_idx, idx);
+            const auto& node = node_at(idx);
+            values.push_back(node.value());
+            bool dangling = false;
+            node.for_each_run([&](std::span<const GraphIndex> targets, std::span<const EdgeWeight> weights) {
+                adj.weights.insert(adj.weights.end(), weights.begin(), weights.end());
+                for (GraphIndex nb : targets)
+                {
+                    // GraphNode::add_neighbor does not check that the target exists.
+                    const usize dense = to_dense.find(nb);
+                    dangling = dangling || dense == StaticSearchTree<GraphIndex>::npos;
+                    adj.edges.push_back(static_cast<VertexId>(dense));
+                }
+            });
+            if (dangling)
+            {
+                return std::unexpected(FreezeError::DanglingEdge);
+            }
+            adj.offsets.push_back(adj.edges.size());
         }
 
-        if (max_idx == std::numeric_limits<GraphIndex>::max())
+        return CsrGraph<T>{std::move(ids), std::move(values), std::move(adj)};
+    }
+
+private:
+    // Scatters the edges that pass `keep` into `out`, grouped into buckets by
+    // a hash of their source so every node lands in exactly one bucket.
+    // Returns the bucket offsets into `out`.
+    template <typename Edge, typename ToWeighted, typename Keep>
+    static std::vector<usize> bucket_by_source(std::span<const Edge> edges, std::vector<WeightedEdge>& out,
+                                               ToWeighted to_weighted, Keep keep)
+    {
+        const usize bucket_count = std::min(edges.size(), 8 * default_thread_pool().thread_count());
+        const auto bucket_of = [bucket_count](GraphIndex from) {
+            return static_cast<usize>(hash_int(from) % bucket_count);
+        };
+
+        std::vector<usize> offsets(bucket_count + 1, 0);
+        for (const Edge& edge : edges)
         {
-            return std::unexpected(CreateNodeError::IndexOverflowing);
+            const WeightedEdge e = to_weighted(edge);
+            if (keep(e)) ++offsets[bucket_of(e.from) + 1];
+        }
+        for (usize b = 0; b < bucket_count; ++b) offsets[b + 1] += offsets[b];
+
+        out.resize(offsets.back());
+        std::vector<usize> cursor(offsets.begin(), offsets.end() - 1);
+        for (const Edge& edge : edges)
+        {
+            const WeightedEdge e = to_weighted(edge);
+            if (keep(e)) out[cursor[bucket_of(e.from)]++] = e;
+        }
+        return offsets;
+    }
+
+    template <typename Edge, typename ToWeighted>
+    [[nodiscard]]
+    AddEdgesReport add_edges_impl(std::span<const Edge> edges, ToWeighted to_weighted)
+    {
+        AddEdgesReport report;
+        if (edges.empty()) return report;
+
+        std::vector<WeightedEdge> bucketed;
+        const std::vector<usize> offsets = bucket_by_source(
+            edges, bucketed, to_weighted, [](const WeightedEdge& e) { return e.from != e.to; });
+        report.self_loop = edges.size() - bucketed.size();
+
+        // Buckets only touch their own sources' neighbor lists; m_nodes is read-only here.
+        std::vector<AddEdgesReport> partial(offsets.size() - 1);
+        default_thread_pool().run(partial.size(), [&](usize b, usize) {
+            const std::span<WeightedEdge> bucket{bucketed.data() + offsets[b], bucketed.data() + offsets[b + 1]};
+            // Stable, so the first of several repeats keeps its weight.
+            std::ranges::stable_sort(bucket, {}, [](const WeightedEdge& e) { return std::pair{e.from, e.to}; });
+            AddEdgesReport& r = partial[b];
+            std::vector<GraphIndex> targets;
+            std::vector<EdgeWeight> weights;
+
+            for (usize i = 0; i < bucket.size();)
+            {
+                const GraphIndex from = bucket[i].from;
+                usize end = i;
+                while (end < bucket.size() && bucket[end].from == from) ++end;
+
+                auto it = m_nodes.find(from);
+                if (it == m_nodes.end())
+                {
+                    r.node_from_missing += end - i;
+                    i = end;
+                    continue;
+                }
+
+                targets.clear();
+                weights.clear();
+                for (; i < end; ++i)
+                {
+                    const GraphIndex to = bucket[i].to;
+                    if (!targets.empty() && targets.back() == to) ++r.edge_exists;
+                    else if (!m_nodes.contains(to)) ++r.node_to_missing;
+                    else
+                    {
+                        targets.push_back(to);
+                        weights.push_back(bucket[i].weight);
+                    }
+                }
+                const usize existing = it->second->merge_neighbors(targets, weights);
+                r.edge_exists += existing;
+                r.added += targets.size() - existing;
+            }
+        });
+
+        for (const AddEdgesReport& r : partial) report += r;
+        return report;
+    }
+
+    [[nodiscard]]
+    std::expected<GraphNode<T> *, CreateNodeError>
+    insert_node(T value, GraphIndex idx)
+    {
+        auto ptr = std::unique_ptr<GraphNode<T>>(new (std::nothrow) GraphNode<T>(std::move(value), idx));
+        if (!ptr)
+        {
+            return std::unexpected(CreateNodeError::CreationFailed);
         }
 
-        return static_cast<GraphIndex>(max_idx + 1);
+        GraphNode<T> *raw = ptr.get();
+        m_nodes.emplace(idx, std::move(ptr));
+
+        if (idx == std::numeric_limits<GraphIndex>::max()) m_index_exhausted = true;
+        else m_next_idx = std::max(m_next_idx, static_cast<GraphIndex>(idx + 1));
+        return raw;
+    }
+
+    // One past the largest index ever handed out, tracked on insertion so
+    // auto-indexing stays O(1).
+    [[nodiscard]]
+    std::expected<GraphIndex, CreateNodeError>
+    next_index() const
+    {
+        if (m_index_exhausted)
+        {
+            return std::unexpected(CreateNodeError::IndexOverflowing);
+        }
+        return m_next_idx;
     }
+
+    GraphIndex m_next_idx = 0;
+    bool m_index_exhausted = false;
     std::unordered_map<GraphIndex, std::unique_ptr<GraphNode<T>>> m_nodes;
 };
 } // namespace dsalgo
\ No newline at end of file
@@ -0,0 +1,547 @@
+// dsalgo/src/graph_io.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+#include "static_search_tree.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+enum class GraphIoError
+{
+    OpenFailed,
+    MapFailed,
+    WriteFailed,
+    ParseError,        // malformed line in an edge list
+    BadHeader,         // missing or unsupported Matrix Market banner / size line
+    VertexOutOfRange,  // Matrix Market entry outside the declared dimensions
+    TooManyVertices,
+    BadMagic,          // not a binary CSR file, or a different version
+    Truncated,         // binary CSR file shorter than its header claims
+};
+
+// Read-only private mapping of a whole file. Empty files map to an empty span.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+    {
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+    ~MappedFile() { unmap(); }
+
+    [[nodiscard]] static std::expected<MappedFile, GraphIoError> open(const char* path)
+    {
+        const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return std::unexpected(GraphIoError::OpenFailed);
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            return std::unexpected(GraphIoError::OpenFailed);
+        }
+
+        MappedFile f;
+        f.m_size = static_cast<usize>(st.st_size);
+        if (f.m_size != 0)
+        {
+            void* p = ::mmap(nullptr, f.m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED)
+            {
+                ::close(fd);
+                return std::unexpected(GraphIoError::MapFailed);
+            }
+            ::madvise(p, f.m_size, MADV_SEQUENTIAL);
+            f.m_data = static_cast<const char*>(p);
+        }
+        ::close(fd); // the mapping keeps the file alive
+        return f;
+    }
+
+    [[nodiscard]] std::string_view text() const noexcept { return {m_data, m_size}; }
+    [[nodiscard]] const char* data() const noexcept { return m_data; }
+    [[nodiscard]] usize size() const noexcept { return m_size; }
+
+private:
+    void unmap() noexcept
+    {
+        if (m_data) ::munmap(const_cast<char*>(m_data), m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    const char* m_data = nullptr;
+    usize m_size = 0;
+};
+
+namespace detail
+{
+struct ParsedArc
+{
+    u64 from;
+    u64 to;
+    EdgeWeight weight;
+};
+
+inline const char* skip_blanks(const char* p, const char* end) noexcept
+{
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    return p;
+}
+
+inline const char* next_line(const char* p, const char* end) noexcept
+{
+    const void* nl = std::memchr(p, '\n', static_cast<usize>(end - p));
+    return nl ? static_cast<const char*>(nl) + 1 : end;
+}
+
+// Parses "from to [weight]" lines, skipping blank lines and lines starting
+// with one of `comment`. Returns false on the first malformed line.
+inline bool parse_arcs(const char* p, const char* end, std::string_view comment, bool allow_weight,
+                       std::vector<ParsedArc>& out)
+{
+    while (p != end)
+    {
+        p = skip_blanks(p, end);
+        if (p == end) break;
+        if (*p == '\n' || comment.find(*p) != std::string_view::npos)
+        {
+            p = next_line(p, end);
+            continue;
+        }
+
+        ParsedArc arc{0, 0, default_edge_weight};
+        auto r = std::from_chars(p, end, arc.from);
+        if (r.ec != std::errc{}) return false;
+        p = skip_blanks(r.ptr, end);
+        r = std::from_chars(p, end, arc.to);
+        if (r.ec != std::errc{}) return false;
+        p = skip_blanks(r.ptr, end);
+
+        if (p != end && *p != '\n')
+        {
+            if (!allow_weight) return false;
+            r = std::from_chars(p, end, arc.weight);
+            if (r.ec != std::errc{}) return false;
+            p = skip_blanks(r.ptr, end);
+            if (p != end && *p != '\n') return false;
+        }
+        out.push_back(arc);
+        p = next_line(p, end);
+    }
+    return true;
+}
+
+// Splits [begin, end) at line boundaries into roughly equal chunks and
+// parses them on the default thread pool.
+inline std::expected<std::vector<ParsedArc>, GraphIoError>
+parse_arcs_parallel(const char* begin, const char* end, std::string_view comment, bool allow_weight)
+{
+    const auto size = static_cast<usize>(end - begin);
+    const usize chunks = std::clamp<usize>(size / (1 << 20), 1, 4 * default_thread_pool().thread_count());
+
+    std::vector<const char*> cuts(chunks + 1, end);
+    cuts[0] = begin;
+    for (usize c = 1; c < chunks; ++c)
+    {
+        const char* nominal = std::max(cuts[c - 1], begin + size * c / chunks);
+        cuts[c] = nominal == begin ? begin : next_line(nominal - 1, end);
+    }
+
+    std::vector<std::vector<ParsedArc>> parts(chunks);
+    std::atomic<bool> ok{true};
+    default_thread_pool().run(chunks, [&](usize c, usize) {
+        if (!parse_arcs(cuts[c], cuts[c + 1], comment, allow_weight, parts[c])) ok.store(false);
+    });
+    if (!ok.load()) return std::unexpected(GraphIoError::ParseError);
+
+    usize total = 0;
+    for (const auto& part : parts) total += part.size();
+    std::vector<ParsedArc> arcs(total);
+    std::vector<usize> at(chunks + 1, 0);
+    for (usize c = 0; c < chunks; ++c) at[c + 1] = at[c] + parts[c].size();
+    default_thread_pool().run(chunks, [&](usize c, usize) {
+        std::ranges::copy(parts[c], arcs.begin() + static_cast<isize>(at[c]));
+    });
+    return arcs;
+}
+
+// Arcs over dense endpoints -> CSR with sorted, duplicate-free rows and no
+// self-loops, matching the invariants Graph keeps. Repeated arcs follow the
+// policy at EdgeWeight (csr_graph.hpp): the first in input order wins.
+inline CsrAdjacency build_adjacency(usize n, std::span<const VertexId> from, std::span<const VertexId> to,
+                                    std::span<const EdgeWeight> weights)
+{
+    const usize m = from.size();
+    const bool weighted = !weights.empty();
+
+    std::vector<u64> degree(n + 1, 0);
+    parallel_for(0, m, [&](usize e) {
+        if (from[e] != to[e]) std::atomic_ref<u64>{degree[from[e] + 1]}.fetch_add(1, std::memory_order_relaxed);
+    });
+    for (usize v = 0; v < n; ++v) degree[v + 1] += degree[v];
+
+    std::vector<u64> cursor(degree.begin(), degree.end() - 1);
+    std::vector<VertexId> edges(degree.back());
+    // Input position of each slot's arc, so the first of several repeats
+    // can be told apart after the unordered scatter.
+    std::vector<u64> arc(weighted ? degree.back() : 0);
+    parallel_for(0, m, [&](usize e) {
+        if (from[e] == to[e]) return;
+        const u64 slot = std::atomic_ref<u64>{cursor[from[e]]}.fetch_add(1, std::memory_order_relaxed);
+        edges[slot] = to[e];
+        if (weighted) arc[slot] = e;
+    });
+
+    // Sort and deduplicate every row in place, then compact.
+    std::vector<u64> kept(n + 1, 0);
+    parallel_for_range(0, n, 256, [&](usize lo, usize hi, usize) {
+        std::vector<std::pair<VertexId, u64>> scratch;
+        for (usize v = lo; v < hi; ++v)
+        {
+            const auto b = static_cast<isize>(degree[v]);
+            const auto e = static_cast<isize>(degree[v + 1]);
+            if (!weighted)
+            {
+                std::sort(edges.begin() + b, edges.begin() + e);
+                kept[v + 1] = static_cast<u64>(std::unique(edges.begin() + b, edges.begin() + e) - (edges.begin() + b));
+                continue;
+            }
+            scratch.clear();
+            for (isize i = b; i < e; ++i) scratch.emplace_back(edges[static_cast<usize>(i)], arc[static_cast<usize>(i)]);
+            std::ranges::sort(scratch);
+            u64 k = 0;
+            for (usize i = 0; i < scratch.size(); ++i)
+            {
+                if (i > 0 && scratch[i].first == scratch[i - 1].first) continue;
+                std::tie(edges[degree[v] + k], arc[degree[v] + k]) = scratch[i];
+                ++k;
+            }
+            kept[v + 1] = k;
+        }
+    });
+    for (usize v = 0; v < n; ++v) kept[v + 1] += kept[v];
+
+    CsrAdjacency adj;
+    adj.offsets = kept;
+    adj.edges.resize(kept.back());
+    if (weighted) adj.weights.resize(kept.back());
+    parallel_for(0, n, [&](usize v) {
+        const u64 len = kept[v + 1] - kept[v];
+        std::copy_n(edges.begin() + static_cast<isize>(degree[v]), len, adj.edges.begin() + static_cast<isize>(kept[v]));
+        for (u64 j = 0; weighted && j < len; ++j) adj.weights[kept[v] + j] = weights[arc[degree[v] + j]];
+    }, 256);
+    return adj;
+}
+} // namespace detail
+
+// SNAP-style edge list: one "from to" or "from to weight" per line, '#'
+// comments, arbitrary 64-bit ids. Ids become the external ids of the result
+// (dense ids follow their order). A third column becomes the edge weight;
+// if every weight is 1 the result is unweighted. Self-loops are dropped and
+// of repeated edges the first one is kept.
+template <typename T = std::monostate>
+[[nodiscard]] std::expected<CsrGraph<T>, GraphIoError> parse_edge_list(std::string_view text)
+{
+    auto arcs = detail::parse_arcs_parallel(text.data(), text.data() + text.size(), "#%", true);
+    if (!arcs) return std::unexpected(arcs.error());
+    const usize m = arcs->size();
+
+    std::vector<GraphIndex> ids(2 * m);
+    parallel_for(0, m, [&](usize e) {
+        ids[2 * e] = (*arcs)[e].from;
+        ids[2 * e + 1] = (*arcs)[e].to;
+    });
+    parallel_sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    if (ids.size() >= invalid_vertex) return std::unexpected(GraphIoError::TooManyVertices);
+
+    std::vector<VertexId> from(m);
+    std::vector<VertexId> to(m);
+    std::vector<EdgeWeight> weights(m);
+    const std::span<const GraphIndex> sorted{ids};
+    std::atomic<bool> weighted{false};
+    parallel_for(0, m, [&](usize e) {
+        const detail::ParsedArc& a = (*arcs)[e];
+        from[e] = static_cast<VertexId>(branchless_lower_bound(sorted, a.from) - sorted.data());
+        to[e] = static_cast<VertexId>(branchless_lower_bound(sorted, a.to) - sorted.data());
+        weights[e] = a.weight;
+        if (a.weight != default_edge_weight) weighted.store(true, std::memory_order_relaxed);
+    });
+    if (!weighted.load()) weights.clear();
+
+    CsrAdjacency adj = detail::build_adjacency(ids.size(), from, to, weights);
+    std::vector<T> values(ids.size());
+    return CsrGraph<T>{std::move(ids), std::move(values), std::move(adj)};
+}
+
+// Matrix Market coordinate file. Row and column indices (1-based) are the
+// external ids 1 .. max(rows, cols); "pattern" files are unweighted,
+// "integer" values become edge weights, "symmetric" adds both directions.
+// Real and complex matrices are rejected with BadHeader.
+template <typename T = std::monostate>
+[[nodiscard]] std::expected<CsrGraph<T>, GraphIoError> parse_matrix_market(std::string_view text)
+{
+    const char* p = text.data();
+    const char* const end = p + text.size();
+
+    const char* eol = detail::next_line(p, end);
+    const std::string_view banner{p, static_cast<usize>(eol - p)};
+    if (!banner.starts_with("%%MatrixMarket matrix coordinate")) return std::unexpected(GraphIoError::BadHeader);
+    const bool pattern = banner.find("pattern") != std::string_view::npos;
+    const bool integer = banner.find("integer") != std::string_view::npos;
+    const bool symmetric = banner.find("symmetric") != std::string_view::npos;
+    if (!pattern && !integer) return std::unexpected(GraphIoError::BadHeader);
+
+    p = eol;
+    while (p != end && *p == '%') p = detail::next_line(p, end);
+
+    u64 dims[3] = {};
+    for (u64& d : dims)
+    {
+        p = detail::skip_blanks(p, end);
+        const auto r = std::from_chars(p, end, d);
+        if (r.ec != std::errc{}) return std::unexpected(GraphIoError::BadHeader);
+        p = r.ptr;
+    }
+    p = detail::next_line(p, end);
+    const u64 n = std::max(dims[0], dims[1]);
+    if (n >= invalid_vertex) return std::unexpected(GraphIoError::TooManyVertices);
+
+    auto arcs = detail::parse_arcs_parallel(p, end, "%", integer);
+    if (!arcs) return std::unexpected(arcs.error());
+    if (arcs->size() != dims[2]) return std::unexpected(GraphIoError::ParseError);
+
+    const usize m = arcs->size();
+    const usize copies = symmetric ? 2 : 1;
+    std::vector<VertexId> from(copies * m);
+    std::vector<VertexId> to(copies * m);
+    std::vector<EdgeWeight> weights(integer ? copies * m : 0);
+    std::atomic<bool> in_range{true};
+    parallel_for(0, m, [&](usize e) {
+        const detail::ParsedArc& a = (*arcs)[e];
+        if (a.from == 0 || a.to == 0 || a.from > dims[0] || a.to > dims[1])
+        {
+            in_range.store(false, std::memory_order_relaxed);
+            return;
+        }
+        from[e] = static_cast<VertexId>(a.from - 1);
+        to[e] = static_cast<VertexId>(a.to - 1);
+        if (integer) weights[e] = a.weight;
+        if (symmetric)
+        {
+            from[m + e] = to[e];
+            to[m + e] = from[e];
+            if (integer) weights[m + e] = a.weight;
+        }
+    });
+    if (!in_range.load()) return std::unexpected(GraphIoError::VertexOutOfRange);
+
+    std::vector<GraphIndex> ids(n);
+    for (u64 i = 0; i < n; ++i) ids[i] = i + 1;
+    CsrAdjacency adj = detail::build_adjacency(n, from, to, weights);
+    std::vector<T> values(n);
+    return CsrGraph<T>{std::move(ids), std::move(values), std::move(adj)};
+}
+
+template <typename T = std::monostate>
+[[nodiscard]] std::expected<CsrGraph<T>, GraphIoError> load_edge_list(const char* path)
+{
+    auto file = MappedFile::open(path);
+    if (!file) return std::unexpected(file.error());
+    return parse_edge_list<T>(file->text());
+}
+
+template <typename T = std::monostate>
+[[nodiscard]] std::expected<CsrGraph<T>, GraphIoError> load_matrix_market(const char* path)
+{
+    auto file = MappedFile::open(path);
+    if (!file) return std::unexpected(file.error());
+    return parse_matrix_market<T>(file->text());
+}
+
+// Binary CSR layout, native byte order, every section naturally aligned:
+//   header | ids: u64[n] | offsets: u64[n + 1] | by_id: u32[n] | edges: u32[m] | weights: u32[m] (if weighted)
+// by_id lists dense ids in increasing external-id order, so lookups by id
+// are a binary search over the mapping. Vertex values are not stored.
+struct CsrFileHeader
+{
+    static constexpr std::array<char, 8> expected_magic{'D', 'S', 'A', 'C', 'S', 'R', '0', '1'};
+    static constexpr u64 weighted_flag = 1;
+
+    std::array<char, 8> magic = expected_magic;
+    u64 vertex_count = 0;
+    u64 edge_count = 0;
+    u64 flags = 0;
+};
+
+template <typename T>
+[[nodiscard]] std::expected<void, GraphIoError> write_csr(const char* path, const CsrGraph<T>& g)
+{
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) return std::unexpected(GraphIoError::OpenFailed);
+
+    const CsrAdjacency& adj = g.adjacency();
+    CsrFileHeader header;
+    header.vertex_count = g.vertex_count();
+    header.edge_count = g.edge_count();
+    header.flags = adj.weighted() ? CsrFileHeader::weighted_flag : 0;
+
+    std::vector<VertexId> by_id(g.vertex_count());
+    for (usize v = 0; v < by_id.size(); ++v) by_id[v] = static_cast<VertexId>(v);
+    std::ranges::sort(by_id, {}, [&](VertexId v) { return g.external_id(v); });
+
+    const auto put = [f]<typename U>(std::span<const U> xs) {
+        return xs.empty() || std::fwrite(xs.data(), sizeof(U), xs.size(), f) == xs.size();
+    };
+    bool ok = std::fwrite(&header, sizeof header, 1, f) == 1;
+    ok = ok && put(g.external_ids());
+    ok = ok && put(std::span<const u64>{adj.offsets});
+    ok = ok && put(std::span<const VertexId>{by_id});
+    ok = ok && put(std::span<const VertexId>{adj.edges});
+    ok = ok && put(std::span<const EdgeWeight>{adj.weights});
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) return std::unexpected(GraphIoError::WriteFailed);
+    return {};
+}
+
+// A binary CSR file mapped into memory and queried in place. open() checks
+// the header and section sizes in O(1); neighbour ids are trusted, run
+// validate() once on files from elsewhere.
+class MappedCsr
+{
+public:
+    [[nodiscard]] static std::expected<MappedCsr, GraphIoError> open(const char* path)
+    {
+        auto file = MappedFile::open(path);
+        if (!file) return std::unexpected(file.error());
+
+        MappedCsr g;
+        g.m_file = std::move(*file);
+        const char* base = g.m_file.data();
+        const usize size = g.m_file.size();
+        if (size < sizeof(CsrFileHeader)) return std::unexpected(GraphIoError::Truncated);
+
+        CsrFileHeader header;
+        std::memcpy(&header, base, sizeof header);
+        if (header.magic != CsrFileHeader::expected_magic) return std::unexpected(GraphIoError::BadMagic);
+
+        const u64 n = header.vertex_count;
+        const u64 m = header.edge_count;
+        const bool weighted = header.flags & CsrFileHeader::weighted_flag;
+        if (n >= invalid_vertex || m > size) return std::unexpected(GraphIoError::Truncated);
+        const u64 needed = sizeof header + 8 * n + 8 * (n + 1) + 4 * n + 4 * m * (weighted ? 2 : 1);
+        if (size < needed) return std::unexpected(GraphIoError::Truncated);
+
+        usize at = sizeof header;
+        const auto take = [&]<typename U>(std::span<const U>& out, u64 count) {
+            out = {static_cast<const U*>(static_cast<const void*>(base + at)), static_cast<usize>(count)};
+            at += static_cast<usize>(count) * sizeof(U);
+        };
+        take(g.m_ids, n);
+        take(g.m_offsets, n + 1);
+        take(g.m_by_id, n);
+        take(g.m_edges, m);
+        if (weighted) take(g.m_weights, m);
+
+        if (g.m_offsets.front() != 0 || g.m_offsets.back() != m) return std::unexpected(GraphIoError::Truncated);
+        return g;
+    }
+
+    [[nodiscard]] usize vertex_count() const noexcept { return m_ids.size(); }
+    [[nodiscard]] usize edge_count() const noexcept { return m_edges.size(); }
+    [[nodiscard]] bool weighted() const noexcept { return !m_weights.empty(); }
+
+    [[nodiscard]] std::span<const VertexId> neighbors(VertexId v) const noexcept
+    {
+        return m_edges.subspan(m_offsets[v], m_offsets[v + 1] - m_offsets[v]);
+    }
+
+    [[nodiscard]] std::span<const EdgeWeight> edge_weights(VertexId v) const noexcept
+    {
+        if (!weighted()) return {};
+        return m_weights.subspan(m_offsets[v], m_offsets[v + 1] - m_offsets[v]);
+    }
+
+    [[nodiscard]] usize degree(VertexId v) const noexcept { return static_cast<usize>(m_offsets[v + 1] - m_offsets[v]); }
+    [[nodiscard]] GraphIndex external_id(VertexId v) const noexcept { return m_ids[v]; }
+
+    [[nodiscard]] std::optional<VertexId> dense_id(GraphIndex idx) const noexcept
+    {
+        const auto it = std::ranges::lower_bound(m_by_id, idx, {}, [this](VertexId v) { return m_ids[v]; });
+        if (it == m_by_id.end() || m_ids[*it] != idx) return std::nullopt;
+        return *it;
+    }
+
+    // Full O(n + m) check of offsets, neighbour ids and the id index.
+    [[nodiscard]] bool validate() const noexcept
+    {
+        const usize n = vertex_count();
+        for (usize v = 0; v < n; ++v)
+        {
+            if (m_offsets[v] > m_offsets[v + 1] || m_by_id[v] >= n) return false;
+            if (v > 0 && m_ids[m_by_id[v - 1]] >= m_ids[m_by_id[v]]) return false;
+        }
+        return std::ranges::all_of(m_edges, [n](VertexId u) { return u < n; });
+    }
+
+    // Copies into an owning snapshot, with value-initialised vertex values.
+    template <typename T = std::monostate>
+    [[nodiscard]] CsrGraph<T> to_csr_graph() const
+    {
+        CsrAdjacency adj;
+        adj.offsets.assign(m_offsets.begin(), m_offsets.end());
+        adj.edges.assign(m_edges.begin(), m_edges.end());
+        adj.weights.assign(m_weights.begin(), m_weights.end());
+        return CsrGraph<T>::relabeled({m_ids.begin(), m_ids.end()}, std::vector<T>(vertex_count()), std::move(adj));
+    }
+
+private:
+    MappedFile m_file;
+    std::span<const GraphIndex> m_ids;
+    std::span<const u64> m_offsets;
+    std::span<const VertexId> m_by_id;
+    std::span<const VertexId> m_edges;
+    std::span<const EdgeWeight> m_weights;
+};
+} // namespace dsalgo
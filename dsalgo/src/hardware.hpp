@@ -0,0 +1,24 @@
+// dsalgo/src/hardware.hpp
+#pragma once
+
+#include "types.hpp"
+
+namespace dsalgo
+{
+// Machine profile used to size cache-conscious layouts. The cache sizes
+// follow experiments/cache_access_speed.csv: pointer-chase latency stays flat
+// up to 128 KiB and jumps at ~160 KiB (L1d), stays at ~7-8 ns up to 9 MiB,
+// starts rising at 10 MiB and jumps past 11 MiB (L2) straight to DRAM
+// latency, so there is no L3 to speak of (l3_bytes = 0 means absent).
+// l2_bytes is the last size before the cliff, since blocking (GEMM's mc/nc)
+// has to stay below it. Re-run that experiment on new hardware and update
+// these instead of hard-coding sizes at the use site.
+//
+// The line and page sizes are not measured by that experiment: 64 B lines
+// and 16 KiB pages (Apple Silicon; 4 KiB on most x86 boxes) are assumed.
+inline constexpr usize cache_line_bytes = 64;
+inline constexpr usize l1d_bytes = 128 * 1024;
+inline constexpr usize l2_bytes = 10 * 1024 * 1024;
+inline constexpr usize l3_bytes = 0;
+inline constexpr usize page_bytes = 16 * 1024;
+} // namespace dsalgo
@@ -0,0 +1,184 @@
+// dsalgo/src/incremental_dag.hpp
+#pragma once
+
+#include <algorithm>
+#include <expected>
+#include <span>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// A DAG that keeps a topological order up to date while edges are added,
+// rejecting any edge that would close a cycle (Pearce & Kelly, "A dynamic
+// topological sort algorithm for directed acyclic graphs"). An edge that
+// already agrees with the order costs one comparison. Otherwise only the
+// vertices positioned between its endpoints are searched, and only the ones
+// reached get new positions, instead of re-sorting the whole graph.
+class IncrementalDag
+{
+public:
+    IncrementalDag() = default;
+    explicit IncrementalDag(usize vertex_count)
+    {
+        for (usize i = 0; i < vertex_count; ++i) (void)add_vertex();
+    }
+
+    // New vertices go to the end of the order.
+    VertexId add_vertex()
+    {
+        const auto v = static_cast<VertexId>(m_order.size());
+        m_succ.emplace_back();
+        m_pred.emplace_back();
+        m_pos.push_back(v);
+        m_order.push_back(v);
+        m_mark.push_back(0);
+        return v;
+    }
+
+    [[nodiscard]] usize vertex_count() const noexcept { return m_order.size(); }
+    [[nodiscard]] usize edge_count() const noexcept { return m_edge_count; }
+
+    [[nodiscard]] std::span<const VertexId> successors(VertexId v) const noexcept { return m_succ[v]; }
+    [[nodiscard]] std::span<const VertexId> predecessors(VertexId v) const noexcept { return m_pred[v]; }
+
+    // Every edge u -> v has position(u) < position(v).
+    [[nodiscard]] VertexId position(VertexId v) const noexcept { return m_pos[v]; }
+    [[nodiscard]] std::span<const VertexId> order() const noexcept { return m_order; }
+
+    [[nodiscard]] bool contains_edge(VertexId from, VertexId to) const noexcept
+    {
+        return from < vertex_count() && std::ranges::binary_search(m_succ[from], to);
+    }
+
+    enum class AddEdgeError
+    {
+        VertexMissing,
+        SelfLoop,
+        EdgeExists,
+        CreatesCycle,
+    };
+    // On CreatesCycle the graph and the order are left untouched.
+    [[nodiscard]]
+    std::expected<void, AddEdgeError> add_edge(VertexId from, VertexId to)
+    {
+        if (from >= vertex_count() || to >= vertex_count()) return std::unexpected(AddEdgeError::VertexMissing);
+        if (from == to) return std::unexpected(AddEdgeError::SelfLoop);
+        if (contains_edge(from, to)) return std::unexpected(AddEdgeError::EdgeExists);
+        if (m_pos[to] < m_pos[from] && !reorder(from, to)) return std::unexpected(AddEdgeError::CreatesCycle);
+
+        m_succ[from].insert(std::ranges::lower_bound(m_succ[from], to), to);
+        m_pred[to].insert(std::ranges::lower_bound(m_pred[to], from), from);
+        ++m_edge_count;
+        return {};
+    }
+
+    // Removing an edge never invalidates the order, so nothing moves.
+    bool remove_edge(VertexId from, VertexId to)
+    {
+        if (!contains_edge(from, to)) return false;
+        m_succ[from].erase(std::ranges::lower_bound(m_succ[from], to));
+        m_pred[to].erase(std::ranges::lower_bound(m_pred[to], from));
+        --m_edge_count;
+        return true;
+    }
+
+    // Compact copy of the current graph, e.g. for topological_sort levels.
+    [[nodiscard]] CsrAdjacency to_csr() const
+    {
+        CsrAdjacency adj;
+        adj.offsets.reserve(vertex_count() + 1);
+        adj.edges.reserve(m_edge_count);
+        for (const auto& succ : m_succ)
+        {
+            adj.edges.insert(adj.edges.end(), succ.begin(), succ.end());
+            adj.offsets.push_back(adj.edges.size());
+        }
+        return adj;
+    }
+
+private:
+    // Makes room for from -> to when `to` currently sits before `from`.
+    // Forward search from `to` and backward search from `from`, both limited
+    // to positions in [pos(to), pos(from)]; reaching `from` going forward
+    // means a cycle. Otherwise the backward set is moved ahead of the forward
+    // set, reusing exactly the positions the two sets occupied.
+    bool reorder(VertexId from, VertexId to)
+    {
+        const VertexId lo = m_pos[to];
+        const VertexId hi = m_pos[from];
+
+        m_forward.clear();
+        if (!search(to, hi, true, m_forward)) return false;
+        m_backward.clear();
+        (void)search(from, lo, false, m_backward);
+
+        const auto by_pos = [&](VertexId v) { return m_pos[v]; };
+        std::ranges::sort(m_backward, {}, by_pos);
+        std::ranges::sort(m_forward, {}, by_pos);
+
+        m_slots.clear();
+        for (VertexId v : m_backward) m_slots.push_back(m_pos[v]);
+        for (VertexId v : m_forward) m_slots.push_back(m_pos[v]);
+        std::ranges::sort(m_slots);
+
+        usize i = 0;
+        for (const auto* set : {&m_backward, &m_forward})
+        {
+            for (VertexId v : *set)
+            {
+                m_pos[v] = m_slots[i++];
+                m_order[m_pos[v]] = v;
+            }
+        }
+        return true;
+    }
+
+    // Iterative DFS from `start` along successors (forward) or predecessors,
+    // staying within `bound` (pos <= bound forward, pos >= bound backward).
+    // A forward search returns false as soon as it reaches the vertex at
+    // position `bound`, which is the new edge's source.
+    bool search(VertexId start, VertexId bound, bool forward, std::vector<VertexId>& visited)
+    {
+        if (++m_epoch == 0)
+        {
+            std::ranges::fill(m_mark, 0);
+            m_epoch = 1;
+        }
+        m_stack.assign(1, start);
+        m_mark[start] = m_epoch;
+        while (!m_stack.empty())
+        {
+            const VertexId u = m_stack.back();
+            m_stack.pop_back();
+            visited.push_back(u);
+            for (VertexId w : forward ? m_succ[u] : m_pred[u])
+            {
+                if (forward && m_pos[w] == bound) return false;
+                const bool inside = forward ? m_pos[w] < bound : m_pos[w] > bound;
+                if (!inside || m_mark[w] == m_epoch) continue;
+                m_mark[w] = m_epoch;
+                m_stack.push_back(w);
+            }
+        }
+        return true;
+    }
+
+    std::vector<std::vector<VertexId>> m_succ;
+    std::vector<std::vector<VertexId>> m_pred;
+    std::vector<VertexId> m_pos;   // vertex -> position in m_order
+    std::vector<VertexId> m_order; // position -> vertex
+    usize m_edge_count = 0;
+
+    // Search scratch, kept to avoid reallocating per edge. m_mark[v] ==
+    // m_epoch means v was visited by the current search.
+    std::vector<u32> m_mark;
+    u32 m_epoch = 0;
+    std::vector<VertexId> m_stack;
+    std::vector<VertexId> m_forward;
+    std::vector<VertexId> m_backward;
+    std::vector<VertexId> m_slots;
+};
+} // namespace dsalgo
@@ -0,0 +1,86 @@
+// dsalgo/src/kcore.hpp
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+struct CoreDecomposition
+{
+    // core[v] = largest k such that v belongs to the k-core (the maximal
+    // subgraph in which every vertex has degree >= k).
+    std::vector<u32> core;
+    u32 degeneracy = 0; // largest core number
+};
+
+// Batagelj-Zaversnik peeling in O(n + m): vertices sit in an array bucketed
+// by current degree; taking them in order and moving each higher-degree
+// neighbour one bucket down is a constant-time swap with its bucket's head.
+// `sym` must be symmetric (see CsrAdjacency::symmetrized).
+[[nodiscard]] inline CoreDecomposition core_decomposition(const CsrAdjacency& sym)
+{
+    const usize n = sym.vertex_count();
+    CoreDecomposition r;
+    r.core.resize(n);
+    if (n == 0) return r;
+
+    std::vector<u32>& degree = r.core; // peeled in place into core numbers
+    u32 max_degree = 0;
+    for (usize v = 0; v < n; ++v)
+    {
+        degree[v] = static_cast<u32>(sym.degree(static_cast<VertexId>(v)));
+        max_degree = std::max(max_degree, degree[v]);
+    }
+
+    // bin[d] = first position of degree-d vertices in `order`.
+    std::vector<usize> bin(max_degree + 1, 0);
+    for (u32 d : degree) ++bin[d];
+    usize start = 0;
+    for (usize& b : bin) start += std::exchange(b, start);
+
+    std::vector<VertexId> order(n);
+    std::vector<usize> pos(n);
+    for (usize v = 0; v < n; ++v)
+    {
+        pos[v] = bin[degree[v]]++;
+        order[pos[v]] = static_cast<VertexId>(v);
+    }
+    for (usize d = max_degree; d > 0; --d) bin[d] = bin[d - 1];
+    bin[0] = 0;
+
+    for (usize i = 0; i < n; ++i)
+    {
+        const VertexId v = order[i];
+        for (VertexId u : sym.neighbors(v))
+        {
+            if (degree[u] <= degree[v]) continue;
+            const u32 du = degree[u];
+            const usize pu = pos[u];
+            const usize pw = bin[du];
+            const VertexId w = order[pw];
+            if (u != w)
+            {
+                std::swap(order[pu], order[pw]);
+                pos[u] = pw;
+                pos[w] = pu;
+            }
+            ++bin[du];
+            --degree[u];
+        }
+    }
+
+    r.degeneracy = *std::ranges::max_element(r.core);
+    return r;
+}
+
+template <typename T>
+[[nodiscard]] CoreDecomposition core_decomposition(const CsrGraph<T>& g)
+{
+    return core_decomposition(g.adjacency().symmetrized());
+}
+} // namespace dsalgo
@@ -0,0 +1,661 @@
+// dsalgo/src/matrix.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <functional>
+#include <new>
+#include <print>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "gemm.hpp"
+#include "hardware.hpp"
+#include "transpose.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// Tag for constructors that leave the elements uninitialized, for results
+// that are about to be overwritten anyway.
+struct NoInit
+{
+    explicit NoInit() = default;
+};
+inline constexpr NoInit no_init{};
+
+// Row-major stores each row contiguously, column-major each column; either
+// way the stored lines are stride() elements apart.
+enum class Layout
+{
+    RowMajor,
+    ColMajor,
+};
+
+// Stride (in elements) for stored lines of n elements. Short lines are left
+// packed. Longer ones are rounded up to whole cache lines, so every line
+// starts 64-byte aligned, plus one extra cache line when the count is a
+// multiple of 8: at a stride that is a multiple of 512 bytes (any
+// power-of-two width from there up) a walk down a column only ever touches
+// 1/8 of the cache sets or fewer and starts evicting itself after a few
+// dozen rows.
+template <typename T>
+constexpr usize padded_stride(usize n) noexcept
+{
+    constexpr usize per_line = cache_line_bytes / sizeof(T);
+    constexpr usize alias_lines = 8;
+    if (n < alias_lines * per_line) return n;
+    usize lines = (n + per_line - 1) / per_line;
+    if (lines % alias_lines == 0) ++lines;
+    return lines * per_line;
+}
+
+// Matrix types with cache-line aligned storage in a Layout (rows(), cols(),
+// data(), stride(), operator() and a static `layout`) opt in here to take
+// part in the expression templates below.
+template <typename E>
+inline constexpr bool is_matrix_leaf = false;
+
+template <typename E>
+concept MatrixExpression =
+    is_matrix_leaf<std::remove_cvref_t<E>> || requires { typename std::remove_cvref_t<E>::matrix_node; };
+
+namespace detail
+{
+template <typename Dst, typename E>
+void assign(Dst& dst, const E& e);
+} // namespace detail
+
+// Row-major N x M matrix on the heap (cache-line aligned, rows
+// padded_stride() apart), zero-initialized unless constructed with no_init.
+// Moves hand over the buffer; a moved-from matrix may only be assigned to or
+// destroyed.
+template <std::floating_point T, usize N, usize M>
+    requires(N > 0 and M > 0)
+class Matrix
+{
+public:
+    using value_type = T;
+    static constexpr Layout layout = Layout::RowMajor;
+
+    Matrix() : Matrix(no_init) { std::fill_n(m_data, N * stride(), T{0}); }
+    explicit Matrix(NoInit) : m_data(allocate()) {}
+    Matrix(const Matrix& other) : Matrix(no_init) { std::copy_n(other.m_data, N * stride(), m_data); }
+    Matrix(Matrix&& other) noexcept : m_data(std::exchange(other.m_data, nullptr)) {}
+
+    // Evaluates an expression such as A * B + C straight into the new matrix.
+    template <MatrixExpression E>
+        requires(!std::same_as<std::remove_cvref_t<E>, Matrix>)
+    Matrix(const E& e) : Matrix(no_init)
+    {
+        detail::assign(*this, e);
+    }
+
+    Matrix& operator=(const Matrix& other)
+    {
+        if (this == &other) return *this;
+        if (m_data == nullptr) m_data = allocate();
+        std::copy_n(other.m_data, N * stride(), m_data);
+        return *this;
+    }
+    Matrix& operator=(Matrix&& other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        return *this;
+    }
+    template <MatrixExpression E>
+        requires(!std::same_as<std::remove_cvref_t<E>, Matrix>)
+    Matrix& operator=(const E& e)
+    {
+        if (m_data == nullptr) m_data = allocate();
+        detail::assign(*this, e);
+        return *this;
+    }
+
+    ~Matrix() { ::operator delete(m_data, std::align_val_t{cache_line_bytes}); }
+
+    static constexpr auto rows() noexcept -> usize { return N; }
+    static constexpr auto cols() noexcept -> usize { return M; }
+    static constexpr auto stride() noexcept -> usize { return padded_stride<T>(M); }
+
+    auto data() noexcept -> T* { return m_data; }
+    auto data() const noexcept -> const T* { return m_data; }
+
+    auto row(usize i) noexcept -> T* { return m_data + i * stride(); }
+    auto row(usize i) const noexcept -> const T* { return m_data + i * stride(); }
+    auto operator()(usize i, usize j) const -> T { return row(i)[j]; }
+    auto operator()(usize i, usize j) -> T& { return row(i)[j]; }
+
+    template <typename F>
+        requires(std::is_convertible_v<F, T>)
+    static auto Diagonal(F value = static_cast<F>(1.0)) -> Matrix
+    {
+        Matrix out{};
+        const auto val_t = static_cast<T>(value);
+        for (usize i = 0; i < std::min(N, M); ++i) out(i, i) = val_t;
+        return out;
+    }
+
+    auto transposed() const -> Matrix<T, M, N>
+    {
+        Matrix<T, M, N> out{no_init};
+        transpose(m_data, N, M, stride(), out.data(), out.stride());
+        return out;
+    }
+
+    auto transpose_in_place() -> void
+        requires(N == M)
+    {
+        ::dsalgo::transpose_in_place(m_data, N, stride());
+    }
+
+private:
+    static auto allocate() -> T*
+    {
+        return static_cast<T*>(::operator new(N * stride() * sizeof(T), std::align_val_t{cache_line_bytes}));
+    }
+
+    T* m_data{};
+};
+
+template <usize N, usize M>
+using Matrix32 = Matrix<f32, N, M>;
+template <usize N, usize M>
+using Matrix64 = Matrix<f64, N, M>;
+
+// Matrix with its dimensions chosen at run time, zero-initialized, stored in
+// layout L. Storage is cache-line aligned so it can be handed to gemm
+// directly; lines are padded_stride() apart unless a stride is given (pass
+// the line length for packed storage).
+template <std::floating_point T, Layout L = Layout::RowMajor>
+class DynMatrix
+{
+public:
+    using value_type = T;
+    static constexpr Layout layout = L;
+
+    DynMatrix() = default;
+    DynMatrix(usize rows, usize cols) : DynMatrix(rows, cols, padded_stride<T>(L == Layout::RowMajor ? cols : rows)) {}
+    DynMatrix(usize rows, usize cols, usize stride)
+        : m_rows(rows), m_cols(cols), m_stride(stride), m_data(line_count() * stride, T{0})
+    {
+        if (stride < line_length()) throw std::invalid_argument("DynMatrix: stride shorter than a line");
+    }
+
+    // Evaluates an expression, or converts from another layout.
+    template <MatrixExpression E>
+        requires(!std::same_as<std::remove_cvref_t<E>, DynMatrix>)
+    DynMatrix(const E& e) : DynMatrix(e.rows(), e.cols())
+    {
+        detail::assign(*this, e);
+    }
+
+    // Reshapes to the expression's dimensions. If that changes the shape, the
+    // result is built separately first, since the expression may read *this.
+    template <MatrixExpression E>
+        requires(!std::same_as<std::remove_cvref_t<E>, DynMatrix>)
+    DynMatrix& operator=(const E& e)
+    {
+        if (e.rows() != m_rows || e.cols() != m_cols) return *this = DynMatrix(e);
+        detail::assign(*this, e);
+        return *this;
+    }
+
+    [[nodiscard]] usize rows() const noexcept { return m_rows; }
+    [[nodiscard]] usize cols() const noexcept { return m_cols; }
+    [[nodiscard]] usize stride() const noexcept { return m_stride; }
+
+    T* data() noexcept { return m_data.data(); }
+    const T* data() const noexcept { return m_data.data(); }
+
+    T* row(usize i) noexcept
+        requires(L == Layout::RowMajor)
+    {
+        return data() + i * m_stride;
+    }
+    const T* row(usize i) const noexcept
+        requires(L == Layout::RowMajor)
+    {
+        return data() + i * m_stride;
+    }
+    T* col(usize j) noexcept
+        requires(L == Layout::ColMajor)
+    {
+        return data() + j * m_stride;
+    }
+    const T* col(usize j) const noexcept
+        requires(L == Layout::ColMajor)
+    {
+        return data() + j * m_stride;
+    }
+    T operator()(usize i, usize j) const { return m_data[offset(i, j)]; }
+    T& operator()(usize i, usize j) { return m_data[offset(i, j)]; }
+
+    [[nodiscard]] static DynMatrix identity(usize n)
+    {
+        DynMatrix out(n, n);
+        for (usize i = 0; i < n; ++i) out(i, i) = T{1};
+        return out;
+    }
+
+    [[nodiscard]] DynMatrix transposed() const
+    {
+        DynMatrix out(m_cols, m_rows);
+        transpose(data(), line_count(), line_length(), m_stride, out.data(), out.stride());
+        return out;
+    }
+
+    // Square matrices are transposed tile by tile in place; anything else
+    // needs a second buffer for the reshaped result.
+    void transpose_in_place()
+    {
+        if (m_rows == m_cols) ::dsalgo::transpose_in_place(data(), m_rows, m_stride);
+        else *this = transposed();
+    }
+
+    // The same buffer read in the other layout is the transpose, so handing a
+    // matrix to a stage that wants it transposed and in the other layout
+    // costs nothing.
+    [[nodiscard]] auto into_transposed() && -> DynMatrix<T, L == Layout::RowMajor ? Layout::ColMajor : Layout::RowMajor>
+    {
+        DynMatrix<T, L == Layout::RowMajor ? Layout::ColMajor : Layout::RowMajor> out;
+        out.m_rows = std::exchange(m_cols, 0);
+        out.m_cols = std::exchange(m_rows, 0);
+        out.m_stride = std::exchange(m_stride, 0);
+        out.m_data = std::move(m_data);
+        m_data.clear();
+        return out;
+    }
+
+private:
+    template <std::floating_point, Layout>
+    friend class DynMatrix;
+
+    // Stored lines (rows or columns) and their length.
+    usize line_count() const noexcept { return L == Layout::RowMajor ? m_rows : m_cols; }
+    usize line_length() const noexcept { return L == Layout::RowMajor ? m_cols : m_rows; }
+    usize offset(usize i, usize j) const noexcept
+    {
+        return L == Layout::RowMajor ? i * m_stride + j : j * m_stride + i;
+    }
+
+    usize m_rows = 0;
+    usize m_cols = 0;
+    usize m_stride = 0;
+    std::vector<T, AlignedAllocator<T>> m_data;
+};
+
+template <std::floating_point T, usize N, usize M>
+inline constexpr bool is_matrix_leaf<Matrix<T, N, M>> = true;
+template <std::floating_point T, Layout L>
+inline constexpr bool is_matrix_leaf<DynMatrix<T, L>> = true;
+
+// Expression templates: +, - and scalar * on Matrix / DynMatrix build
+// lightweight nodes that are evaluated elementwise in one pass on
+// assignment, and matrix * matrix becomes a gemm. `D = A * B + C` copies C
+// into D and accumulates the product on top, with no temporary; a product
+// anywhere else in an expression is evaluated once into a DynMatrix.
+// Leaves are held by reference, so an expression must be evaluated before the
+// matrices it names go away (assign it, don't keep it in `auto`).
+namespace detail
+{
+template <typename E>
+using Operand = std::conditional_t<is_matrix_leaf<std::remove_cvref_t<E>>, const std::remove_cvref_t<E>&,
+                                   std::remove_cvref_t<E>>;
+
+template <typename E>
+using ValueOf = typename std::remove_cvref_t<E>::value_type;
+
+template <typename L, typename R, typename Op>
+struct Elementwise
+{
+    using matrix_node = void;
+    using value_type = ValueOf<L>;
+    static_assert(std::same_as<ValueOf<L>, ValueOf<R>>, "matrix expression mixes element types");
+
+    Operand<L> l;
+    Operand<R> r;
+
+    Elementwise(const L& lhs, const R& rhs) : l(lhs), r(rhs)
+    {
+        if (l.rows() != r.rows() || l.cols() != r.cols()) throw std::invalid_argument("matrix dimensions differ");
+    }
+
+    [[nodiscard]] usize rows() const noexcept { return l.rows(); }
+    [[nodiscard]] usize cols() const noexcept { return l.cols(); }
+    value_type operator()(usize i, usize j) const { return Op{}(l(i, j), r(i, j)); }
+};
+
+template <typename E>
+struct Scaled
+{
+    using matrix_node = void;
+    using value_type = ValueOf<E>;
+
+    value_type s;
+    Operand<E> e;
+
+    [[nodiscard]] usize rows() const noexcept { return e.rows(); }
+    [[nodiscard]] usize cols() const noexcept { return e.cols(); }
+    value_type operator()(usize i, usize j) const { return s * e(i, j); }
+};
+
+template <typename L, typename R>
+struct Product
+{
+    using matrix_node = void;
+    using value_type = ValueOf<L>;
+    static_assert(std::same_as<ValueOf<L>, ValueOf<R>>, "matrix expression mixes element types");
+
+    Operand<L> l;
+    Operand<R> r;
+    // Filled by prepare() when the product is used elementwise.
+    mutable DynMatrix<value_type> value;
+
+    Product(const L& lhs, const R& rhs) : l(lhs), r(rhs)
+    {
+        if (l.cols() != r.rows()) throw std::invalid_argument("matrix product dimensions differ");
+    }
+
+    [[nodiscard]] usize rows() const noexcept { return l.rows(); }
+    [[nodiscard]] usize cols() const noexcept { return r.cols(); }
+    value_type operator()(usize i, usize j) const { return value(i, j); }
+};
+
+template <typename E>
+inline constexpr bool is_product = false;
+template <typename L, typename R>
+inline constexpr bool is_product<Product<L, R>> = true;
+
+template <typename E>
+inline constexpr bool is_sum = false;
+template <typename L, typename R>
+inline constexpr bool is_sum<Elementwise<L, R, std::plus<>>> = true;
+
+template <typename E>
+bool aliases(const E& e, const void* p) noexcept
+{
+    if constexpr (is_matrix_leaf<E>) return e.data() == p;
+    else if constexpr (requires { e.s; }) return aliases(e.e, p);
+    else return aliases(e.l, p) || aliases(e.r, p);
+}
+
+// Leaves already stored in layout L as they are, anything else evaluated (or
+// converted) into one.
+template <Layout L, typename E>
+decltype(auto) materialize(const E& e)
+{
+    if constexpr (is_matrix_leaf<E>)
+    {
+        if constexpr (E::layout == L) return (e);
+        else return DynMatrix<ValueOf<E>, L>(e);
+    }
+    else return DynMatrix<ValueOf<E>, L>(e);
+}
+
+// dst (+)= p.l * p.r; dst must not alias the operands. The operands are
+// brought into dst's layout first. A column-major matrix is the row-major
+// buffer of its transpose, so that case is C^T = B^T A^T on the same gemm.
+template <typename Dst, typename L, typename R>
+void multiply_into(Dst& dst, const Product<L, R>& p, bool accumulate)
+{
+    decltype(auto) a = materialize<Dst::layout>(p.l);
+    decltype(auto) b = materialize<Dst::layout>(p.r);
+    if constexpr (Dst::layout == Layout::RowMajor)
+    {
+        gemm_parallel(a.rows(), b.cols(), a.cols(), a.data(), a.stride(), b.data(), b.stride(), dst.data(),
+                      dst.stride(), accumulate);
+    }
+    else
+    {
+        gemm_parallel(b.cols(), a.rows(), a.cols(), b.data(), b.stride(), a.data(), a.stride(), dst.data(),
+                      dst.stride(), accumulate);
+    }
+}
+
+// Evaluates every product that will be read elementwise.
+template <typename E>
+void prepare(const E& e)
+{
+    if constexpr (is_matrix_leaf<E>) return;
+    else if constexpr (is_product<E>)
+    {
+        if (e.value.rows() == 0)
+        {
+            e.value = DynMatrix<ValueOf<E>>(e.rows(), e.cols());
+            multiply_into(e.value, e, false);
+        }
+    }
+    else if constexpr (requires { e.s; }) prepare(e.e);
+    else
+    {
+        prepare(e.l);
+        prepare(e.r);
+    }
+}
+
+// Walks dst along its stored lines.
+template <typename Dst, typename E>
+void assign_elementwise(Dst& dst, const E& e)
+{
+    prepare(e);
+    if constexpr (Dst::layout == Layout::RowMajor)
+    {
+        for (usize i = 0; i < dst.rows(); ++i)
+        {
+            auto* out = dst.row(i);
+            for (usize j = 0; j < dst.cols(); ++j) out[j] = e(i, j);
+        }
+    }
+    else
+    {
+        for (usize j = 0; j < dst.cols(); ++j)
+        {
+            auto* out = dst.col(j);
+            for (usize i = 0; i < dst.rows(); ++i) out[i] = e(i, j);
+        }
+    }
+}
+
+template <typename Dst, typename E>
+void assign(Dst& dst, const E& e)
+{
+    if (dst.rows() != e.rows() || dst.cols() != e.cols()) throw std::invalid_argument("matrix dimensions differ");
+
+    if constexpr (is_matrix_leaf<E>)
+    {
+        // Changing layout: the stored lines of one are the transpose of the
+        // other's.
+        if constexpr (E::layout != Dst::layout)
+        {
+            const usize lines = E::layout == Layout::RowMajor ? e.rows() : e.cols();
+            const usize length = E::layout == Layout::RowMajor ? e.cols() : e.rows();
+            return transpose(e.data(), lines, length, e.stride(), dst.data(), dst.stride());
+        }
+    }
+    else if constexpr (is_product<E>)
+    {
+        if (!aliases(e, dst.data())) return multiply_into(dst, e, false);
+    }
+    else if constexpr (is_sum<E>)
+    {
+        // X + A * B and A * B + X: dst = X, then dst += A * B.
+        using L = std::remove_cvref_t<decltype(e.l)>;
+        using R = std::remove_cvref_t<decltype(e.r)>;
+        if constexpr (is_product<R>)
+        {
+            if (!aliases(e.r, dst.data()))
+            {
+                assign(dst, e.l);
+                return multiply_into(dst, e.r, true);
+            }
+        }
+        else if constexpr (is_product<L>)
+        {
+            if (!aliases(e.l, dst.data()))
+            {
+                assign(dst, e.r);
+                return multiply_into(dst, e.l, true);
+            }
+        }
+    }
+    assign_elementwise(dst, e);
+}
+} // namespace detail
+
+template <MatrixExpression L, MatrixExpression R>
+auto operator+(const L& l, const R& r)
+{
+    return detail::Elementwise<L, R, std::plus<>>{l, r};
+}
+
+template <MatrixExpression L, MatrixExpression R>
+auto operator-(const L& l, const R& r)
+{
+    return detail::Elementwise<L, R, std::minus<>>{l, r};
+}
+
+template <MatrixExpression L, MatrixExpression R>
+auto operator*(const L& l, const R& r)
+{
+    return detail::Product<L, R>{l, r};
+}
+
+template <MatrixExpression E>
+auto operator*(detail::ValueOf<E> s, const E& e)
+{
+    return detail::Scaled<E>{s, e};
+}
+
+template <MatrixExpression E>
+auto operator*(const E& e, detail::ValueOf<E> s)
+{
+    return detail::Scaled<E>{s, e};
+}
+
+template <std::floating_point T, usize N, usize K, usize M>
+auto GEMM(const Matrix<T, N, K>& A, const Matrix<T, K, M>& B, Matrix<T, N, M>& C) -> void
+{
+    gemm_parallel(N, M, K, A.data(), A.stride(), B.data(), B.stride(), C.data(), C.stride());
+}
+
+template <std::floating_point T, usize N, usize K, usize M>
+auto GEMM(const Matrix<T, N, K>& A, const Matrix<T, K, M>& B) -> Matrix<T, N, M>
+{
+    Matrix<T, N, M> C{no_init};
+    GEMM(A, B, C);
+    return C;
+}
+
+// Fixed-size matrix stored inline, for the small transforms geometry code
+// multiplies millions of times: no allocation, trivially copyable, and every
+// operation is constexpr. Operators evaluate eagerly; at these sizes the
+// compiler keeps the whole thing in registers anyway.
+template <std::floating_point T, usize N, usize M>
+    requires(N > 0 and M > 0)
+struct SmallMatrix
+{
+    using value_type = T;
+
+    std::array<T, N * M> elements{};
+
+    static constexpr auto rows() noexcept -> usize { return N; }
+    static constexpr auto cols() noexcept -> usize { return M; }
+
+    constexpr auto data() noexcept -> T* { return elements.data(); }
+    constexpr auto data() const noexcept -> const T* { return elements.data(); }
+    constexpr auto operator()(usize i, usize j) const -> T { return elements[i * M + j]; }
+    constexpr auto operator()(usize i, usize j) -> T& { return elements[i * M + j]; }
+
+    static constexpr auto Diagonal(T value = T{1}) -> SmallMatrix
+    {
+        SmallMatrix out{};
+        for (usize i = 0; i < std::min(N, M); ++i) out(i, i) = value;
+        return out;
+    }
+
+    constexpr auto transposed() const -> SmallMatrix<T, M, N>
+    {
+        SmallMatrix<T, M, N> out{};
+        for (usize i = 0; i < N; ++i)
+        {
+            for (usize j = 0; j < M; ++j) out(j, i) = (*this)(i, j);
+        }
+        return out;
+    }
+
+    friend constexpr auto operator+(const SmallMatrix& a, const SmallMatrix& b) -> SmallMatrix
+    {
+        SmallMatrix out{};
+        for (usize i = 0; i < N * M; ++i) out.elements[i] = a.elements[i] + b.elements[i];
+        return out;
+    }
+
+    friend constexpr auto operator-(const SmallMatrix& a, const SmallMatrix& b) -> SmallMatrix
+    {
+        SmallMatrix out{};
+        for (usize i = 0; i < N * M; ++i) out.elements[i] = a.elements[i] - b.elements[i];
+        return out;
+    }
+
+    friend constexpr auto operator*(T s, const SmallMatrix& a) -> SmallMatrix
+    {
+        SmallMatrix out{};
+        for (usize i = 0; i < N * M; ++i) out.elements[i] = s * a.elements[i];
+        return out;
+    }
+    friend constexpr auto operator*(const SmallMatrix& a, T s) -> SmallMatrix { return s * a; }
+
+    // i-k-j order, so the inner loop runs along rows of b and out.
+    template <usize P>
+    friend constexpr auto operator*(const SmallMatrix& a, const SmallMatrix<T, M, P>& b) -> SmallMatrix<T, N, P>
+    {
+        SmallMatrix<T, N, P> out{};
+        for (usize i = 0; i < N; ++i)
+        {
+            for (usize k = 0; k < M; ++k)
+            {
+                const T aik = a(i, k);
+                for (usize j = 0; j < P; ++j) out(i, j) += aik * b(k, j);
+            }
+        }
+        return out;
+    }
+
+    constexpr auto operator+=(const SmallMatrix& other) -> SmallMatrix& { return *this = *this + other; }
+    constexpr auto operator-=(const SmallMatrix& other) -> SmallMatrix& { return *this = *this - other; }
+};
+
+template <usize N, usize M>
+using SmallMatrix32 = SmallMatrix<f32, N, M>;
+template <usize N, usize M>
+using SmallMatrix64 = SmallMatrix<f64, N, M>;
+
+template <typename A>
+    requires requires(const A& a) {
+        a.rows();
+        a.cols();
+        a(0, 0);
+    }
+auto print(const A& a) -> void
+{
+    std::print("[");
+    for (usize i{0}; i < a.rows(); ++i)
+    {
+        if (i > 0) std::print(" ");
+        std::print("[");
+        for (usize j{0}; j < a.cols(); ++j)
+        {
+            if (j > 0) std::print(", ");
+            std::print("{:8.4f}", a(i, j));
+        }
+        std::print("]");
+        if (i + 1 < a.rows()) std::print("\n");
+    }
+    std::print("]\n");
+}
+} // namespace dsalgo
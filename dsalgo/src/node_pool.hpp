@@ -0,0 +1,119 @@
+// dsalgo/src/node_pool.hpp
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+
+namespace dsalgo
+{
+// Fixed-size object pool for node based containers. Memory is carved out of
+// chunks of `ChunkSize` slots and recycled through an intrusive free list, so
+// creating a node is a pointer bump or a free-list pop instead of a trip to
+// the global allocator. Addresses stay stable for the lifetime of the pool.
+//
+// The pool only owns memory: objects still alive when the pool dies are not
+// destroyed, the owning container is expected to destroy() them first.
+template <typename T, usize ChunkSize = 1024>
+class NodePool
+{
+    static_assert(ChunkSize > 0, "ChunkSize must be positive");
+
+public:
+    NodePool() = default;
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    NodePool(NodePool&& other) noexcept
+        : m_chunks(std::move(other.m_chunks)),
+          m_free(std::exchange(other.m_free, nullptr)),
+          m_chunk_used(std::exchange(other.m_chunk_used, ChunkSize)),
+          m_live(std::exchange(other.m_live, 0))
+    {
+    }
+
+    NodePool& operator=(NodePool&& other) noexcept
+    {
+        if (this != &other)
+        {
+            m_chunks = std::move(other.m_chunks);
+            m_free = std::exchange(other.m_free, nullptr);
+            m_chunk_used = std::exchange(other.m_chunk_used, ChunkSize);
+            m_live = std::exchange(other.m_live, 0);
+        }
+        return *this;
+    }
+
+    template <typename... Args>
+    [[nodiscard]] T* create(Args&&... args)
+    {
+        Slot* slot = acquire_slot();
+        try
+        {
+            T* obj = ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+            ++m_live;
+            return obj;
+        }
+        catch (...)
+        {
+            release_slot(slot);
+            throw;
+        }
+    }
+
+    void destroy(T* obj) noexcept
+    {
+        std::destroy_at(obj);
+        release_slot(reinterpret_cast<Slot*>(obj));
+        --m_live;
+    }
+
+    // Drops every chunk. Only valid once all live objects have been destroyed.
+    void release() noexcept
+    {
+        m_chunks.clear();
+        m_free = nullptr;
+        m_chunk_used = ChunkSize;
+        m_live = 0;
+    }
+
+    [[nodiscard]] usize live() const noexcept { return m_live; }
+    [[nodiscard]] usize capacity() const noexcept { return m_chunks.size() * ChunkSize; }
+
+private:
+    union Slot
+    {
+        Slot* next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    Slot* acquire_slot()
+    {
+        if (m_free)
+        {
+            return std::exchange(m_free, m_free->next);
+        }
+        if (m_chunk_used == ChunkSize)
+        {
+            m_chunks.emplace_back(new Slot[ChunkSize]);
+            m_chunk_used = 0;
+        }
+        return &m_chunks.back()[m_chunk_used++];
+    }
+
+    void release_slot(Slot* slot) noexcept
+    {
+        slot->next = m_free;
+        m_free = slot;
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> m_chunks;
+    Slot* m_free = nullptr;
+    usize m_chunk_used = ChunkSize;
+    usize m_live = 0;
+};
+} // namespace dsalgo
@@ -0,0 +1,395 @@
+// dsalgo/src/ordered_map.hpp
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "node_pool.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// AVL tree keyed by K. Nodes carry a parent link (unlike BinaryTreeNode) so
+// iteration and erase need no auxiliary stack, and they are carved out of a
+// NodePool rather than allocated one by one.
+template <typename K, typename V, typename Compare = std::less<K>>
+class OrderedMap
+{
+    struct Node
+    {
+        template <typename KK, typename VV>
+        Node(KK&& key, VV&& value, Node* parent_)
+            : kv(std::forward<KK>(key), std::forward<VV>(value)), parent(parent_)
+        {
+        }
+
+        std::pair<const K, V> kv;
+        Node* left = nullptr;
+        Node* right = nullptr;
+        Node* parent = nullptr;
+        i32 height = 1;
+    };
+
+    template <bool Const>
+    class Iter
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const K, V>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+        Iter() = default;
+        explicit Iter(Node* node) noexcept : m_node(node) {}
+
+        template <bool C = Const>
+            requires C
+        Iter(const Iter<false>& other) noexcept : m_node(other.m_node)
+        {
+        }
+
+        reference operator*() const noexcept { return m_node->kv; }
+        pointer operator->() const noexcept { return &m_node->kv; }
+
+        Iter& operator++() noexcept
+        {
+            m_node = successor(m_node);
+            return *this;
+        }
+
+        Iter operator++(int) noexcept
+        {
+            Iter tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const Iter& a, const Iter& b) noexcept { return a.m_node == b.m_node; }
+
+    private:
+        friend class OrderedMap;
+        template <bool>
+        friend class Iter;
+        Node* m_node = nullptr;
+    };
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+    using iterator = Iter<false>;
+    using const_iterator = Iter<true>;
+
+    OrderedMap() = default;
+    explicit OrderedMap(Compare cmp) : m_cmp(std::move(cmp)) {}
+
+    OrderedMap(const OrderedMap&) = delete;
+    OrderedMap& operator=(const OrderedMap&) = delete;
+
+    OrderedMap(OrderedMap&& other) noexcept
+        : m_pool(std::move(other.m_pool)),
+          m_root(std::exchange(other.m_root, nullptr)),
+          m_size(std::exchange(other.m_size, 0)),
+          m_cmp(std::move(other.m_cmp))
+    {
+    }
+
+    OrderedMap& operator=(OrderedMap&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            m_pool = std::move(other.m_pool);
+            m_root = std::exchange(other.m_root, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_cmp = std::move(other.m_cmp);
+        }
+        return *this;
+    }
+
+    ~OrderedMap() { clear(); }
+
+    // Returns true if the key was new, otherwise overwrites the value and returns false.
+    bool insert(const K& key, V value)
+    {
+        Node* parent = nullptr;
+        Node** link = &m_root;
+        while (*link)
+        {
+            parent = *link;
+            if (m_cmp(key, parent->kv.first)) link = &parent->left;
+            else if (m_cmp(parent->kv.first, key)) link = &parent->right;
+            else
+            {
+                parent->kv.second = std::move(value);
+                return false;
+            }
+        }
+
+        *link = m_pool.create(key, std::move(value), parent);
+        ++m_size;
+        retrace(parent);
+        return true;
+    }
+
+    bool erase(const K& key)
+    {
+        Node* node = find_node(key);
+        if (!node) return false;
+        erase_node(node);
+        return true;
+    }
+
+    [[nodiscard]] V* find(const K& key)
+    {
+        Node* node = find_node(key);
+        return node ? &node->kv.second : nullptr;
+    }
+
+    [[nodiscard]] const V* find(const K& key) const
+    {
+        const Node* node = find_node(key);
+        return node ? &node->kv.second : nullptr;
+    }
+
+    [[nodiscard]] bool contains(const K& key) const { return find_node(key) != nullptr; }
+
+    // First entry whose key is not less than `key`. Not noexcept: the
+    // comparator may throw.
+    [[nodiscard]] iterator lower_bound(const K& key) { return iterator{lower_bound_node(key)}; }
+    [[nodiscard]] const_iterator lower_bound(const K& key) const { return const_iterator{lower_bound_node(key)}; }
+
+    // First entry whose key is greater than `key`.
+    [[nodiscard]] iterator upper_bound(const K& key) { return iterator{upper_bound_node(key)}; }
+    [[nodiscard]] const_iterator upper_bound(const K& key) const { return const_iterator{upper_bound_node(key)}; }
+
+    // In-order view over the keys in [lo, hi); empty when hi < lo.
+    [[nodiscard]] auto range(const K& lo, const K& hi)
+    {
+        const iterator first = lower_bound(lo);
+        return std::ranges::subrange(first, m_cmp(hi, lo) ? first : lower_bound(hi));
+    }
+
+    [[nodiscard]] auto range(const K& lo, const K& hi) const
+    {
+        const const_iterator first = lower_bound(lo);
+        return std::ranges::subrange(first, m_cmp(hi, lo) ? first : lower_bound(hi));
+    }
+
+    [[nodiscard]] iterator begin() noexcept { return iterator{leftmost(m_root)}; }
+    [[nodiscard]] iterator end() noexcept { return iterator{}; }
+    [[nodiscard]] const_iterator begin() const noexcept { return const_iterator{leftmost(m_root)}; }
+    [[nodiscard]] const_iterator end() const noexcept { return const_iterator{}; }
+
+    [[nodiscard]] usize size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] i32 height() const noexcept { return height_of(m_root); }
+
+    void clear() noexcept
+    {
+        // Post-order walk without recursion: descend to a leaf, free it, climb to its parent.
+        Node* node = m_root;
+        while (node)
+        {
+            if (node->left) node = node->left;
+            else if (node->right) node = node->right;
+            else
+            {
+                Node* parent = node->parent;
+                if (parent)
+                {
+                    if (parent->left == node) parent->left = nullptr;
+                    else parent->right = nullptr;
+                }
+                m_pool.destroy(node);
+                node = parent;
+            }
+        }
+        m_root = nullptr;
+        m_size = 0;
+        m_pool.release();
+    }
+
+private:
+    static i32 height_of(const Node* n) noexcept { return n ? n->height : 0; }
+
+    static void update_height(Node* n) noexcept
+    {
+        n->height = 1 + std::max(height_of(n->left), height_of(n->right));
+    }
+
+    static Node* leftmost(Node* n) noexcept
+    {
+        if (!n) return nullptr;
+        while (n->left) n = n->left;
+        return n;
+    }
+
+    static Node* successor(Node* n) noexcept
+    {
+        if (n->right) return leftmost(n->right);
+        Node* p = n->parent;
+        while (p && n == p->right)
+        {
+            n = p;
+            p = p->parent;
+        }
+        return p;
+    }
+
+    Node* find_node(const K& key) const
+    {
+        Node* n = m_root;
+        while (n)
+        {
+            if (m_cmp(key, n->kv.first)) n = n->left;
+            else if (m_cmp(n->kv.first, key)) n = n->right;
+            else return n;
+        }
+        return nullptr;
+    }
+
+    Node* lower_bound_node(const K& key) const
+    {
+        Node* n = m_root;
+        Node* best = nullptr;
+        while (n)
+        {
+            if (m_cmp(n->kv.first, key)) n = n->right;
+            else
+            {
+                best = n;
+                n = n->left;
+            }
+        }
+        return best;
+    }
+
+    Node* upper_bound_node(const K& key) const
+    {
+        Node* n = m_root;
+        Node* best = nullptr;
+        while (n)
+        {
+            if (m_cmp(key, n->kv.first))
+            {
+                best = n;
+                n = n->left;
+            }
+            else n = n->right;
+        }
+        return best;
+    }
+
+    void replace_child(Node* parent, Node* old_child, Node* new_child) noexcept
+    {
+        if (!parent) m_root = new_child;
+        else if (parent->left == old_child) parent->left = new_child;
+        else parent->right = new_child;
+    }
+
+    Node* rotate_left(Node* x) noexcept
+    {
+        Node* y = x->right;
+        x->right = y->left;
+        if (y->left) y->left->parent = x;
+        y->parent = x->parent;
+        replace_child(x->parent, x, y);
+        y->left = x;
+        x->parent = y;
+        update_height(x);
+        update_height(y);
+        return y;
+    }
+
+    Node* rotate_right(Node* x) noexcept
+    {
+        Node* y = x->left;
+        x->left = y->right;
+        if (y->right) y->right->parent = x;
+        y->parent = x->parent;
+        replace_child(x->parent, x, y);
+        y->right = x;
+        x->parent = y;
+        update_height(x);
+        update_height(y);
+        return y;
+    }
+
+    // Restores the AVL invariant at `n` and returns the root of that subtree.
+    Node* rebalance(Node* n) noexcept
+    {
+        const i32 balance = height_of(n->left) - height_of(n->right);
+        if (balance > 1)
+        {
+            if (height_of(n->left->left) < height_of(n->left->right)) rotate_left(n->left);
+            return rotate_right(n);
+        }
+        if (balance < -1)
+        {
+            if (height_of(n->right->right) < height_of(n->right->left)) rotate_right(n->right);
+            return rotate_left(n);
+        }
+        update_height(n);
+        return n;
+    }
+
+    void retrace(Node* n) noexcept
+    {
+        while (n)
+        {
+            n = rebalance(n)->parent;
+        }
+    }
+
+    void erase_node(Node* z) noexcept
+    {
+        Node* retrace_from = nullptr;
+
+        if (!z->left || !z->right)
+        {
+            Node* child = z->left ? z->left : z->right;
+            if (child) child->parent = z->parent;
+            replace_child(z->parent, z, child);
+            retrace_from = z->parent;
+        }
+        else
+        {
+            // Relink the in-order successor into z's place; keys are const so nodes are moved, not values.
+            Node* s = leftmost(z->right);
+            if (s->parent != z)
+            {
+                retrace_from = s->parent;
+                s->parent->left = s->right;
+                if (s->right) s->right->parent = s->parent;
+                s->right = z->right;
+                s->right->parent = s;
+            }
+            else
+            {
+                retrace_from = s;
+            }
+            s->left = z->left;
+            s->left->parent = s;
+            s->parent = z->parent;
+            replace_child(z->parent, z, s);
+            s->height = z->height;
+        }
+
+        m_pool.destroy(z);
+        --m_size;
+        retrace(retrace_from);
+    }
+
+    NodePool<Node> m_pool;
+    Node* m_root = nullptr;
+    usize m_size = 0;
+    [[no_unique_address]] Compare m_cmp{};
+};
+} // namespace dsalgo
@@ -0,0 +1,94 @@
+// dsalgo/src/pagerank.hpp
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+#include "spmv.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+struct PageRankOptions
+{
+    double damping = 0.85;
+    // Stop once the L1 change of the rank vector in one iteration drops below this.
+    double tolerance = 1e-6;
+    u32 max_iterations = 100;
+};
+
+// Ranks sum to 1. With Rank = float the rank and contribution vectors take
+// half the memory traffic; sums used for convergence are still taken in double.
+template <std::floating_point Rank>
+struct PageRankResult
+{
+    std::vector<Rank> rank;
+    u32 iterations = 0;
+    double residual = 0.0;
+    bool converged = false;
+};
+
+// Pull-based power iteration: each vertex sums the contributions of its
+// in-neighbours through spmv over `in`, so no two threads write the same
+// rank. Dangling vertices (no out-edges) spread their rank uniformly.
+template <std::floating_point Rank = double>
+[[nodiscard]] PageRankResult<Rank> pagerank(const CsrAdjacency& out, const CsrAdjacency& in,
+                                           PageRankOptions options = {})
+{
+    const usize n = out.vertex_count();
+    PageRankResult<Rank> r;
+    if (n == 0)
+    {
+        r.converged = true;
+        return r;
+    }
+
+    const double inv_n = 1.0 / static_cast<double>(n);
+    r.rank.assign(n, static_cast<Rank>(inv_n));
+    std::vector<Rank> contrib(n);
+    std::vector<Rank> next(n);
+
+    std::vector<Rank> inv_degree(n);
+    parallel_for(0, n, [&](usize v) {
+        const usize d = out.degree(static_cast<VertexId>(v));
+        inv_degree[v] = d == 0 ? Rank{0} : Rank{1} / static_cast<Rank>(d);
+    });
+
+    while (r.iterations < options.max_iterations)
+    {
+        const double dangling = parallel_sum<double>(0, n, [&](usize v) {
+            contrib[v] = r.rank[v] * inv_degree[v];
+            return out.degree(static_cast<VertexId>(v)) == 0 ? static_cast<double>(r.rank[v]) : 0.0;
+        });
+
+        spmv<Rank>(in, contrib, next, EdgeValues::Ones);
+
+        const auto base = static_cast<Rank>((1.0 - options.damping) * inv_n + options.damping * dangling * inv_n);
+        const auto d = static_cast<Rank>(options.damping);
+        r.residual = parallel_sum<double>(0, n, [&](usize v) {
+            next[v] = base + d * next[v];
+            return std::abs(static_cast<double>(next[v]) - static_cast<double>(r.rank[v]));
+        });
+
+        std::swap(r.rank, next);
+        ++r.iterations;
+        if (r.residual < options.tolerance)
+        {
+            r.converged = true;
+            break;
+        }
+    }
+    return r;
+}
+
+template <std::floating_point Rank = double, typename T>
+[[nodiscard]] PageRankResult<Rank> pagerank(const CsrGraph<T>& g, PageRankOptions options = {})
+{
+    return pagerank<Rank>(g.adjacency(), g.in_adjacency(), options);
+}
+} // namespace dsalgo
@@ -0,0 +1,242 @@
+// dsalgo/src/parallel.hpp
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "hardware.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// Fork-join pool: run() hands out task indices to the workers and the calling
+// thread, and returns once every task has finished. Workers are started once
+// and parked on a condition variable between jobs, so per-call overhead is a
+// wake-up rather than a thread spawn. A run() issued from inside a task
+// executes inline, which keeps nested parallel loops from deadlocking.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(usize thread_count = hardware_threads())
+    {
+        thread_count = std::max<usize>(1, thread_count);
+        m_workers.reserve(thread_count - 1);
+        for (usize id = 1; id < thread_count; ++id)
+        {
+            m_workers.emplace_back([this, id](std::stop_token st) { worker_loop(st, id); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Workers plus the thread that calls run(); worker ids are 0 .. thread_count() - 1.
+    [[nodiscard]] usize thread_count() const noexcept { return m_workers.size() + 1; }
+
+    [[nodiscard]] static usize hardware_threads() noexcept
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Calls f(task, worker) for every task in [0, task_count). The first
+    // exception thrown by a task is rethrown here once all workers are idle.
+    template <typename F>
+    void run(usize task_count, F&& f)
+    {
+        if (task_count == 0) return;
+        if (m_workers.empty() || task_count == 1 || tl_pool == this)
+        {
+            const usize worker = (tl_pool == this) ? tl_worker : 0;
+            for (usize t = 0; t < task_count; ++t) f(t, worker);
+            return;
+        }
+
+        using Fn = std::remove_reference_t<F>;
+        Job job{static_cast<void*>(std::addressof(f)),
+                [](void* ctx, usize task, usize worker) { (*static_cast<Fn*>(ctx))(task, worker); }, task_count};
+
+        std::lock_guard submit(m_submit_mutex);
+        {
+            std::lock_guard lk(m_mutex);
+            m_job = &job;
+            m_active = m_workers.size();
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        execute(job, 0);
+
+        std::unique_lock lk(m_mutex);
+        m_done.wait(lk, [this] { return m_active == 0; });
+        m_job = nullptr;
+        lk.unlock();
+
+        if (job.error) std::rethrow_exception(job.error);
+    }
+
+private:
+    struct Job
+    {
+        Job(void* ctx_, void (*call_)(void*, usize, usize), usize task_count_) noexcept
+            : ctx(ctx_), call(call_), task_count(task_count_)
+        {
+        }
+
+        void* ctx;
+        void (*call)(void*, usize, usize);
+        usize task_count;
+        std::atomic<usize> next{0};
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+
+    void execute(Job& job, usize worker) noexcept
+    {
+        ThreadPool* const prev_pool = tl_pool;
+        const usize prev_worker = tl_worker;
+        tl_pool = this;
+        tl_worker = worker;
+
+        for (usize t = job.next.fetch_add(1, std::memory_order_relaxed); t < job.task_count;
+             t = job.next.fetch_add(1, std::memory_order_relaxed))
+        {
+            try
+            {
+                job.call(job.ctx, t, worker);
+            }
+            catch (...)
+            {
+                std::lock_guard lk(job.error_mutex);
+                if (!job.error) job.error = std::current_exception();
+                job.next.store(job.task_count, std::memory_order_relaxed);
+            }
+        }
+
+        tl_pool = prev_pool;
+        tl_worker = prev_worker;
+    }
+
+    void worker_loop(std::stop_token st, usize id)
+    {
+        u64 seen = 0;
+        while (true)
+        {
+            Job* job = nullptr;
+            {
+                std::unique_lock lk(m_mutex);
+                if (!m_wake.wait(lk, st, [&] { return m_generation != seen; })) return;
+                seen = m_generation;
+                job = m_job;
+            }
+
+            execute(*job, id);
+
+            std::lock_guard lk(m_mutex);
+            if (--m_active == 0) m_done.notify_one();
+        }
+    }
+
+    static inline thread_local ThreadPool* tl_pool = nullptr;
+    static inline thread_local usize tl_worker = 0;
+
+    std::mutex m_submit_mutex;
+    std::mutex m_mutex;
+    std::condition_variable_any m_wake;
+    std::condition_variable m_done;
+    Job* m_job = nullptr;
+    usize m_active = 0;
+    u64 m_generation = 0;
+    // Declared last: the jthreads stop and join before the state they wait on is torn down.
+    std::vector<std::jthread> m_workers;
+};
+
+// Process-wide pool sized to the hardware, created on first use.
+inline ThreadPool& default_thread_pool()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+// Splits [begin, end) into chunks of `grain` and calls f(lo, hi, worker) for each chunk.
+template <typename F>
+void parallel_for_range(usize begin, usize end, usize grain, F&& f)
+{
+    if (end <= begin) return;
+    grain = std::max<usize>(1, grain);
+    const usize tasks = (end - begin + grain - 1) / grain;
+    default_thread_pool().run(tasks, [&](usize task, usize worker) {
+        const usize lo = begin + task * grain;
+        f(lo, std::min(end, lo + grain), worker);
+    });
+}
+
+// Calls f(i) for every i in [begin, end).
+template <typename F>
+void parallel_for(usize begin, usize end, F&& f, usize grain = 1024)
+{
+    parallel_for_range(begin, end, grain, [&](usize lo, usize hi, usize) {
+        for (usize i = lo; i < hi; ++i) f(i);
+    });
+}
+
+// Sum of f(i) over [begin, end). Each worker accumulates into its own
+// cache-line padded slot; the slots are added up on the calling thread.
+template <typename T, typename F>
+[[nodiscard]] T parallel_sum(usize begin, usize end, F&& f, usize grain = 1024)
+{
+    struct alignas(cache_line_bytes) Slot
+    {
+        T value{};
+    };
+    std::vector<Slot> slots(default_thread_pool().thread_count());
+    parallel_for_range(begin, end, grain, [&](usize lo, usize hi, usize worker) {
+        T acc{};
+        for (usize i = lo; i < hi; ++i) acc += f(i);
+        slots[worker].value += acc;
+    });
+
+    T total{};
+    for (const Slot& s : slots) total += s.value;
+    return total;
+}
+
+// Sorts each of up to 2 * thread_count() runs in parallel, then merges
+// neighbouring runs pairwise, halving the run count every round.
+template <std::random_access_iterator It, typename Compare = std::ranges::less>
+void parallel_sort(It first, It last, Compare cmp = {})
+{
+    const auto n = static_cast<usize>(last - first);
+    const usize runs = std::min<usize>(2 * default_thread_pool().thread_count(), std::max<usize>(1, n / 4096));
+    if (runs <= 1)
+    {
+        std::sort(first, last, cmp);
+        return;
+    }
+
+    std::vector<usize> bounds(runs + 1);
+    for (usize r = 0; r <= runs; ++r) bounds[r] = n * r / runs;
+    const auto at = [&](usize i) { return first + static_cast<std::iter_difference_t<It>>(i); };
+
+    default_thread_pool().run(runs, [&](usize r, usize) { std::sort(at(bounds[r]), at(bounds[r + 1]), cmp); });
+    for (usize width = 1; width < runs; width *= 2)
+    {
+        const usize pairs = (runs + 2 * width - 1) / (2 * width);
+        default_thread_pool().run(pairs, [&](usize p, usize) {
+            const usize lo = 2 * width * p;
+            const usize mid = std::min(runs, lo + width);
+            const usize hi = std::min(runs, lo + 2 * width);
+            if (mid < hi) std::inplace_merge(at(bounds[lo]), at(bounds[mid]), at(bounds[hi]), cmp);
+        });
+    }
+}
+} // namespace dsalgo
@@ -0,0 +1,202 @@
+// dsalgo/src/reorder.hpp
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// Dense relabeling: new vertex i was old vertex new_to_old[i], and
+// old_to_new is its inverse.
+struct Permutation
+{
+    std::vector<VertexId> new_to_old;
+    std::vector<VertexId> old_to_new;
+
+    [[nodiscard]] static Permutation from_order(std::vector<VertexId> new_to_old)
+    {
+        Permutation p;
+        p.old_to_new.resize(new_to_old.size());
+        for (usize i = 0; i < new_to_old.size(); ++i) p.old_to_new[new_to_old[i]] = static_cast<VertexId>(i);
+        p.new_to_old = std::move(new_to_old);
+        return p;
+    }
+
+    [[nodiscard]] usize size() const noexcept { return new_to_old.size(); }
+};
+
+// Highest out-degree first, ties in id order. Packs the hubs, which most
+// traversals touch, into the first few cache lines of every per-vertex array.
+[[nodiscard]] inline Permutation degree_order(const CsrAdjacency& g)
+{
+    std::vector<VertexId> order(g.vertex_count());
+    std::iota(order.begin(), order.end(), VertexId{0});
+    std::ranges::stable_sort(order, std::ranges::greater{}, [&](VertexId v) { return g.degree(v); });
+    return Permutation::from_order(std::move(order));
+}
+
+// Vertices in the order a BFS from `root` discovers them, then the BFS of
+// every remaining component in id order. Neighbours end up close to each
+// other, so the frontier of a later traversal walks memory mostly forwards.
+[[nodiscard]] inline Permutation bfs_order(const CsrAdjacency& g, VertexId root = 0)
+{
+    const usize n = g.vertex_count();
+    std::vector<VertexId> order;
+    order.reserve(n);
+    std::vector<bool> seen(n, false);
+
+    const auto sweep = [&](VertexId s) {
+        usize head = order.size();
+        order.push_back(s);
+        seen[s] = true;
+        for (; head < order.size(); ++head)
+        {
+            for (VertexId v : g.neighbors(order[head]))
+            {
+                if (seen[v]) continue;
+                seen[v] = true;
+                order.push_back(v);
+            }
+        }
+    };
+
+    if (root < n) sweep(root);
+    for (usize v = 0; v < n; ++v)
+    {
+        if (!seen[v]) sweep(static_cast<VertexId>(v));
+    }
+    return Permutation::from_order(std::move(order));
+}
+
+// Reverse Cuthill-McKee on the symmetrized graph (`in` is the transpose of
+// `out`). Each component is swept breadth-first from a minimum-degree vertex,
+// visiting neighbours by increasing degree, and the final order is reversed.
+// This keeps the bandwidth of the adjacency matrix small, i.e. the ids of
+// adjacent vertices close together.
+[[nodiscard]] inline Permutation rcm_order(const CsrAdjacency& out, const CsrAdjacency& in)
+{
+    const usize n = out.vertex_count();
+    const auto degree = [&](VertexId v) { return out.degree(v) + in.degree(v); };
+
+    std::vector<VertexId> by_degree(n);
+    std::iota(by_degree.begin(), by_degree.end(), VertexId{0});
+    std::ranges::stable_sort(by_degree, {}, degree);
+
+    std::vector<VertexId> order;
+    order.reserve(n);
+    std::vector<bool> seen(n, false);
+    std::vector<VertexId> fresh;
+
+    for (VertexId start : by_degree)
+    {
+        if (seen[start]) continue;
+        usize head = order.size();
+        order.push_back(start);
+        seen[start] = true;
+        for (; head < order.size(); ++head)
+        {
+            const VertexId u = order[head];
+            fresh.clear();
+            for (const CsrAdjacency* adj : {&out, &in})
+            {
+                for (VertexId v : adj->neighbors(u))
+                {
+                    if (seen[v]) continue;
+                    seen[v] = true;
+                    fresh.push_back(v);
+                }
+            }
+            std::ranges::sort(fresh, {}, [&](VertexId v) { return std::pair{degree(v), v}; });
+            order.insert(order.end(), fresh.begin(), fresh.end());
+        }
+    }
+    std::ranges::reverse(order);
+    return Permutation::from_order(std::move(order));
+}
+
+// The adjacency with every vertex renamed through `p`. Neighbour lists are
+// re-sorted (weights travel with their edges), one vertex per task.
+[[nodiscard]] inline CsrAdjacency permute(const CsrAdjacency& g, const Permutation& p)
+{
+    const usize n = g.vertex_count();
+    CsrAdjacency r;
+    r.offsets.assign(n + 1, 0);
+    for (usize i = 0; i < n; ++i) r.offsets[i + 1] = r.offsets[i] + g.degree(p.new_to_old[i]);
+    r.edges.resize(g.edge_count());
+    if (g.weighted()) r.weights.resize(g.edge_count());
+
+    parallel_for_range(0, n, 256, [&](usize lo, usize hi, usize) {
+        std::vector<std::pair<VertexId, EdgeWeight>> scratch;
+        for (usize i = lo; i < hi; ++i)
+        {
+            const VertexId old = p.new_to_old[i];
+            const u64 src = g.offsets[old];
+            const u64 dst = r.offsets[i];
+            const usize d = g.degree(old);
+
+            if (!g.weighted())
+            {
+                for (usize k = 0; k < d; ++k) r.edges[dst + k] = p.old_to_new[g.edges[src + k]];
+                std::sort(r.edges.begin() + static_cast<isize>(dst), r.edges.begin() + static_cast<isize>(dst + d));
+                continue;
+            }
+
+            scratch.clear();
+            for (usize k = 0; k < d; ++k) scratch.emplace_back(p.old_to_new[g.edges[src + k]], g.weights[src + k]);
+            std::ranges::sort(scratch);
+            for (usize k = 0; k < d; ++k) std::tie(r.edges[dst + k], r.weights[dst + k]) = scratch[k];
+        }
+    });
+    return r;
+}
+
+// Same graph, new dense ids: external ids and values move with their vertex.
+template <typename T>
+[[nodiscard]] CsrGraph<T> permute(const CsrGraph<T>& g, const Permutation& p)
+{
+    std::vector<GraphIndex> ids(g.vertex_count());
+    std::vector<T> values;
+    values.reserve(g.vertex_count());
+    for (usize i = 0; i < g.vertex_count(); ++i)
+    {
+        ids[i] = g.external_id(p.new_to_old[i]);
+        values.push_back(g.value(p.new_to_old[i]));
+    }
+    return CsrGraph<T>::relabeled(std::move(ids), std::move(values), permute(g.adjacency(), p));
+}
+
+enum class VertexOrder
+{
+    Degree,
+    ReverseCuthillMcKee,
+    Bfs,
+};
+
+template <typename T>
+struct Reordered
+{
+    CsrGraph<T> graph;
+    Permutation permutation;
+};
+
+template <typename T>
+[[nodiscard]] Reordered<T> reorder(const CsrGraph<T>& g, VertexOrder order)
+{
+    Permutation p;
+    switch (order)
+    {
+        case VertexOrder::Degree: p = degree_order(g.adjacency()); break;
+        case VertexOrder::ReverseCuthillMcKee: p = rcm_order(g.adjacency(), g.in_adjacency()); break;
+        case VertexOrder::Bfs: p = bfs_order(g.adjacency()); break;
+    }
+    CsrGraph<T> permuted = permute(g, p);
+    return Reordered<T>{std::move(permuted), std::move(p)};
+}
+} // namespace dsalgo
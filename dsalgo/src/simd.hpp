@@ -0,0 +1,308 @@
+// dsalgo/src/simd.hpp
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "types.hpp"
+
+namespace dsalgo
+{
+// The register-level vector type the GEMM micro-kernel and the SoA kernels
+// are written against: AVX-512, AVX2 + FMA, AArch64 NEON, SSE2 (baseline
+// x86-64, no FMA), or a plain array the compiler is free to vectorize on
+// anything else. What min/max return for NaN inputs differs by backend.
+// gather reads base[idx[l]] into lane l; indices must fit in an i32.
+// gather_prefix does the same for lanes [0, live) only and zeroes the rest
+// without touching base for them.
+template <typename T>
+struct Simd;
+
+namespace detail
+{
+// Lane-by-lane fallbacks for backends without a native gather / reduction.
+template <typename S, typename T>
+typename S::Reg gather_lanes(const T* base, const u32* idx) noexcept
+{
+    alignas(64) T v[S::lanes];
+    for (usize l = 0; l < S::lanes; ++l) v[l] = base[idx[l]];
+    return S::load(v);
+}
+
+template <typename S, typename T>
+typename S::Reg gather_prefix_lanes(const T* base, const u32* idx, usize live) noexcept
+{
+    alignas(64) T v[S::lanes];
+    for (usize l = 0; l < S::lanes; ++l) v[l] = l < live ? base[idx[l]] : T{0};
+    return S::load(v);
+}
+
+template <typename S, typename T>
+T sum_lanes(typename S::Reg r) noexcept
+{
+    alignas(64) T v[S::lanes];
+    S::store(v, r);
+    T total{0};
+    for (usize l = 0; l < S::lanes; ++l) total += v[l];
+    return total;
+}
+} // namespace detail
+
+#if defined(__AVX512F__)
+// min/max/sqrt/gather go through the masked forms with every lane selected:
+// the unmasked ones (and _mm512_reduce_add_*) trip a false
+// -Wmaybe-uninitialized in GCC 12's headers. Same for the AVX2 gathers.
+template <>
+struct Simd<f32>
+{
+    using Reg = __m512;
+    static constexpr __mmask16 all = 0xFFFF;
+    static constexpr usize lanes = 16;
+    static Reg zero() noexcept { return _mm512_setzero_ps(); }
+    static Reg broadcast(f32 x) noexcept { return _mm512_set1_ps(x); }
+    static Reg load(const f32* p) noexcept { return _mm512_loadu_ps(p); }
+    static void store(f32* p, Reg r) noexcept { _mm512_storeu_ps(p, r); }
+    static Reg fma(Reg a, Reg b, Reg c) noexcept { return _mm512_fmadd_ps(a, b, c); }
+    static Reg add(Reg a, Reg b) noexcept { return _mm512_add_ps(a, b); }
+    static Reg sub(Reg a, Reg b) noexcept { return _mm512_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) noexcept { return _mm512_mul_ps(a, b); }
+    static Reg div(Reg a, Reg b) noexcept { return _mm512_div_ps(a, b); }
+    static Reg min(Reg a, Reg b) noexcept { return _mm512_mask_min_ps(a, all, a, b); }
+    static Reg max(Reg a, Reg b) noexcept { return _mm512_mask_max_ps(a, all, a, b); }
+    static Reg sqrt(Reg a) noexcept { return _mm512_mask_sqrt_ps(a, all, a); }
+    static Reg gather(const f32* base, const u32* idx) noexcept { return _mm512_mask_i32gather_ps(zero(), all, _mm512_loadu_si512(idx), base, 4); }
+    static Reg gather_prefix(const f32* base, const u32* idx, usize live) noexcept { return _mm512_mask_i32gather_ps(zero(), static_cast<__mmask16>((u32{1} << live) - 1), _mm512_loadu_si512(idx), base, 4); }
+    static f32 sum(Reg r) noexcept { return detail::sum_lanes<Simd, f32>(r); }
+};
+template <>
+struct Simd<f64>
+{
+    using Reg = __m512d;
+    static constexpr __mmask8 all = 0xFF;
+    static constexpr usize lanes = 8;
+    static Reg zero() noexcept { return _mm512_setzero_pd(); }
+    static Reg broadcast(f64 x) noexcept { return _mm512_set1_pd(x); }
+    static Reg load(const f64* p) noexcept { return _mm512_loadu_pd(p); }
+    static void store(f64* p, Reg r) noexcept { _mm512_storeu_pd(p, r); }
+    static Reg fma(Reg a, Reg b, Reg c) noexcept { return _mm512_fmadd_pd(a, b, c); }
+    static Reg add(Reg a, Reg b) noexcept { return _mm512_add_pd(a, b); }
+    static Reg sub(Reg a, Reg b) noexcept { return _mm512_sub_pd(a, b); }
+    static Reg mul(Reg a, Reg b) noexcept { return _mm512_mul_pd(a, b); }
+    static Reg div(Reg a, Reg b) noexcept { return _mm512_div_pd(a, b); }
+    static Reg min(Reg a, Reg b) noexcept { return _mm512_mask_min_pd(a, all, a, b); }
+    static Reg max(Reg a, Reg b) noexcept { return _mm512_mask_max_pd(a, all, a, b); }
+    static Reg sqrt(Reg a) noexcept { return _mm512_mask_sqrt_pd(a, all, a); }
+    static Reg gather(const f64* base, const u32* idx) noexcept { return _mm512_mask_i32gather_pd(zero(), all, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), base, 8); }
+    static Reg gather_prefix(const f64* base, const u32* idx, usize live) noexcept { return _mm512_mask_i32gather_pd(zero(), static_cast<__mmask8>((u32{1} << live) - 1), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), base, 8); }
+    static f64 sum(Reg r) noexcept { return detail::sum_lanes<Simd, f64>(r); }
+};
+#elif defined(__AVX2__) && defined(__FMA__)
+template <>
+struct Simd<f32>
+{
+    using Reg = __m256;
+    static constexpr usize lanes = 8;
+    static Reg zero() noexcept { return _mm256_setzero_ps(); }
+    static Reg broadcast(f32 x) noexcept { return _mm256_set1_ps(x); }
+    static Reg load(const f32* p) noexcept { return _mm256_loadu_ps(p); }
+    static void store(f32* p, Reg r) noexcept { _mm256_storeu_ps(p, r); }
+    static Reg fma(Reg a, Reg b, Reg c) noexcept { return _mm256_fmadd_ps(a, b, c); }
+    static Reg add(Reg a, Reg b) noexcept { return _mm256_add_ps(a, b); }
+    static Reg sub(Reg a, Reg b) noexcept { return _mm256_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) noexcept { return _mm256_mul_ps(a, b); }
+    static Reg div(Reg a, Reg b) noexcept { return _mm256_div_ps(a, b); }
+    static Reg min(Reg a, Reg b) noexcept { return _mm256_min_ps(a, b); }
+    static Reg max(Reg a, Reg b) noexcept { return _mm256_max_ps(a, b); }
+    static Reg sqrt(Reg a) noexcept { return _mm256_sqrt_ps(a); }
+    static Reg gather(const f32* base, const u32* idx) noexcept { return _mm256_mask_i32gather_ps(zero(), base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4); }
+    static Reg gather_prefix(const f32* base, const u32* idx, usize live) noexcept
+    {
+        const __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(live)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        return _mm256_mask_i32gather_ps(zero(), base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), _mm256_castsi256_ps(mask), 4);
+    }
+    static f32 sum(Reg r) noexcept { return detail::sum_lanes<Simd, f32>(r); }
+};
+template <>
+struct Simd<f64>
+{
+    using Reg = __m256d;
+    static constexpr usize lanes = 4;
+    static Reg zero() noexcept { return _mm256_setzero_pd(); }
+    static Reg broadcast(f64 x) noexcept { return _mm256_set1_pd(x); }
+    static Reg load(const f64* p) noexcept { return _mm256_loadu_pd(p); }
+    static void store(f64* p, Reg r) noexcept { _mm256_storeu_pd(p, r); }
+    static Reg fma(Reg a, Reg b, Reg c) noexcept { return _mm256_fmadd_pd(a, b, c); }
+    static Reg add(Reg a, Reg b) noexcept { return _mm256_add_pd(a, b); }
+    static Reg sub(Reg a, Reg b) noexcept { return _mm256_sub_pd(a, b); }
+    static Reg mul(Reg a, Reg b) noexcept { return _mm256_mul_pd(a, b); }
+    static Reg div(Reg a, Reg b) noexcept { return _mm256_div_pd(a, b); }
+    static Reg min(Reg a, Reg b) noexcept { return _mm256_min_pd(a, b); }
+    static Reg max(Reg a, Reg b) noexcept { return _mm256_max_pd(a, b); }
+    static Reg sqrt(Reg a) noexcept { return _mm256_sqrt_pd(a); }
+    static Reg gather(const f64* base, const u32* idx) noexcept { return _mm256_mask_i32gather_pd(zero(), base, _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx)), _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8); }
+    static Reg gather_prefix(const f64* base, const u32* idx, usize live) noexcept
+    {
+        const __m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(live)), _mm256_setr_epi64x(0, 1, 2, 3));
+        return _mm256_mask_i32gather_pd(zero(), base, _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx)), _mm256_castsi256_pd(mask), 8);
+    }
+    static f64 sum(Reg r) noexcept { return detail::sum_lanes<Simd, f64>(r); }
+};
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+template <>
+struct Simd<f32>
+{
+    using Reg = float32x4_t;
+    static constexpr usize lanes = 4;
+    static Reg zero() noexcept { return vdupq_n_f32(0.0f); }
+    static Reg broadcast(f32 x) noexcept { return vdupq_n_f32(x); }
+    static Reg load(const f32* p) noexcept { return vld1q_f32(p); }
+    static void store(f32* p, Reg r) noexcept { vst1q_f32(p, r); }
+    static Reg fma(Reg a, Reg b, Reg c) noexcept { return vfmaq_f32(c, a, b); }
+    static Reg add(Reg a, Reg b) noexcept { return vaddq_f32(a, b); }
+    static Reg sub(Reg a, Reg b) noexcept { return vsubq_f32(a, b); }
+    static Reg mul(Reg a, Reg b) noexcept { return vmulq_f32(a, b); }
+    static Reg div(Reg a, Reg b) noexcept { return vdivq_f32(a, b); }
+    static Reg min(Reg a, Reg b) noexcept { return vminq_f32(a, b); }
+    static Reg max(Reg a, Reg b) noexcept { return vmaxq_f32(a, b); }
+    static Reg sqrt(Reg a) noexcept { return vsqrtq_f32(a); }
+    static Reg gather(const f32* base, const u32* idx) noexcept { return detail::gather_lanes<Simd, f32>(base, idx); }
+    static Reg gather_prefix(const f32* base, const u32* idx, usize live) noexcept { return detail::gather_prefix_lanes<Simd, f32>(base, idx, live); }
+    static f32 sum(Reg r) noexcept { return detail::sum_lanes<Simd, f32>(r); }
+};
+template <>
+struct Simd<f64>
+{
+    using Reg = float64x2_t;
+    static constexpr usize lanes = 2;
+    static Reg zero() noexcept { return vdupq_n_f64(0.0); }
+    static Reg broadcast(f64 x) noexcept { return vdupq_n_f64(x); }
+    static Reg load(const f64* p) noexcept { return vld1q_f64(p); }
+    static void store(f64* p, Reg r) noexcept { vst1q_f64(p, r); }
+    static Reg fma(Reg a, Reg b, Reg c) noexcept { return vfmaq_f64(c, a, b); }
+    static Reg add(Reg a, Reg b) noexcept { return vaddq_f64(a, b); }
+    static Reg sub(Reg a, Reg b) noexcept { return vsubq_f64(a, b); }
+    static Reg mul(Reg a, Reg b) noexcept { return vmulq_f64(a, b); }
+    static Reg div(Reg a, Reg b) noexcept { return vdivq_f64(a, b); }
+    static Reg min(Reg a, Reg b) noexcept { return vminq_f64(a, b); }
+    static Reg max(Reg a, Reg b) noexcept { return vmaxq_f64(a, b); }
+    static Reg sqrt(Reg a) noexcept { return vsqrtq_f64(a); }
+    static Reg gather(const f64* base, const u32* idx) noexcept { return detail::gather_lanes<Simd, f64>(base, idx); }
+    static Reg gather_prefix(const f64* base, const u32* idx, usize live) noexcept { return detail::gather_prefix_lanes<Simd, f64>(base, idx, live); }
+    static f64 sum(Reg r) noexcept { return detail::sum_lanes<Simd, f64>(r); }
+};
+#elif defined(__SSE2__)
+template <>
+struct Simd<f32>
+{
+    using Reg = __m128;
+    static constexpr usize lanes = 4;
+    static Reg zero() noexcept { return _mm_setzero_ps(); }
+    static Reg broadcast(f32 x) noexcept { return _mm_set1_ps(x); }
+    static Reg load(const f32* p) noexcept { return _mm_loadu_ps(p); }
+    static void store(f32* p, Reg r) noexcept { _mm_storeu_ps(p, r); }
+    static Reg fma(Reg a, Reg b, Reg c) noexcept { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static Reg add(Reg a, Reg b) noexcept { return _mm_add_ps(a, b); }
+    static Reg sub(Reg a, Reg b) noexcept { return _mm_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) noexcept { return _mm_mul_ps(a, b); }
+    static Reg div(Reg a, Reg b) noexcept { return _mm_div_ps(a, b); }
+    static Reg min(Reg a, Reg b) noexcept { return _mm_min_ps(a, b); }
+    static Reg max(Reg a, Reg b) noexcept { return _mm_max_ps(a, b); }
+    static Reg sqrt(Reg a) noexcept { return _mm_sqrt_ps(a); }
+    static Reg gather(const f32* base, const u32* idx) noexcept { return detail::gather_lanes<Simd, f32>(base, idx); }
+    static Reg gather_prefix(const f32* base, const u32* idx, usize live) noexcept { return detail::gather_prefix_lanes<Simd, f32>(base, idx, live); }
+    static f32 sum(Reg r) noexcept { return detail::sum_lanes<Simd, f32>(r); }
+};
+template <>
+struct Simd<f64>
+{
+    using Reg = __m128d;
+    static constexpr usize lanes = 2;
+    static Reg zero() noexcept { return _mm_setzero_pd(); }
+    static Reg broadcast(f64 x) noexcept { return _mm_set1_pd(x); }
+    static Reg load(const f64* p) noexcept { return _mm_loadu_pd(p); }
+    static void store(f64* p, Reg r) noexcept { _mm_storeu_pd(p, r); }
+    static Reg fma(Reg a, Reg b, Reg c) noexcept { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+    static Reg add(Reg a, Reg b) noexcept { return _mm_add_pd(a, b); }
+    static Reg sub(Reg a, Reg b) noexcept { return _mm_sub_pd(a, b); }
+    static Reg mul(Reg a, Reg b) noexcept { return _mm_mul_pd(a, b); }
+    static Reg div(Reg a, Reg b) noexcept { return _mm_div_pd(a, b); }
+    static Reg min(Reg a, Reg b) noexcept { return _mm_min_pd(a, b); }
+    static Reg max(Reg a, Reg b) noexcept { return _mm_max_pd(a, b); }
+    static Reg sqrt(Reg a) noexcept { return _mm_sqrt_pd(a); }
+    static Reg gather(const f64* base, const u32* idx) noexcept { return detail::gather_lanes<Simd, f64>(base, idx); }
+    static Reg gather_prefix(const f64* base, const u32* idx, usize live) noexcept { return detail::gather_prefix_lanes<Simd, f64>(base, idx, live); }
+    static f64 sum(Reg r) noexcept { return detail::sum_lanes<Simd, f64>(r); }
+};
+#endif
+
+// Portable fallback: four lanes in a plain array.
+template <std::floating_point T>
+struct Simd<T>
+{
+    struct Reg
+    {
+        T v[4];
+    };
+    static constexpr usize lanes = 4;
+    static Reg zero() noexcept { return {}; }
+    static Reg broadcast(T x) noexcept { return {{x, x, x, x}}; }
+    static Reg load(const T* p) noexcept { return {{p[0], p[1], p[2], p[3]}}; }
+    static void store(T* p, Reg r) noexcept { std::copy_n(r.v, 4, p); }
+    static Reg fma(Reg a, Reg b, Reg c) noexcept
+    {
+        for (usize i = 0; i < 4; ++i) c.v[i] += a.v[i] * b.v[i];
+        return c;
+    }
+    static Reg add(Reg a, Reg b) noexcept { return apply(a, b, [](T x, T y) { return x + y; }); }
+    static Reg sub(Reg a, Reg b) noexcept { return apply(a, b, [](T x, T y) { return x - y; }); }
+    static Reg mul(Reg a, Reg b) noexcept { return apply(a, b, [](T x, T y) { return x * y; }); }
+    static Reg div(Reg a, Reg b) noexcept { return apply(a, b, [](T x, T y) { return x / y; }); }
+    static Reg min(Reg a, Reg b) noexcept { return apply(a, b, [](T x, T y) { return y < x ? y : x; }); }
+    static Reg max(Reg a, Reg b) noexcept { return apply(a, b, [](T x, T y) { return x < y ? y : x; }); }
+    static Reg sqrt(Reg a) noexcept { return apply(a, a, [](T x, T) { return std::sqrt(x); }); }
+    static Reg gather(const T* base, const u32* idx) noexcept { return detail::gather_lanes<Simd, T>(base, idx); }
+    static Reg gather_prefix(const T* base, const u32* idx, usize live) noexcept { return detail::gather_prefix_lanes<Simd, T>(base, idx, live); }
+    static T sum(Reg r) noexcept { return r.v[0] + r.v[1] + r.v[2] + r.v[3]; }
+
+private:
+    template <typename F>
+    static Reg apply(Reg a, Reg b, F f) noexcept
+    {
+        for (usize i = 0; i < 4; ++i) a.v[i] = f(a.v[i], b.v[i]);
+        return a;
+    }
+};
+
+// The same interface one element at a time, so a kernel written against
+// Simd<T> can finish the tail of its range with SimdScalar<T>.
+template <std::floating_point T>
+struct SimdScalar
+{
+    using Reg = T;
+    static constexpr usize lanes = 1;
+    static Reg zero() noexcept { return T{0}; }
+    static Reg broadcast(T x) noexcept { return x; }
+    static Reg load(const T* p) noexcept { return *p; }
+    static void store(T* p, Reg r) noexcept { *p = r; }
+    static Reg fma(Reg a, Reg b, Reg c) noexcept { return a * b + c; }
+    static Reg add(Reg a, Reg b) noexcept { return a + b; }
+    static Reg sub(Reg a, Reg b) noexcept { return a - b; }
+    static Reg mul(Reg a, Reg b) noexcept { return a * b; }
+    static Reg div(Reg a, Reg b) noexcept { return a / b; }
+    static Reg min(Reg a, Reg b) noexcept { return b < a ? b : a; }
+    static Reg max(Reg a, Reg b) noexcept { return a < b ? b : a; }
+    static Reg sqrt(Reg a) noexcept { return std::sqrt(a); }
+    static Reg gather(const T* base, const u32* idx) noexcept { return base[*idx]; }
+    static Reg gather_prefix(const T* base, const u32* idx, usize live) noexcept { return live > 0 ? base[*idx] : T{0}; }
+    static T sum(Reg r) noexcept { return r; }
+};
+} // namespace dsalgo
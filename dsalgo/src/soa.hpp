@@ -0,0 +1,355 @@
+// dsalgo/src/soa.hpp
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "hardware.hpp"
+#include "matrix.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// Dim-component vectors stored structure-of-arrays: one contiguous,
+// cache-line aligned array per component. The kernels below load Simd<T>
+// lanes of x, of y, of z, ... and so process that many points per
+// instruction, instead of spreading one point over a register the way glm's
+// Vec3f / Vec4f math does.
+template <std::floating_point T, usize Dim>
+    requires(Dim == 3 || Dim == 4)
+class VecSoA
+{
+public:
+    using value_type = T;
+    using Vec = glm::vec<static_cast<glm::length_t>(Dim), T>;
+    static constexpr usize dim = Dim;
+
+    VecSoA() = default;
+    explicit VecSoA(usize n) { resize(n); }
+    explicit VecSoA(std::span<const Vec> points)
+    {
+        resize(points.size());
+        for (usize i = 0; i < points.size(); ++i) set(i, points[i]);
+    }
+
+    [[nodiscard]] usize size() const noexcept { return m_lanes[0].size(); }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    void resize(usize n)
+    {
+        for (auto& lane : m_lanes) lane.resize(n);
+    }
+    void reserve(usize n)
+    {
+        for (auto& lane : m_lanes) lane.reserve(n);
+    }
+    void clear() noexcept
+    {
+        for (auto& lane : m_lanes) lane.clear();
+    }
+
+    void push_back(const Vec& v)
+    {
+        m_lanes[0].push_back(v.x);
+        m_lanes[1].push_back(v.y);
+        m_lanes[2].push_back(v.z);
+        if constexpr (Dim == 4) m_lanes[3].push_back(v.w);
+    }
+
+    [[nodiscard]] Vec get(usize i) const noexcept
+    {
+        if constexpr (Dim == 3) return Vec{m_lanes[0][i], m_lanes[1][i], m_lanes[2][i]};
+        else return Vec{m_lanes[0][i], m_lanes[1][i], m_lanes[2][i], m_lanes[3][i]};
+    }
+
+    void set(usize i, const Vec& v) noexcept
+    {
+        m_lanes[0][i] = v.x;
+        m_lanes[1][i] = v.y;
+        m_lanes[2][i] = v.z;
+        if constexpr (Dim == 4) m_lanes[3][i] = v.w;
+    }
+
+    [[nodiscard]] std::vector<Vec> to_aos() const
+    {
+        std::vector<Vec> out(size());
+        for (usize i = 0; i < size(); ++i) out[i] = get(i);
+        return out;
+    }
+
+    // Component d of every vector.
+    [[nodiscard]] std::span<T> lane(usize d) noexcept { return m_lanes[d]; }
+    [[nodiscard]] std::span<const T> lane(usize d) const noexcept { return m_lanes[d]; }
+
+    [[nodiscard]] std::span<T> x() noexcept { return m_lanes[0]; }
+    [[nodiscard]] std::span<T> y() noexcept { return m_lanes[1]; }
+    [[nodiscard]] std::span<T> z() noexcept { return m_lanes[2]; }
+    [[nodiscard]] std::span<const T> x() const noexcept { return m_lanes[0]; }
+    [[nodiscard]] std::span<const T> y() const noexcept { return m_lanes[1]; }
+    [[nodiscard]] std::span<const T> z() const noexcept { return m_lanes[2]; }
+    [[nodiscard]] std::span<T> w() noexcept
+        requires(Dim == 4)
+    {
+        return m_lanes[3];
+    }
+    [[nodiscard]] std::span<const T> w() const noexcept
+        requires(Dim == 4)
+    {
+        return m_lanes[3];
+    }
+
+private:
+    std::array<std::vector<T, AlignedAllocator<T>>, Dim> m_lanes;
+};
+
+using Vec3fSoA = VecSoA<f32, 3>;
+using Vec3dSoA = VecSoA<f64, 3>;
+using Vec4fSoA = VecSoA<f32, 4>;
+using Vec4dSoA = VecSoA<f64, 4>;
+
+// Axis-aligned bounding box. The box of no points has min = +inf and
+// max = -inf in every component.
+template <std::floating_point T, usize Dim>
+struct Aabb
+{
+    std::array<T, Dim> min;
+    std::array<T, Dim> max;
+
+    [[nodiscard]] bool empty() const noexcept { return max[0] < min[0]; }
+};
+
+namespace detail
+{
+// Points per parallel task; a multiple of every Simd width.
+inline constexpr usize soa_grain = usize{1} << 14;
+
+// Runs body.template operator()<S>(i) over [0, n) in parallel: S = Simd<T>
+// for full vectors of points starting at i, SimdScalar<T> for the tail.
+// Each task works on its own copy of the body, so with everything captured
+// by value the pointers and coefficients stay in registers instead of being
+// reloaded around every store.
+template <std::floating_point T, typename Body>
+void soa_for_each(usize n, const Body& body)
+{
+    parallel_for_range(0, n, soa_grain, [&](usize lo, usize hi, usize) {
+        const Body kernel = body;
+        usize i = lo;
+        for (; i + Simd<T>::lanes <= hi; i += Simd<T>::lanes) kernel.template operator()<Simd<T>>(i);
+        for (; i < hi; ++i) kernel.template operator()<SimdScalar<T>>(i);
+    });
+}
+} // namespace detail
+
+// The kernels spell out their per-component steps instead of looping over
+// them: GCC at -O2 leaves even three-iteration loops rolled, which costs more
+// than the arithmetic here.
+
+// out[i] = (m * (in[i], 1)).xyz, i.e. m applied to points as an affine
+// transform; the bottom row of m is ignored. `out` may be `in`.
+template <std::floating_point T>
+void transform_points(const SmallMatrix<T, 4, 4>& m, const VecSoA<T, 3>& in, VecSoA<T, 3>& out)
+{
+    out.resize(in.size());
+    const T* px = in.x().data();
+    const T* py = in.y().data();
+    const T* pz = in.z().data();
+    T* ox = out.x().data();
+    T* oy = out.y().data();
+    T* oz = out.z().data();
+    detail::soa_for_each<T>(in.size(), [=]<typename S>(usize i) {
+        const auto x = S::load(px + i);
+        const auto y = S::load(py + i);
+        const auto z = S::load(pz + i);
+        const auto row = [&](usize r) {
+            const auto acc = S::fma(S::broadcast(m(r, 2)), z, S::broadcast(m(r, 3)));
+            return S::fma(S::broadcast(m(r, 0)), x, S::fma(S::broadcast(m(r, 1)), y, acc));
+        };
+        const auto rx = row(0);
+        const auto ry = row(1);
+        const auto rz = row(2);
+        S::store(ox + i, rx);
+        S::store(oy + i, ry);
+        S::store(oz + i, rz);
+    });
+}
+
+// out[i] = m * in[i] for homogeneous vectors. `out` may be `in`.
+template <std::floating_point T>
+void transform(const SmallMatrix<T, 4, 4>& m, const VecSoA<T, 4>& in, VecSoA<T, 4>& out)
+{
+    out.resize(in.size());
+    const T* px = in.x().data();
+    const T* py = in.y().data();
+    const T* pz = in.z().data();
+    const T* pw = in.w().data();
+    T* ox = out.x().data();
+    T* oy = out.y().data();
+    T* oz = out.z().data();
+    T* ow = out.w().data();
+    detail::soa_for_each<T>(in.size(), [=]<typename S>(usize i) {
+        const auto x = S::load(px + i);
+        const auto y = S::load(py + i);
+        const auto z = S::load(pz + i);
+        const auto w = S::load(pw + i);
+        const auto row = [&](usize r) {
+            const auto acc = S::fma(S::broadcast(m(r, 2)), z, S::mul(S::broadcast(m(r, 3)), w));
+            return S::fma(S::broadcast(m(r, 0)), x, S::fma(S::broadcast(m(r, 1)), y, acc));
+        };
+        const auto rx = row(0);
+        const auto ry = row(1);
+        const auto rz = row(2);
+        const auto rw = row(3);
+        S::store(ox + i, rx);
+        S::store(oy + i, ry);
+        S::store(oz + i, rz);
+        S::store(ow + i, rw);
+    });
+}
+
+namespace detail
+{
+// Sum over components of a[d] * b[d], for the Simd-like S.
+template <typename S, std::floating_point T, usize Dim>
+auto soa_dot(const std::array<const T*, Dim>& a, const std::array<const T*, Dim>& b, usize i)
+{
+    auto acc = S::fma(S::load(a[2] + i), S::load(b[2] + i), S::mul(S::load(a[1] + i), S::load(b[1] + i)));
+    if constexpr (Dim == 4) acc = S::fma(S::load(a[3] + i), S::load(b[3] + i), acc);
+    return S::fma(S::load(a[0] + i), S::load(b[0] + i), acc);
+}
+
+template <std::floating_point T, usize Dim>
+std::array<const T*, Dim> lane_pointers(const VecSoA<T, Dim>& v) noexcept
+{
+    std::array<const T*, Dim> p;
+    for (usize d = 0; d < Dim; ++d) p[d] = v.lane(d).data();
+    return p;
+}
+} // namespace detail
+
+// out[i] = dot(a[i], b[i]). `out` is a caller's span and cannot be resized,
+// so it must already hold a.size() values.
+template <std::floating_point T, usize Dim>
+void dot(const VecSoA<T, Dim>& a, const VecSoA<T, Dim>& b, std::span<T> out)
+{
+    if (a.size() != b.size()) throw std::invalid_argument("dot: vector counts differ");
+    if (out.size() != a.size()) throw std::invalid_argument("dot: output size differs");
+    const auto pa = detail::lane_pointers(a);
+    const auto pb = detail::lane_pointers(b);
+    T* o = out.data();
+    detail::soa_for_each<T>(a.size(), [=]<typename S>(usize i) { S::store(o + i, detail::soa_dot<S>(pa, pb, i)); });
+}
+
+// out[i] = cross(a[i], b[i]). `out` may be `a` or `b`.
+template <std::floating_point T>
+void cross(const VecSoA<T, 3>& a, const VecSoA<T, 3>& b, VecSoA<T, 3>& out)
+{
+    if (a.size() != b.size()) throw std::invalid_argument("cross: vector counts differ");
+    out.resize(a.size());
+    const auto pa = detail::lane_pointers(a);
+    const auto pb = detail::lane_pointers(b);
+    T* ox = out.x().data();
+    T* oy = out.y().data();
+    T* oz = out.z().data();
+    detail::soa_for_each<T>(a.size(), [=]<typename S>(usize i) {
+        const auto ux = S::load(pa[0] + i);
+        const auto uy = S::load(pa[1] + i);
+        const auto uz = S::load(pa[2] + i);
+        const auto vx = S::load(pb[0] + i);
+        const auto vy = S::load(pb[1] + i);
+        const auto vz = S::load(pb[2] + i);
+        S::store(ox + i, S::sub(S::mul(uy, vz), S::mul(uz, vy)));
+        S::store(oy + i, S::sub(S::mul(uz, vx), S::mul(ux, vz)));
+        S::store(oz + i, S::sub(S::mul(ux, vy), S::mul(uy, vx)));
+    });
+}
+
+// Scales every vector to unit length. Zero vectors stay zero: the squared
+// length is clamped to the smallest normal T before the reciprocal root, so
+// there is no branch and no NaN.
+template <std::floating_point T, usize Dim>
+void normalize(VecSoA<T, Dim>& v)
+{
+    const auto p = detail::lane_pointers(std::as_const(v));
+    std::array<T*, Dim> out;
+    for (usize d = 0; d < Dim; ++d) out[d] = v.lane(d).data();
+    detail::soa_for_each<T>(v.size(), [=]<typename S>(usize i) {
+        const auto len2 = S::max(detail::soa_dot<S>(p, p, i), S::broadcast(std::numeric_limits<T>::min()));
+        const auto inv = S::div(S::broadcast(T{1}), S::sqrt(len2));
+        S::store(out[0] + i, S::mul(S::load(p[0] + i), inv));
+        S::store(out[1] + i, S::mul(S::load(p[1] + i), inv));
+        S::store(out[2] + i, S::mul(S::load(p[2] + i), inv));
+        if constexpr (Dim == 4) S::store(out[3] + i, S::mul(S::load(p[3] + i), inv));
+    });
+}
+
+// Bounding box of all vectors: per-lane running min/max within a task, one
+// padded partial per worker, combined at the end.
+template <std::floating_point T, usize Dim>
+[[nodiscard]] Aabb<T, Dim> bounds(const VecSoA<T, Dim>& v)
+{
+    using S = Simd<T>;
+    constexpr T inf = std::numeric_limits<T>::infinity();
+    struct alignas(cache_line_bytes) Slot
+    {
+        Aabb<T, Dim> box;
+    };
+    Aabb<T, Dim> empty;
+    empty.min.fill(inf);
+    empty.max.fill(-inf);
+    std::vector<Slot> slots(default_thread_pool().thread_count(), Slot{empty});
+
+    parallel_for_range(0, v.size(), detail::soa_grain, [&](usize lo, usize hi, usize worker) {
+        Aabb<T, Dim>& box = slots[worker].box;
+        for (usize d = 0; d < Dim; ++d)
+        {
+            const T* p = v.lane(d).data();
+            auto lo_reg = S::broadcast(inf);
+            auto hi_reg = S::broadcast(-inf);
+            usize i = lo;
+            for (; i + S::lanes <= hi; i += S::lanes)
+            {
+                const auto x = S::load(p + i);
+                lo_reg = S::min(lo_reg, x);
+                hi_reg = S::max(hi_reg, x);
+            }
+            alignas(cache_line_bytes) T lanes_lo[S::lanes];
+            alignas(cache_line_bytes) T lanes_hi[S::lanes];
+            S::store(lanes_lo, lo_reg);
+            S::store(lanes_hi, hi_reg);
+            T mn = box.min[d];
+            T mx = box.max[d];
+            for (usize l = 0; l < S::lanes; ++l)
+            {
+                mn = std::min(mn, lanes_lo[l]);
+                mx = std::max(mx, lanes_hi[l]);
+            }
+            for (; i < hi; ++i)
+            {
+                mn = std::min(mn, p[i]);
+                mx = std::max(mx, p[i]);
+            }
+            box.min[d] = mn;
+            box.max[d] = mx;
+        }
+    });
+
+    Aabb<T, Dim> total = empty;
+    for (const Slot& s : slots)
+    {
+        for (usize d = 0; d < Dim; ++d)
+        {
+            total.min[d] = std::min(total.min[d], s.box.min[d]);
+            total.max[d] = std::max(total.max[d], s.box.max[d]);
+        }
+    }
+    return total;
+}
+} // namespace dsalgo
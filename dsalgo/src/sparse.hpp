@@ -0,0 +1,455 @@
+// dsalgo/src/sparse.hpp
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <expected>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "graph.hpp"
+#include "hardware.hpp"
+#include "matrix.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+#include "spmv.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// Row / column index of a stored entry. The SIMD kernels gather through
+// these as i32, so dimensions must stay below 2^31.
+using SparseIndex = u32;
+inline constexpr usize max_sparse_dimension = usize{1} << 31;
+
+// Coordinate list: the easy format to build, in any order and with repeats
+// (which add up on conversion to CSR).
+template <std::floating_point T>
+struct CooMatrix
+{
+    usize rows = 0;
+    usize cols = 0;
+    std::vector<SparseIndex> row_indices;
+    std::vector<SparseIndex> col_indices;
+    std::vector<T> values;
+
+    CooMatrix() = default;
+    CooMatrix(usize row_count, usize col_count) : rows(row_count), cols(col_count)
+    {
+        if (rows > max_sparse_dimension || cols > max_sparse_dimension)
+        {
+            throw std::length_error("CooMatrix: dimensions must be below 2^31");
+        }
+    }
+
+    [[nodiscard]] usize nnz() const noexcept { return values.size(); }
+
+    void add(SparseIndex row, SparseIndex col, T value)
+    {
+        if (row >= rows || col >= cols) throw std::out_of_range("CooMatrix: entry outside the matrix");
+        row_indices.push_back(row);
+        col_indices.push_back(col);
+        values.push_back(value);
+    }
+};
+
+// Compressed sparse row: row i holds columns indices[offsets[i] ..
+// offsets[i + 1]) (sorted, no repeats) with matching values. Same layout as
+// CsrAdjacency, plus values.
+template <std::floating_point T>
+struct CsrMatrix
+{
+    usize rows = 0;
+    usize cols = 0;
+    std::vector<u64> offsets{0};
+    std::vector<SparseIndex> indices;
+    std::vector<T> values;
+
+    [[nodiscard]] usize nnz() const noexcept { return values.size(); }
+
+    [[nodiscard]] std::span<const SparseIndex> row_indices(usize i) const noexcept
+    {
+        return {indices.data() + offsets[i], indices.data() + offsets[i + 1]};
+    }
+    [[nodiscard]] std::span<const T> row_values(usize i) const noexcept
+    {
+        return {values.data() + offsets[i], values.data() + offsets[i + 1]};
+    }
+
+    // Counting sort by column; rows are visited in order, so the transposed
+    // rows come out sorted as well.
+    [[nodiscard]] CsrMatrix transposed() const
+    {
+        CsrMatrix t;
+        t.rows = cols;
+        t.cols = rows;
+        t.offsets.assign(cols + 1, 0);
+        t.indices.resize(nnz());
+        t.values.resize(nnz());
+        for (SparseIndex c : indices) ++t.offsets[c + 1];
+        for (usize c = 0; c < cols; ++c) t.offsets[c + 1] += t.offsets[c];
+
+        std::vector<u64> cursor(t.offsets.begin(), t.offsets.end() - 1);
+        for (usize r = 0; r < rows; ++r)
+        {
+            for (u64 e = offsets[r]; e < offsets[r + 1]; ++e)
+            {
+                const u64 slot = cursor[indices[e]]++;
+                t.indices[slot] = static_cast<SparseIndex>(r);
+                t.values[slot] = values[e];
+            }
+        }
+        return t;
+    }
+
+    [[nodiscard]] DynMatrix<T> to_dense() const
+    {
+        DynMatrix<T> d(rows, cols);
+        for (usize r = 0; r < rows; ++r)
+        {
+            for (u64 e = offsets[r]; e < offsets[r + 1]; ++e) d(r, indices[e]) = values[e];
+        }
+        return d;
+    }
+};
+
+// Compressed sparse column: column j holds rows indices[offsets[j] ..
+// offsets[j + 1]). The arrays are exactly those of the transpose's CSR.
+template <std::floating_point T>
+struct CscMatrix
+{
+    usize rows = 0;
+    usize cols = 0;
+    std::vector<u64> offsets{0};
+    std::vector<SparseIndex> indices;
+    std::vector<T> values;
+
+    [[nodiscard]] usize nnz() const noexcept { return values.size(); }
+
+    [[nodiscard]] std::span<const SparseIndex> col_indices(usize j) const noexcept
+    {
+        return {indices.data() + offsets[j], indices.data() + offsets[j + 1]};
+    }
+    [[nodiscard]] std::span<const T> col_values(usize j) const noexcept
+    {
+        return {values.data() + offsets[j], values.data() + offsets[j + 1]};
+    }
+};
+
+// Sorts by (row, column) and sums repeated entries.
+template <std::floating_point T>
+[[nodiscard]] CsrMatrix<T> to_csr(const CooMatrix<T>& coo)
+{
+    // Ties keep insertion order, so repeats are summed deterministically.
+    std::vector<std::pair<u64, u64>> order(coo.nnz());
+    parallel_for(0, coo.nnz(), [&](usize i) {
+        order[i] = {(u64{coo.row_indices[i]} << 32) | coo.col_indices[i], i};
+    });
+    parallel_sort(order.begin(), order.end());
+
+    CsrMatrix<T> csr;
+    csr.rows = coo.rows;
+    csr.cols = coo.cols;
+    csr.offsets.assign(coo.rows + 1, 0);
+    csr.indices.reserve(coo.nnz());
+    csr.values.reserve(coo.nnz());
+    u64 prev = std::numeric_limits<u64>::max();
+    for (const auto& [key, i] : order)
+    {
+        if (key == prev)
+        {
+            csr.values.back() += coo.values[i];
+            continue;
+        }
+        prev = key;
+        ++csr.offsets[(key >> 32) + 1];
+        csr.indices.push_back(static_cast<SparseIndex>(key));
+        csr.values.push_back(coo.values[i]);
+    }
+    for (usize r = 0; r < coo.rows; ++r) csr.offsets[r + 1] += csr.offsets[r];
+    return csr;
+}
+
+template <std::floating_point T>
+[[nodiscard]] CscMatrix<T> to_csc(const CsrMatrix<T>& csr)
+{
+    CsrMatrix<T> t = csr.transposed();
+    return CscMatrix<T>{csr.rows, csr.cols, std::move(t.offsets), std::move(t.indices), std::move(t.values)};
+}
+
+template <std::floating_point T>
+[[nodiscard]] CsrMatrix<T> to_csr(const CscMatrix<T>& csc)
+{
+    const CsrMatrix<T> as_transpose{csc.cols, csc.rows, csc.offsets, csc.indices, csc.values};
+    return as_transpose.transposed();
+}
+
+template <std::floating_point T>
+[[nodiscard]] CooMatrix<T> to_coo(const CsrMatrix<T>& csr)
+{
+    CooMatrix<T> coo{csr.rows, csr.cols};
+    coo.row_indices.resize(csr.nnz());
+    for (usize r = 0; r < csr.rows; ++r)
+    {
+        std::fill(coo.row_indices.begin() + static_cast<isize>(csr.offsets[r]),
+                  coo.row_indices.begin() + static_cast<isize>(csr.offsets[r + 1]), static_cast<SparseIndex>(r));
+    }
+    coo.col_indices = csr.indices;
+    coo.values = csr.values;
+    return coo;
+}
+
+// The n x n adjacency matrix, A(u, v) = weight of u -> v (or 1, see
+// EdgeValues). Rows are sorted here, since CsrAdjacency does not promise it.
+template <std::floating_point T>
+[[nodiscard]] CsrMatrix<T> to_csr(const CsrAdjacency& adj, EdgeValues values = EdgeValues::Weights)
+{
+    const usize n = adj.vertex_count();
+    if (n > max_sparse_dimension) throw std::length_error("to_csr: too many vertices");
+    const bool weighted = values == EdgeValues::Weights && adj.weighted();
+
+    CsrMatrix<T> m;
+    m.rows = m.cols = n;
+    m.offsets = adj.offsets;
+    m.indices = adj.edges;
+    m.values.resize(adj.edge_count());
+    parallel_for_range(0, n, 1024, [&](usize lo, usize hi, usize) {
+        std::vector<std::pair<SparseIndex, T>> row;
+        for (usize v = lo; v < hi; ++v)
+        {
+            const u64 begin = adj.offsets[v];
+            const u64 end = adj.offsets[v + 1];
+            for (u64 e = begin; e < end; ++e) m.values[e] = weighted ? static_cast<T>(adj.weights[e]) : T{1};
+            const auto first = m.indices.begin() + static_cast<isize>(begin);
+            const auto last = m.indices.begin() + static_cast<isize>(end);
+            if (std::is_sorted(first, last)) continue;
+
+            row.clear();
+            for (u64 e = begin; e < end; ++e) row.emplace_back(m.indices[e], m.values[e]);
+            std::ranges::sort(row, {}, &std::pair<SparseIndex, T>::first);
+            for (u64 e = begin; e < end; ++e) std::tie(m.indices[e], m.values[e]) = row[e - begin];
+        }
+    });
+    return m;
+}
+
+// Rows and columns follow the graph's dense vertex ids.
+template <std::floating_point T, typename V>
+[[nodiscard]] CsrMatrix<T> to_csr(const CsrGraph<V>& g, EdgeValues values = EdgeValues::Weights)
+{
+    return to_csr<T>(g.adjacency(), values);
+}
+
+// Row / column i is the node with the i-th smallest GraphIndex, as in
+// freeze(); freeze the graph yourself to keep the mapping around.
+template <std::floating_point T, typename V>
+[[nodiscard]] std::expected<CsrMatrix<T>, typename Graph<V>::FreezeError> to_csr(const Graph<V>& g,
+                                                                                EdgeValues values = EdgeValues::Weights)
+{
+    auto frozen = g.freeze();
+    if (!frozen) return std::unexpected(frozen.error());
+    return to_csr<T>(frozen->adjacency(), values);
+}
+
+// y = A x.
+template <std::floating_point T>
+void spmv(const CsrMatrix<T>& a, std::type_identity_t<std::span<const T>> x, std::type_identity_t<std::span<T>> y)
+{
+    assert(x.size() == a.cols && y.size() == a.rows);
+    detail::compressed_gather<T>(a.offsets, a.indices.data(), a.values.data(), x.data(), y.data());
+}
+
+// y = A^T x. Column j of A is contiguous in CSC, so this is the same
+// gather as CSR's A x; for A x on a CSC matrix convert with to_csr.
+template <std::floating_point T>
+void spmv_transposed(const CscMatrix<T>& a, std::type_identity_t<std::span<const T>> x,
+                     std::type_identity_t<std::span<T>> y)
+{
+    assert(x.size() == a.rows && y.size() == a.cols);
+    detail::compressed_gather<T>(a.offsets, a.indices.data(), a.values.data(), x.data(), y.data());
+}
+
+namespace detail
+{
+// Q registers' worth of columns [c, c + Q * lanes) of one output row, kept
+// in registers across all of the row's entries.
+template <typename S, usize Q, std::floating_point T>
+void spmm_row_block(const CsrMatrix<T>& a, usize r, const T* x, usize ldx, T* y, usize c)
+{
+    typename S::Reg acc[Q];
+    for (auto& reg : acc) reg = S::zero();
+    for (u64 e = a.offsets[r]; e < a.offsets[r + 1]; ++e)
+    {
+        const auto v = S::broadcast(a.values[e]);
+        const T* xr = x + usize{a.indices[e]} * ldx + c;
+        for (usize q = 0; q < Q; ++q) acc[q] = S::fma(v, S::load(xr + q * S::lanes), acc[q]);
+    }
+    for (usize q = 0; q < Q; ++q) S::store(y + c + q * S::lanes, acc[q]);
+}
+} // namespace detail
+
+// Y = A X for a dense, row-major X (a.cols x k, row stride ldx) into Y
+// (a.rows x k, row stride ldy). Each output row is built from the rows of X
+// its entries select, vectorized along k.
+template <std::floating_point T>
+void spmm(const CsrMatrix<T>& a, const T* x, usize k, usize ldx, T* y, usize ldy)
+{
+    using S = Simd<T>;
+    constexpr usize wide = 4 * S::lanes;
+    const std::vector<usize> bounds = detail::nnz_balanced_rows(a.offsets);
+    default_thread_pool().run(bounds.size() - 1, [&](usize task, usize) {
+        for (usize r = bounds[task]; r < bounds[task + 1]; ++r)
+        {
+            T* yr = y + r * ldy;
+            usize c = 0;
+            for (; c + wide <= k; c += wide) detail::spmm_row_block<S, 4>(a, r, x, ldx, yr, c);
+            for (; c + S::lanes <= k; c += S::lanes) detail::spmm_row_block<S, 1>(a, r, x, ldx, yr, c);
+            for (; c < k; ++c) detail::spmm_row_block<SimdScalar<T>, 1>(a, r, x, ldx, yr, c);
+        }
+    });
+}
+
+template <std::floating_point T>
+[[nodiscard]] DynMatrix<T> spmm(const CsrMatrix<T>& a, const DynMatrix<T>& x)
+{
+    if (x.rows() != a.cols) throw std::invalid_argument("spmm: dimensions differ");
+    DynMatrix<T> y(a.rows, x.cols());
+    spmm(a, x.data(), x.cols(), x.stride(), y.data(), y.stride());
+    return y;
+}
+
+// SELL-C-sigma (Kreutzer et al., "A unified sparse matrix data format for
+// efficient general sparse matrix-vector multiplication on modern
+// processors with wide SIMD units"). Rows are grouped into chunks of C =
+// Simd<T>::lanes and each chunk is stored column-major, padded to its longest
+// row, so one SIMD step advances all C rows at once. Sorting rows by length
+// within windows of sigma rows first keeps the padding small while keeping
+// x accesses mostly local; sigma = C only orders the rows inside each chunk,
+// which leaves the padding as it was.
+template <std::floating_point T>
+struct SellMatrix
+{
+    static constexpr usize chunk = Simd<T>::lanes;
+
+    usize rows = 0;
+    usize cols = 0;
+    usize sigma = chunk;
+    usize nonzeros = 0;
+    // Chunk k's slab starts at chunk_offsets[k]; its entry (lane r, step j)
+    // is at chunk_offsets[k] + j * chunk + r. Padding has value 0, column 0.
+    std::vector<u64> chunk_offsets{0};
+    std::vector<SparseIndex> indices;
+    std::vector<T> values;
+    // Original row of lane r in chunk k is row_of[k * chunk + r]; lanes past
+    // the last row hold `rows`.
+    std::vector<SparseIndex> row_of;
+    // Real entries of each lane, parallel to row_of. Sorting keeps these
+    // non-increasing within a chunk, so the lanes still live at step j are
+    // a prefix of the chunk.
+    std::vector<SparseIndex> lane_length;
+
+    [[nodiscard]] usize nnz() const noexcept { return nonzeros; }
+    [[nodiscard]] usize chunk_count() const noexcept { return chunk_offsets.size() - 1; }
+
+    // Stored entries that are real, 1 meaning no padding at all.
+    [[nodiscard]] f64 fill_ratio() const noexcept
+    {
+        return values.empty() ? 1.0 : static_cast<f64>(nonzeros) / static_cast<f64>(values.size());
+    }
+
+    // sigma is rounded up to a multiple of the chunk size.
+    [[nodiscard]] static SellMatrix from_csr(const CsrMatrix<T>& a, usize sigma = 32 * chunk)
+    {
+        SellMatrix s;
+        s.rows = a.rows;
+        s.cols = a.cols;
+        s.sigma = std::max<usize>(chunk, (sigma + chunk - 1) / chunk * chunk);
+        s.nonzeros = a.nnz();
+
+        const usize chunks = (a.rows + chunk - 1) / chunk;
+        s.row_of.resize(chunks * chunk, static_cast<SparseIndex>(a.rows));
+        for (usize r = 0; r < a.rows; ++r) s.row_of[r] = static_cast<SparseIndex>(r);
+        const auto length = [&](SparseIndex r) { return a.offsets[r + 1] - a.offsets[r]; };
+        for (usize w = 0; w < a.rows; w += s.sigma)
+        {
+            const auto first = s.row_of.begin() + static_cast<isize>(w);
+            const auto last = s.row_of.begin() + static_cast<isize>(std::min(a.rows, w + s.sigma));
+            std::stable_sort(first, last, [&](SparseIndex l, SparseIndex r) { return length(l) > length(r); });
+        }
+
+        s.lane_length.resize(chunks * chunk);
+        for (usize i = 0; i < s.row_of.size(); ++i)
+        {
+            const SparseIndex r = s.row_of[i];
+            s.lane_length[i] = r < a.rows ? static_cast<SparseIndex>(length(r)) : 0;
+        }
+        s.chunk_offsets.resize(chunks + 1);
+        for (usize k = 0; k < chunks; ++k)
+        {
+            // Lane 0 holds the longest row of the chunk.
+            s.chunk_offsets[k + 1] = s.chunk_offsets[k] + u64{s.lane_length[k * chunk]} * chunk;
+        }
+
+        s.indices.assign(s.chunk_offsets.back(), 0);
+        s.values.assign(s.chunk_offsets.back(), T{0});
+        parallel_for(0, chunks, [&](usize k) {
+            for (usize l = 0; l < chunk; ++l)
+            {
+                const SparseIndex r = s.row_of[k * chunk + l];
+                if (r >= a.rows) continue;
+                for (u64 j = 0; j < length(r); ++j)
+                {
+                    s.indices[s.chunk_offsets[k] + j * chunk + l] = a.indices[a.offsets[r] + j];
+                    s.values[s.chunk_offsets[k] + j * chunk + l] = a.values[a.offsets[r] + j];
+                }
+            }
+        }, 64);
+        return s;
+    }
+};
+
+// y = A x, one SIMD register of rows per chunk. Once the shortest row of a
+// chunk runs out, the gather is masked to the live lanes, so padding never
+// multiplies an Inf or NaN in x into a row that does not touch it.
+template <std::floating_point T>
+void spmv(const SellMatrix<T>& a, std::type_identity_t<std::span<const T>> x, std::type_identity_t<std::span<T>> y)
+{
+    using S = Simd<T>;
+    constexpr usize c = SellMatrix<T>::chunk;
+    static_assert(c == S::lanes);
+    assert(x.size() == a.cols && y.size() == a.rows);
+    parallel_for_range(0, a.chunk_count(), 64, [&](usize lo, usize hi, usize) {
+        alignas(cache_line_bytes) T out[c];
+        for (usize k = lo; k < hi; ++k)
+        {
+            const SparseIndex* length = a.lane_length.data() + k * c;
+            const u64 begin = a.chunk_offsets[k];
+            const u64 full = begin + u64{length[c - 1]} * c;
+            auto acc = S::zero();
+            u64 e = begin;
+            for (; e < full; e += c)
+            {
+                acc = S::fma(S::load(a.values.data() + e), S::gather(x.data(), a.indices.data() + e), acc);
+            }
+            for (usize live = c; e < a.chunk_offsets[k + 1]; e += c)
+            {
+                const u64 step = (e - begin) / c;
+                while (length[live - 1] <= step) --live;
+                acc = S::fma(S::load(a.values.data() + e), S::gather_prefix(x.data(), a.indices.data() + e, live), acc);
+            }
+            S::store(out, acc);
+            for (usize l = 0; l < c; ++l)
+            {
+                const SparseIndex r = a.row_of[k * c + l];
+                if (r < a.rows) y[r] = out[l];
+            }
+        }
+    });
+}
+} // namespace dsalgo
@@ -0,0 +1,109 @@
+// dsalgo/src/spmv.hpp
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <span>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+enum class EdgeValues
+{
+    Weights, // A(i, j) is the edge weight (1 if the adjacency is unweighted)
+    Ones,    // A(i, j) is 1 for every edge, weights ignored
+};
+
+namespace detail
+{
+// Row blocks holding about the same number of entries each, so a few heavy
+// rows don't leave the other workers idle. Returns task_count + 1 bounds.
+inline std::vector<usize> nnz_balanced_rows(std::span<const u64> offsets)
+{
+    const usize rows = offsets.size() - 1;
+    const u64 nnz = offsets.back();
+    const usize tasks = std::clamp<usize>(static_cast<usize>(nnz / 16384), 1, 8 * default_thread_pool().thread_count());
+    std::vector<usize> bounds(tasks + 1, rows);
+    bounds[0] = 0;
+    for (usize t = 1; t < tasks; ++t)
+    {
+        const u64 target = nnz * t / tasks;
+        bounds[t] = static_cast<usize>(std::ranges::lower_bound(offsets, target) - offsets.begin());
+        bounds[t] = std::min(bounds[t], rows);
+    }
+    return bounds;
+}
+
+// y[r] = sum over the row's entries of values[e] * x[indices[e]], or of
+// x[indices[e]] alone if `values` is null: SIMD gathers over each row,
+// scalar for the rest. Values of another type than T (graph edge weights)
+// are converted a register at a time. Every CSR / CSC product goes here.
+template <std::floating_point T, typename V>
+void compressed_gather(std::span<const u64> offsets, const u32* indices, const V* values, const T* x, T* y)
+{
+    using S = Simd<T>;
+    const auto value = [values](u64 e) {
+        if constexpr (std::same_as<V, T>) return S::load(values + e);
+        else
+        {
+            alignas(64) T v[S::lanes];
+            for (usize l = 0; l < S::lanes; ++l) v[l] = static_cast<T>(values[e + l]);
+            return S::load(v);
+        }
+    };
+    const std::vector<usize> bounds = nnz_balanced_rows(offsets);
+    default_thread_pool().run(bounds.size() - 1, [&](usize task, usize) {
+        for (usize r = bounds[task]; r < bounds[task + 1]; ++r)
+        {
+            u64 e = offsets[r];
+            const u64 end = offsets[r + 1];
+            T sum{0};
+            if (end - e >= S::lanes)
+            {
+                auto acc = S::zero();
+                if (values == nullptr)
+                {
+                    for (; e + S::lanes <= end; e += S::lanes) acc = S::add(acc, S::gather(x, indices + e));
+                }
+                else
+                {
+                    for (; e + S::lanes <= end; e += S::lanes) acc = S::fma(value(e), S::gather(x, indices + e), acc);
+                }
+                sum = S::sum(acc);
+            }
+            if (values == nullptr)
+            {
+                for (; e < end; ++e) sum += x[indices[e]];
+            }
+            else
+            {
+                for (; e < end; ++e) sum += static_cast<T>(values[e]) * x[indices[e]];
+            }
+            y[r] = sum;
+        }
+    });
+}
+} // namespace detail
+
+// y = A x for the matrix whose row i holds the out-edges of vertex i, on the
+// same kernel as the CSR spmv in sparse.hpp. Rows are split across the
+// default thread pool by entry count and every y[i] is written by exactly
+// one worker. Run it on the transpose for a pull-style traversal, i.e.
+// y[v] = sum over in-neighbours u of x[u].
+template <std::floating_point Scalar>
+void spmv(const CsrAdjacency& a, std::span<const Scalar> x, std::span<Scalar> y,
+          EdgeValues values = EdgeValues::Weights)
+{
+    assert(x.size() == a.vertex_count() && y.size() == a.vertex_count());
+    // An unweighted adjacency has weight 1 everywhere, the same as Ones.
+    static_assert(default_edge_weight == 1);
+    const EdgeWeight* weights = values == EdgeValues::Weights && a.weighted() ? a.weights.data() : nullptr;
+    detail::compressed_gather<Scalar>(a.offsets, a.edges.data(), weights, x.data(), y.data());
+}
+} // namespace dsalgo
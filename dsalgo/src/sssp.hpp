@@ -0,0 +1,313 @@
+// dsalgo/src/sssp.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <expected>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "graph.hpp"
+#include "hardware.hpp"
+#include "parallel.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+using PathLength = u64;
+
+// Shortest path lengths and tree parents per dense vertex. The source is
+// its own parent; unreached vertices have distance `unreachable` and parent
+// `invalid_vertex`.
+struct SsspResult
+{
+    static constexpr PathLength unreachable = std::numeric_limits<PathLength>::max();
+
+    std::vector<PathLength> distance;
+    std::vector<VertexId> parent;
+
+    [[nodiscard]] bool reached(VertexId v) const noexcept { return distance[v] != unreachable; }
+};
+
+// Monotone priority queue: popped keys never decrease, so an entry only has
+// to live in the bucket of the highest bit in which it differs from the last
+// popped key. Each entry moves down at most 64 times over its lifetime.
+template <typename Value>
+class RadixHeap
+{
+public:
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] usize size() const noexcept { return m_size; }
+
+    // `key` must not be below the last popped key.
+    void push(u64 key, Value value)
+    {
+        assert(key >= m_last);
+        m_buckets[bucket_of(key)].emplace_back(key, std::move(value));
+        ++m_size;
+    }
+
+    std::pair<u64, Value> pop()
+    {
+        assert(!empty());
+        if (m_buckets[0].empty())
+        {
+            usize i = 1;
+            while (m_buckets[i].empty()) ++i;
+            auto& from = m_buckets[i];
+            m_last = std::ranges::min_element(from, {}, &std::pair<u64, Value>::first)->first;
+            for (auto& entry : from) m_buckets[bucket_of(entry.first)].push_back(std::move(entry));
+            from.clear();
+        }
+        std::pair<u64, Value> top = std::move(m_buckets[0].back());
+        m_buckets[0].pop_back();
+        --m_size;
+        return top;
+    }
+
+private:
+    [[nodiscard]] usize bucket_of(u64 key) const noexcept
+    {
+        return key == m_last ? 0 : static_cast<usize>(std::bit_width(key ^ m_last));
+    }
+
+    std::array<std::vector<std::pair<u64, Value>>, 65> m_buckets;
+    u64 m_last = 0;
+    usize m_size = 0;
+};
+
+// Serial Dijkstra on a radix heap with lazy deletion: a relaxed vertex is
+// pushed again instead of decreased, stale entries are skipped on pop.
+[[nodiscard]] inline SsspResult dijkstra(const CsrAdjacency& g, VertexId source)
+{
+    const usize n = g.vertex_count();
+    SsspResult r;
+    r.distance.assign(n, SsspResult::unreachable);
+    r.parent.assign(n, invalid_vertex);
+    if (source >= n) return r;
+
+    r.distance[source] = 0;
+    r.parent[source] = source;
+    RadixHeap<VertexId> heap;
+    heap.push(0, source);
+
+    while (!heap.empty())
+    {
+        const auto [d, u] = heap.pop();
+        if (d != r.distance[u]) continue;
+        for (u64 e = g.offsets[u]; e < g.offsets[u + 1]; ++e)
+        {
+            const VertexId v = g.edges[e];
+            const PathLength nd = d + g.weight(e);
+            if (nd < r.distance[v])
+            {
+                r.distance[v] = nd;
+                r.parent[v] = u;
+                heap.push(nd, v);
+            }
+        }
+    }
+    return r;
+}
+
+namespace detail
+{
+struct alignas(cache_line_bytes) DeltaWorker
+{
+    std::vector<std::vector<VertexId>> bins;
+};
+
+// Lowers distance[v] to `d` if smaller; true if this call did it.
+inline bool atomic_min(PathLength& slot, PathLength d) noexcept
+{
+    std::atomic_ref<PathLength> ref{slot};
+    PathLength cur = ref.load(std::memory_order_relaxed);
+    while (d < cur)
+    {
+        if (ref.compare_exchange_weak(cur, d, std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
+} // namespace detail
+
+// Parallel delta-stepping. Vertices are binned by floor(distance / delta);
+// the lowest non-empty bin is relaxed in parallel until it stays empty,
+// with each worker keeping private bins so only the distance CAS is shared.
+// Parents are assigned afterwards from the final distances. A delta around
+// the average edge weight times the average degree is a reasonable start.
+[[nodiscard]] inline SsspResult delta_stepping(const CsrAdjacency& g, VertexId source, PathLength delta)
+{
+    const usize n = g.vertex_count();
+    SsspResult r;
+    r.distance.assign(n, SsspResult::unreachable);
+    r.parent.assign(n, invalid_vertex);
+    if (source >= n) return r;
+
+    delta = std::max<PathLength>(1, delta);
+    r.distance[source] = 0;
+
+    std::vector<detail::DeltaWorker> workers(default_thread_pool().thread_count());
+    std::vector<VertexId> frontier{source};
+    usize bin = 0;
+
+    while (!frontier.empty())
+    {
+        parallel_for_range(0, frontier.size(), 64, [&](usize lo, usize hi, usize worker) {
+            auto& bins = workers[worker].bins;
+            for (usize i = lo; i < hi; ++i)
+            {
+                const VertexId u = frontier[i];
+                const PathLength du = std::atomic_ref<PathLength>{r.distance[u]}.load(std::memory_order_relaxed);
+                // Settled in an earlier bin or already handled at a lower distance.
+                if (du / delta < bin) continue;
+
+                for (u64 e = g.offsets[u]; e < g.offsets[u + 1]; ++e)
+                {
+                    const VertexId v = g.edges[e];
+                    const PathLength nd = du + g.weight(e);
+                    if (detail::atomic_min(r.distance[v], nd))
+                    {
+                        const usize b = static_cast<usize>(nd / delta);
+                        if (b >= bins.size()) bins.resize(b + 1);
+                        bins[b].push_back(v);
+                    }
+                }
+            }
+        });
+
+        // Next bin: the lowest one any worker has filled, possibly the current one again.
+        usize next = std::numeric_limits<usize>::max();
+        for (const auto& w : workers)
+        {
+            for (usize b = bin; b < std::min(next, w.bins.size()); ++b)
+            {
+                if (!w.bins[b].empty())
+                {
+                    next = b;
+                    break;
+                }
+            }
+        }
+
+        frontier.clear();
+        if (next == std::numeric_limits<usize>::max()) break;
+        bin = next;
+        for (auto& w : workers)
+        {
+            if (bin < w.bins.size())
+            {
+                frontier.insert(frontier.end(), w.bins[bin].begin(), w.bins[bin].end());
+                w.bins[bin].clear();
+            }
+        }
+    }
+
+    // Any u with distance[u] + w(u, v) == distance[v] is a valid shortest-path
+    // parent, but with zero-weight edges an arbitrary pick can close a cycle.
+    // Claiming parents level by level in a BFS from the source over such tight
+    // edges keeps every parent one level closer to the source.
+    r.parent[source] = source;
+    frontier.assign(1, source);
+    for (auto& w : workers) w.bins.assign(1, {});
+    while (!frontier.empty())
+    {
+        parallel_for_range(0, frontier.size(), 64, [&](usize lo, usize hi, usize worker) {
+            auto& next = workers[worker].bins[0];
+            for (usize i = lo; i < hi; ++i)
+            {
+                const VertexId u = frontier[i];
+                for (u64 e = g.offsets[u]; e < g.offsets[u + 1]; ++e)
+                {
+                    const VertexId v = g.edges[e];
+                    if (r.distance[u] + g.weight(e) != r.distance[v]) continue;
+                    std::atomic_ref<VertexId> slot{r.parent[v]};
+                    VertexId expected = invalid_vertex;
+                    if (slot.load(std::memory_order_relaxed) == invalid_vertex &&
+                        slot.compare_exchange_strong(expected, u, std::memory_order_relaxed))
+                    {
+                        next.push_back(v);
+                    }
+                }
+            }
+        });
+        frontier.clear();
+        for (auto& w : workers)
+        {
+            frontier.insert(frontier.end(), w.bins[0].begin(), w.bins[0].end());
+            w.bins[0].clear();
+        }
+    }
+    return r;
+}
+
+template <typename T>
+[[nodiscard]] SsspResult dijkstra(const CsrGraph<T>& g, VertexId source)
+{
+    return dijkstra(g.adjacency(), source);
+}
+
+template <typename T>
+[[nodiscard]] SsspResult delta_stepping(const CsrGraph<T>& g, VertexId source, PathLength delta)
+{
+    return delta_stepping(g.adjacency(), source, delta);
+}
+
+// SSSP on a mutable Graph: freezes it and keeps the snapshot so results can
+// be queried by GraphIndex.
+template <typename T>
+struct GraphSssp
+{
+    CsrGraph<T> graph;
+    SsspResult result;
+
+    [[nodiscard]] std::optional<PathLength> distance(GraphIndex idx) const noexcept
+    {
+        const auto v = graph.dense_id(idx);
+        if (!v || !result.reached(*v)) return std::nullopt;
+        return result.distance[*v];
+    }
+
+    [[nodiscard]] std::optional<GraphIndex> parent(GraphIndex idx) const noexcept
+    {
+        const auto v = graph.dense_id(idx);
+        if (!v || !result.reached(*v)) return std::nullopt;
+        return graph.external_id(result.parent[*v]);
+    }
+};
+
+enum class SsspError
+{
+    SourceMissing,
+    FreezeFailed,
+};
+
+template <typename T>
+[[nodiscard]] std::expected<GraphSssp<T>, SsspError> dijkstra(const Graph<T>& g, GraphIndex source)
+{
+    auto frozen = g.freeze();
+    if (!frozen) return std::unexpected(SsspError::FreezeFailed);
+    const auto src = frozen->dense_id(source);
+    if (!src) return std::unexpected(SsspError::SourceMissing);
+
+    SsspResult result = dijkstra(*frozen, *src);
+    return GraphSssp<T>{std::move(*frozen), std::move(result)};
+}
+
+template <typename T>
+[[nodiscard]] std::expected<GraphSssp<T>, SsspError> delta_stepping(const Graph<T>& g, GraphIndex source, PathLength delta)
+{
+    auto frozen = g.freeze();
+    if (!frozen) return std::unexpected(SsspError::FreezeFailed);
+    const auto src = frozen->dense_id(source);
+    if (!src) return std::unexpected(SsspError::SourceMissing);
+
+    SsspResult result = delta_stepping(*frozen, *src, delta);
+    return GraphSssp<T>{std::move(*frozen), std::move(result)};
+}
+} // namespace dsalgo
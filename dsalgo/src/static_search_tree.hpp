@@ -0,0 +1,123 @@
+// dsalgo/src/static_search_tree.hpp
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "hardware.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// Binary search whose only branch is the loop condition: the halving step is
+// a conditional move, so a lookup costs log2(n) dependent loads and no
+// mispredictions. Same contract as std::lower_bound.
+template <typename T>
+    requires std::totally_ordered<T>
+[[nodiscard]] const T* branchless_lower_bound(std::span<const T> xs, const T& x) noexcept
+{
+    const T* base = xs.data();
+    usize n = xs.size();
+    if (n == 0) return base;
+
+    while (n > 1)
+    {
+        const usize half = n / 2;
+        base = (base[half] < x) ? base + half : base;
+        n -= half;
+    }
+    return base + static_cast<usize>(*base < x);
+}
+
+// Read-only sorted set laid out in Eytzinger (BFS) order: node k has its
+// children at 2k and 2k+1. The top levels of every search share the first few
+// cache lines, and the descent index alone decides the next load, so the next
+// log2(per_line) levels (one cache line of descendants: four levels for 4-byte
+// keys, three for 8-byte ones) are prefetched while the current compare is in
+// flight.
+template <typename T>
+    requires(std::totally_ordered<T> && std::is_trivially_copyable_v<T>)
+class StaticSearchTree
+{
+public:
+    static constexpr usize npos = std::numeric_limits<usize>::max();
+
+    StaticSearchTree() = default;
+
+    // `sorted` must be non-decreasing.
+    explicit StaticSearchTree(std::span<const T> sorted)
+    {
+        if (!std::ranges::is_sorted(sorted)) throw std::invalid_argument("StaticSearchTree: input is not sorted");
+        if (sorted.size() >= std::numeric_limits<u32>::max()) throw std::length_error("StaticSearchTree: too many keys");
+
+        m_tree.resize(sorted.size() + 1);
+        m_rank.resize(sorted.size() + 1);
+        (void)build(sorted, 0, 1);
+    }
+
+    [[nodiscard]] usize size() const noexcept { return m_tree.empty() ? 0 : m_tree.size() - 1; }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    // Position (in sorted order) of the first element not less than x, or size() if none.
+    [[nodiscard]] usize lower_bound(const T& x) const noexcept
+    {
+        const usize k = search(x);
+        return k == 0 ? size() : m_rank[k];
+    }
+
+    [[nodiscard]] bool contains(const T& x) const noexcept
+    {
+        const usize k = search(x);
+        return k != 0 && !(x < m_tree[k]);
+    }
+
+    // Sorted position of x, or npos if it is not present.
+    [[nodiscard]] usize find(const T& x) const noexcept
+    {
+        const usize k = search(x);
+        return (k != 0 && !(x < m_tree[k])) ? m_rank[k] : npos;
+    }
+
+private:
+    // In-order walk of the implicit tree hands out the sorted elements in order; depth is log2(n).
+    usize build(std::span<const T> sorted, usize next, usize k)
+    {
+        if (k >= m_tree.size()) return next;
+        next = build(sorted, next, 2 * k);
+        m_tree[k] = sorted[next];
+        m_rank[k] = static_cast<u32>(next);
+        return build(sorted, next + 1, 2 * k + 1);
+    }
+
+    static constexpr usize per_line = std::max<usize>(1, cache_line_bytes / sizeof(T));
+
+    // Eytzinger index of the lower bound, 0 if every element is less than x.
+    usize search(const T& x) const noexcept
+    {
+        const usize n = size();
+        const T* base = m_tree.data();
+        usize k = 1;
+        while (k <= n)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            // Integer arithmetic: the prefetched slot may lie past the end of the array.
+            __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<std::uintptr_t>(base) + k * per_line * sizeof(T)));
+#endif
+            k = 2 * k + static_cast<usize>(base[k] < x);
+        }
+        // Undo the trailing right turns plus the final left turn.
+        return k >> (std::countr_one(k) + 1);
+    }
+
+    std::vector<T, AlignedAllocator<T>> m_tree;
+    std::vector<u32> m_rank;
+};
+} // namespace dsalgo
@@ -0,0 +1,170 @@
+// dsalgo/src/toposort.hpp
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <expected>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "graph.hpp"
+#include "hardware.hpp"
+#include "parallel.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// Kahn levels: order[level_offsets[k] .. level_offsets[k + 1]) holds the
+// vertices whose longest path from a source has k edges, so every vertex of a
+// level can run once the previous levels are done. If the graph is not a DAG
+// only the vertices outside cycles (and outside anything a cycle reaches) are
+// ordered, and `cycle` lists one directed cycle, each vertex having an edge
+// to the next and the last to the first.
+struct TopologicalOrder
+{
+    std::vector<VertexId> order;
+    std::vector<usize> level_offsets{0};
+    std::vector<VertexId> cycle;
+
+    [[nodiscard]] bool acyclic() const noexcept { return cycle.empty(); }
+    [[nodiscard]] usize level_count() const noexcept { return level_offsets.size() - 1; }
+    [[nodiscard]] std::span<const VertexId> level(usize k) const noexcept
+    {
+        return {order.data() + level_offsets[k], order.data() + level_offsets[k + 1]};
+    }
+};
+
+namespace detail
+{
+struct alignas(cache_line_bytes) KahnWorker
+{
+    std::vector<VertexId> ready;
+};
+
+// Some vertex left over by Kahn still has an unplaced in-neighbour, so walking
+// backwards through unplaced in-neighbours must eventually repeat a vertex.
+inline std::vector<VertexId> find_cycle(const CsrAdjacency& g, const std::vector<u32>& indegree)
+{
+    constexpr usize unseen = std::numeric_limits<usize>::max();
+    const CsrAdjacency in = g.transposed();
+    const auto start = std::ranges::find_if(indegree, [](u32 d) { return d != 0; });
+    std::vector<usize> seen_at(g.vertex_count(), unseen);
+    std::vector<VertexId> walk;
+
+    auto v = static_cast<VertexId>(start - indegree.begin());
+    while (seen_at[v] == unseen)
+    {
+        seen_at[v] = walk.size();
+        walk.push_back(v);
+        const auto preds = in.neighbors(v);
+        v = *std::ranges::find_if(preds, [&](VertexId u) { return indegree[u] != 0; });
+    }
+    // The walk followed edges backwards; flip it to edge direction.
+    std::vector<VertexId> cycle(walk.begin() + static_cast<isize>(seen_at[v]), walk.end());
+    std::ranges::reverse(cycle);
+    return cycle;
+}
+} // namespace detail
+
+// Kahn's algorithm one level at a time: the current level's out-edges are
+// relaxed in parallel with atomic in-degree decrements, and whoever takes a
+// vertex to zero queues it for the next level. Levels are sorted, so the
+// result does not depend on thread timing.
+[[nodiscard]] inline TopologicalOrder topological_sort(const CsrAdjacency& g)
+{
+    const usize n = g.vertex_count();
+    std::vector<u32> indegree(n, 0);
+    parallel_for_range(0, n, 256, [&](usize lo, usize hi, usize) {
+        for (usize u = lo; u < hi; ++u)
+        {
+            for (VertexId v : g.neighbors(static_cast<VertexId>(u)))
+            {
+                std::atomic_ref<u32>{indegree[v]}.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    TopologicalOrder r;
+    r.order.reserve(n);
+    for (usize v = 0; v < n; ++v)
+    {
+        if (indegree[v] == 0) r.order.push_back(static_cast<VertexId>(v));
+    }
+
+    std::vector<detail::KahnWorker> workers(default_thread_pool().thread_count());
+    while (r.order.size() > r.level_offsets.back())
+    {
+        const usize lo = r.level_offsets.back();
+        const usize hi = r.order.size();
+        r.level_offsets.push_back(hi);
+
+        parallel_for_range(lo, hi, 64, [&](usize a, usize b, usize worker) {
+            auto& ready = workers[worker].ready;
+            for (usize i = a; i < b; ++i)
+            {
+                for (VertexId v : g.neighbors(r.order[i]))
+                {
+                    if (std::atomic_ref<u32>{indegree[v]}.fetch_sub(1, std::memory_order_acq_rel) == 1) ready.push_back(v);
+                }
+            }
+        });
+        for (detail::KahnWorker& w : workers)
+        {
+            r.order.insert(r.order.end(), w.ready.begin(), w.ready.end());
+            w.ready.clear();
+        }
+        std::sort(r.order.begin() + static_cast<isize>(hi), r.order.end());
+    }
+
+    if (r.order.size() < n) r.cycle = detail::find_cycle(g, indegree);
+    return r;
+}
+
+template <typename T>
+[[nodiscard]] TopologicalOrder topological_sort(const CsrGraph<T>& g)
+{
+    return topological_sort(g.adjacency());
+}
+
+// Topological order of a mutable Graph, with the frozen snapshot kept so
+// positions and the cycle can be read back as GraphIndex values.
+template <typename T>
+struct GraphTopologicalOrder
+{
+    CsrGraph<T> graph;
+    TopologicalOrder result;
+
+    [[nodiscard]] std::vector<GraphIndex> order() const
+    {
+        std::vector<GraphIndex> ids;
+        ids.reserve(result.order.size());
+        for (VertexId v : result.order) ids.push_back(graph.external_id(v));
+        return ids;
+    }
+
+    [[nodiscard]] std::vector<GraphIndex> cycle() const
+    {
+        std::vector<GraphIndex> ids;
+        ids.reserve(result.cycle.size());
+        for (VertexId v : result.cycle) ids.push_back(graph.external_id(v));
+        return ids;
+    }
+};
+
+enum class TopologicalSortError
+{
+    FreezeFailed,
+};
+
+template <typename T>
+[[nodiscard]] std::expected<GraphTopologicalOrder<T>, TopologicalSortError> topological_sort(const Graph<T>& g)
+{
+    auto frozen = g.freeze();
+    if (!frozen) return std::unexpected(TopologicalSortError::FreezeFailed);
+    TopologicalOrder r = topological_sort(*frozen);
+    return GraphTopologicalOrder<T>{std::move(*frozen), std::move(r)};
+}
+} // namespace dsalgo
@@ -0,0 +1,112 @@
+// dsalgo/src/transpose.hpp
+#pragma once
+
+#include <algorithm>
+#include <utility>
+
+#include "parallel.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+namespace detail
+{
+// Tiles small enough that a source and a destination tile (32 x 32 doubles,
+// 8 KiB each) sit in L1 together, so each line is loaded once.
+inline constexpr usize transpose_tile = 32;
+// Below this many elements the pool costs more than it saves.
+inline constexpr usize transpose_parallel_elements = usize{1} << 16;
+
+template <typename T>
+void transpose_tile_kernel(const T* src, usize lds, T* dst, usize ldd, usize rows, usize cols) noexcept
+{
+    for (usize j = 0; j < cols; ++j)
+    {
+        T* out = dst + j * ldd;
+        for (usize i = 0; i < rows; ++i) out[i] = src[i * lds + j];
+    }
+}
+
+// Cache-oblivious: halve the longer side until a block fits a tile, so every
+// level of the hierarchy sees blocks that fit once they are small enough.
+template <typename T>
+void transpose_recursive(const T* src, usize lds, T* dst, usize ldd, usize rows, usize cols) noexcept
+{
+    if (rows <= transpose_tile && cols <= transpose_tile)
+    {
+        transpose_tile_kernel(src, lds, dst, ldd, rows, cols);
+    }
+    else if (rows >= cols)
+    {
+        const usize h = rows / 2;
+        transpose_recursive(src, lds, dst, ldd, h, cols);
+        transpose_recursive(src + h * lds, lds, dst + h, ldd, rows - h, cols);
+    }
+    else
+    {
+        const usize h = cols / 2;
+        transpose_recursive(src, lds, dst, ldd, rows, h);
+        transpose_recursive(src + h, lds, dst + h * ldd, ldd, rows, cols - h);
+    }
+}
+
+// Swaps the tile at (r, c) with the transpose of the tile at (c, r); on the
+// diagonal (r == c) only the upper triangle is walked.
+template <typename T>
+void swap_tiles(T* a, usize ld, usize r, usize c, usize h, usize w) noexcept
+{
+    for (usize i = 0; i < h; ++i)
+    {
+        for (usize j = (r == c) ? i + 1 : 0; j < w; ++j) std::swap(a[(r + i) * ld + c + j], a[(c + j) * ld + r + i]);
+    }
+}
+} // namespace detail
+
+// dst = src^T for a row-major rows x cols src with row stride lds, written
+// as a cols x rows matrix with row stride ldd. The buffers must not overlap.
+// Large inputs are cut into bands along the longer side, one task each.
+template <typename T>
+void transpose(const T* src, usize rows, usize cols, usize lds, T* dst, usize ldd)
+{
+    if (rows * cols <= detail::transpose_parallel_elements)
+    {
+        detail::transpose_recursive(src, lds, dst, ldd, rows, cols);
+        return;
+    }
+    constexpr usize band = 8 * detail::transpose_tile;
+    if (rows >= cols)
+    {
+        parallel_for_range(0, rows, band, [=](usize lo, usize hi, usize) {
+            detail::transpose_recursive(src + lo * lds, lds, dst + lo, ldd, hi - lo, cols);
+        });
+    }
+    else
+    {
+        // Bands of source columns are bands of destination rows, so no two
+        // tasks write to the same line.
+        parallel_for_range(0, cols, band, [=](usize lo, usize hi, usize) {
+            detail::transpose_recursive(src + lo, lds, dst + lo * ldd, ldd, rows, hi - lo);
+        });
+    }
+}
+
+// Transposes the n x n matrix at a (row stride ld) in place, tile pair by
+// tile pair. Task t owns tile row t and swaps it with tile column t; the
+// pool hands out the long rows at the top first.
+template <typename T>
+void transpose_in_place(T* a, usize n, usize ld)
+{
+    constexpr usize tile = detail::transpose_tile;
+    const usize tiles = (n + tile - 1) / tile;
+    const auto tile_row = [=](usize lo, usize hi, usize) {
+        for (usize t = lo; t < hi; ++t)
+        {
+            const usize r = t * tile;
+            const usize h = std::min(tile, n - r);
+            for (usize c = r; c < n; c += tile) detail::swap_tiles(a, ld, r, c, h, std::min(tile, n - c));
+        }
+    };
+    if (n * n <= detail::transpose_parallel_elements) tile_row(0, tiles, 0);
+    else parallel_for_range(0, tiles, 1, tile_row);
+}
+} // namespace dsalgo
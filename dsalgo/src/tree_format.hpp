@@ -0,0 +1,152 @@
+// dsalgo/src/tree_format.hpp
+#pragma once
+
+#include <cerrno>
+#include <cstdio>
+#include <expected>
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+#include "types.hpp"
+
+namespace dsalgo
+{
+namespace detail
+{
+// Shared renderer behind the tree formatters. A format adaptor describes one tree type:
+//   handle / cursor       cheap copyable node reference / position in a child list
+//   root()                handle of the root
+//   first(h)              cursor at the first child of h
+//   valid(h, c)           false once c ran past the last child
+//   next(h, c)            advance c
+//   child(h, c)           handle of the child at c
+//   is_last(h, c)         whether c is the last child
+//   label(h, c, i)        label printed for the i-th child
+//   value(h)              payload printed for h
+// The walk uses an explicit stack (one frame per level) and a single prefix
+// buffer that is truncated on the way back up, so neither deep trees nor wide
+// ones allocate per node. `on_line` runs after every line; returning false
+// stops the walk early.
+template <typename Adaptor, typename Out, typename OnLine>
+Out format_tree(const Adaptor& a, Out out, OnLine&& on_line)
+{
+    using handle = typename Adaptor::handle;
+    using cursor = typename Adaptor::cursor;
+
+    struct Frame
+    {
+        handle node;
+        cursor pos;
+        usize child_idx;
+        usize prefix_len;
+    };
+
+    out = std::format_to(out, "root: {}\n", a.value(a.root()));
+    if (!on_line()) return out;
+
+    std::string prefix;
+    std::vector<Frame> stack;
+    stack.push_back(Frame{a.root(), a.first(a.root()), 0, 0});
+
+    while (!stack.empty())
+    {
+        Frame& f = stack.back();
+        if (!a.valid(f.node, f.pos))
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        const handle child = a.child(f.node, f.pos);
+        const bool is_last = a.is_last(f.node, f.pos);
+
+        prefix.resize(f.prefix_len);
+        out = std::format_to(
+            out,
+            "{}{}── {}: {}\n",
+            std::string_view{prefix},
+            (is_last ? "└" : "├"),
+            a.label(f.node, f.pos, f.child_idx),
+            a.value(child)
+        );
+
+        f.pos = a.next(f.node, f.pos);
+        ++f.child_idx;
+        prefix += (is_last ? "    " : "│   ");
+
+        // `f` is dead from here on, push_back may reallocate.
+        stack.push_back(Frame{child, a.first(child), 0, prefix.size()});
+
+        if (!on_line()) return out;
+    }
+    return out;
+}
+
+template <typename Tree, typename Sink>
+bool write_tree_buffered(const Tree& tree, usize buffer_bytes, Sink&& sink)
+{
+    std::string buf;
+    buf.reserve(buffer_bytes + 256);
+
+    bool ok = true;
+    const auto a = format_adaptor(tree);
+    format_tree(a, std::back_inserter(buf), [&] {
+        if (buf.size() >= buffer_bytes)
+        {
+            ok = sink(std::string_view{buf});
+            buf.clear();
+        }
+        return ok;
+    });
+
+    if (ok && !buf.empty()) ok = sink(std::string_view{buf});
+    return ok;
+}
+} // namespace detail
+
+enum class TreeWriteError
+{
+    WriteFailed,
+};
+
+inline constexpr usize tree_write_buffer_bytes = 64 * 1024;
+
+// Streams `tree` to a file descriptor through a fixed-size buffer instead of
+// materialising the whole dump as one string.
+template <typename Tree>
+[[nodiscard]]
+std::expected<void, TreeWriteError> write_tree(int fd, const Tree& tree, usize buffer_bytes = tree_write_buffer_bytes)
+{
+    const bool ok = detail::write_tree_buffered(tree, buffer_bytes, [fd](std::string_view chunk) {
+        while (!chunk.empty())
+        {
+            const auto n = ::write(fd, chunk.data(), chunk.size());
+            if (n < 0)
+            {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            chunk.remove_prefix(static_cast<usize>(n));
+        }
+        return true;
+    });
+    if (!ok) return std::unexpected(TreeWriteError::WriteFailed);
+    return {};
+}
+
+template <typename Tree>
+[[nodiscard]]
+std::expected<void, TreeWriteError> write_tree(std::FILE* file, const Tree& tree, usize buffer_bytes = tree_write_buffer_bytes)
+{
+    const bool ok = detail::write_tree_buffered(tree, buffer_bytes, [file](std::string_view chunk) {
+        return std::fwrite(chunk.data(), 1, chunk.size(), file) == chunk.size();
+    });
+    if (!ok) return std::unexpected(TreeWriteError::WriteFailed);
+    return {};
+}
+} // namespace dsalgo
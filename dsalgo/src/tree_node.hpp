@@ -3,10 +3,11 @@
 
 #include <format>
 #include <memory>
-#include <string>
 #include <utility>
 #include <vector>
 
+#include "tree_format.hpp"
+
 namespace dsalgo{
 
 template <typename T>
@@ -14,6 +15,24 @@ struct TreeNode
 {
     explicit TreeNode(T value) : m_value(std::move(value)) {}
 
+    TreeNode(TreeNode&&) noexcept = default;
+    // The old children go through ~TreeNode, which does not recurse.
+    TreeNode& operator=(TreeNode&&) noexcept = default;
+
+    // Detaches every descendant onto one work list before freeing it, so a
+    // deep chain is torn down in a loop instead of one stack frame per level.
+    ~TreeNode()
+    {
+        std::vector<std::unique_ptr<TreeNode>> pending = std::move(m_children);
+        while (!pending.empty())
+        {
+            std::unique_ptr<TreeNode> node = std::move(pending.back());
+            pending.pop_back();
+            for (auto& child : node->m_children) pending.push_back(std::move(child));
+            node->m_children.clear();
+        }
+    }
+
     void create_new_child(T value)
     {
         m_children.emplace_back(std::make_unique<TreeNode>(std::move(value)));
@@ -30,6 +49,33 @@ private:
     T m_value;
     std::vector<std::unique_ptr<TreeNode>> m_children;
 };
+
+namespace detail
+{
+template <typename T>
+struct TreeNodeFormatAdaptor
+{
+    using handle = const TreeNode<T>*;
+    using cursor = size_t;
+
+    handle m_root;
+
+    handle root() const noexcept { return m_root; }
+    cursor first(handle) const noexcept { return 0; }
+    bool valid(handle h, cursor c) const noexcept { return c < h->child_count(); }
+    cursor next(handle, cursor c) const noexcept { return c + 1; }
+    handle child(handle h, cursor c) const noexcept { return h->children()[c].get(); }
+    bool is_last(handle h, cursor c) const noexcept { return c + 1 == h->child_count(); }
+    size_t label(handle, cursor, size_t idx) const noexcept { return idx; }
+    const T& value(handle h) const noexcept { return h->value(); }
+};
+} // namespace detail
+
+template <typename T>
+detail::TreeNodeFormatAdaptor<T> format_adaptor(const TreeNode<T>& node) noexcept
+{
+    return {&node};
+}
 } // namespace dsalgo
 
 template <typename T>
@@ -46,42 +92,6 @@ struct std::formatter<dsalgo::TreeNode<T>>
 
     auto format(const dsalgo::TreeNode<T>& node, std::format_context& ctx) const
     {
-        auto out = ctx.out();
-        out = std::format_to(out, "root: {}\n", node.value());
-
-        const auto& ch = node.children();
-        for (size_t i = 0; i < ch.size(); ++i) {
-            const bool is_last = (i + 1 == ch.size());
-            out = format_child(*ch[i], out, "", i, is_last);
-        }
-        return out;
-    }
-
-private:
-    static auto format_child(
-        const dsalgo::TreeNode<T>& node,
-        std::format_context::iterator out,
-        const std::string& prefix,
-        size_t idx,
-        bool is_last
-    ) -> std::format_context::iterator
-    {
-        out = std::format_to(
-            out,
-            "{}{}── {}: {}\n",
-            prefix,
-            (is_last ? "└" : "├"),
-            idx,
-            node.value()
-        );
-
-        std::string next_prefix = prefix + (is_last ? "    " : "│   ");
-
-        const auto& ch = node.children();
-        for (size_t i = 0; i < ch.size(); ++i) {
-            const bool child_is_last = (i + 1 == ch.size());
-            out = format_child(*ch[i], out, next_prefix, i, child_is_last);
-        }
-        return out;
+        return dsalgo::detail::format_tree(dsalgo::format_adaptor(node), ctx.out(), [] { return true; });
     }
 };
\ No newline at end of file
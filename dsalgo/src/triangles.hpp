@@ -0,0 +1,188 @@
+// dsalgo/src/triangles.hpp
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <span>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// Size of the intersection of two sorted, duplicate-free id lists, calling
+// on_match(x) for every common element. Blocks of four from each side are
+// compared all-against-all (the second block rotated through its four lanes)
+// and the block with the smaller maximum advances, which is what
+// GraphNode's sorted, deduplicated neighbor lists make possible. SSE2 and
+// AArch64 NEON get a vector version; anything else, and the tails, use the
+// scalar merge.
+template <typename OnMatch>
+usize intersect(std::span<const VertexId> a, std::span<const VertexId> b, OnMatch&& on_match)
+{
+    usize i = 0;
+    usize j = 0;
+    usize count = 0;
+
+#if defined(__SSE2__) || (defined(__ARM_NEON) && defined(__aarch64__))
+    while (i + 4 <= a.size() && j + 4 <= b.size())
+    {
+#if defined(__SSE2__)
+        const __m128i va = _mm_loadu_si128(static_cast<const __m128i*>(static_cast<const void*>(a.data() + i)));
+        const __m128i vb = _mm_loadu_si128(static_cast<const __m128i*>(static_cast<const void*>(b.data() + j)));
+        const __m128i eq = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4e)),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93))));
+        auto mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+#else
+        const uint32x4_t va = vld1q_u32(a.data() + i);
+        const uint32x4_t vb = vld1q_u32(b.data() + j);
+        const uint32x4_t eq = vorrq_u32(vorrq_u32(vceqq_u32(va, vb), vceqq_u32(va, vextq_u32(vb, vb, 1))),
+                                        vorrq_u32(vceqq_u32(va, vextq_u32(vb, vb, 2)), vceqq_u32(va, vextq_u32(vb, vb, 3))));
+        const uint32x4_t lane_bits = {1, 2, 4, 8};
+        auto mask = static_cast<unsigned>(vaddvq_u32(vandq_u32(eq, lane_bits)));
+#endif
+        count += static_cast<usize>(std::popcount(mask));
+        for (; mask != 0; mask &= mask - 1) on_match(a[i + static_cast<usize>(std::countr_zero(mask))]);
+
+        const VertexId a_max = a[i + 3];
+        const VertexId b_max = b[j + 3];
+        i += a_max <= b_max ? 4 : 0;
+        j += b_max <= a_max ? 4 : 0;
+    }
+#endif
+
+    while (i < a.size() && j < b.size())
+    {
+        if (a[i] < b[j]) ++i;
+        else if (b[j] < a[i]) ++j;
+        else
+        {
+            on_match(a[i]);
+            ++count;
+            ++i;
+            ++j;
+        }
+    }
+    return count;
+}
+
+[[nodiscard]] inline usize intersection_size(std::span<const VertexId> a, std::span<const VertexId> b)
+{
+    return intersect(a, b, [](VertexId) {});
+}
+
+// Keeps each undirected edge once, pointing from the endpoint with lower
+// (degree, id) to the higher one. Every out-list then has O(sqrt(m))
+// entries and each triangle is found exactly once, at its lowest vertex.
+[[nodiscard]] inline CsrAdjacency degree_oriented(const CsrAdjacency& sym)
+{
+    const usize n = sym.vertex_count();
+    const auto before = [&](VertexId u, VertexId v) {
+        const usize du = sym.degree(u);
+        const usize dv = sym.degree(v);
+        return du < dv || (du == dv && u < v);
+    };
+
+    CsrAdjacency o;
+    o.offsets.assign(n + 1, 0);
+    parallel_for(0, n, [&](usize u) {
+        const auto id = static_cast<VertexId>(u);
+        o.offsets[u + 1] = static_cast<u64>(std::ranges::count_if(sym.neighbors(id), [&](VertexId v) { return before(id, v); }));
+    });
+    for (usize u = 0; u < n; ++u) o.offsets[u + 1] += o.offsets[u];
+
+    o.edges.resize(o.offsets.back());
+    parallel_for(0, n, [&](usize u) {
+        const auto id = static_cast<VertexId>(u);
+        u64 at = o.offsets[u];
+        for (VertexId v : sym.neighbors(id))
+        {
+            if (before(id, v)) o.edges[at++] = v;
+        }
+    });
+    return o;
+}
+
+// Number of triangles in a symmetric adjacency (see CsrAdjacency::symmetrized).
+[[nodiscard]] inline u64 count_triangles(const CsrAdjacency& sym)
+{
+    const CsrAdjacency o = degree_oriented(sym);
+    return parallel_sum<u64>(0, o.vertex_count(), [&](usize u) {
+        const auto nu = o.neighbors(static_cast<VertexId>(u));
+        u64 t = 0;
+        for (VertexId v : nu) t += intersection_size(nu, o.neighbors(v));
+        return t;
+    }, 64);
+}
+
+struct Clustering
+{
+    std::vector<u64> triangles; // per vertex
+    std::vector<double> local;  // triangles / possible triangles among the neighbours; 0 below degree 2
+    u64 total_triangles = 0;
+    double global = 0.0;        // transitivity: 3 * triangles / connected triples
+    double average_local = 0.0;
+};
+
+// Local and global clustering coefficients of a symmetric adjacency.
+[[nodiscard]] inline Clustering clustering(const CsrAdjacency& sym)
+{
+    const usize n = sym.vertex_count();
+    const CsrAdjacency o = degree_oriented(sym);
+
+    Clustering c;
+    c.triangles.assign(n, 0);
+    const auto bump = [&](VertexId v, u64 by) {
+        std::atomic_ref<u64>{c.triangles[v]}.fetch_add(by, std::memory_order_relaxed);
+    };
+
+    c.total_triangles = parallel_sum<u64>(0, n, [&](usize i) {
+        const auto u = static_cast<VertexId>(i);
+        const auto nu = o.neighbors(u);
+        u64 found = 0;
+        for (VertexId v : nu)
+        {
+            const usize t = intersect(nu, o.neighbors(v), [&](VertexId w) { bump(w, 1); });
+            if (t != 0) bump(v, t);
+            found += t;
+        }
+        if (found != 0) bump(u, found);
+        return found;
+    }, 64);
+
+    c.local.assign(n, 0.0);
+    const double wedges = parallel_sum<double>(0, n, [&](usize v) {
+        const auto d = static_cast<double>(sym.degree(static_cast<VertexId>(v)));
+        const double pairs = d * (d - 1.0) / 2.0;
+        if (pairs > 0.0) c.local[v] = static_cast<double>(c.triangles[v]) / pairs;
+        return pairs;
+    });
+
+    c.global = wedges > 0.0 ? 3.0 * static_cast<double>(c.total_triangles) / wedges : 0.0;
+    if (n > 0) c.average_local = parallel_sum<double>(0, n, [&](usize v) { return c.local[v]; }) / static_cast<double>(n);
+    return c;
+}
+
+template <typename T>
+[[nodiscard]] u64 count_triangles(const CsrGraph<T>& g)
+{
+    return count_triangles(g.adjacency().symmetrized());
+}
+
+template <typename T>
+[[nodiscard]] Clustering clustering(const CsrGraph<T>& g)
+{
+    return clustering(g.adjacency().symmetrized());
+}
+} // namespace dsalgo
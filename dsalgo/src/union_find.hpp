@@ -0,0 +1,86 @@
+// dsalgo/src/union_find.hpp
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+#include "types.hpp"
+
+namespace dsalgo
+{
+// Disjoint-set forest over 0 .. size() - 1 that tolerates concurrent
+// find/unite from any number of threads. Unions always hang the root with
+// the larger index below the smaller one, so a root is the smallest element
+// of its set and parent indices only ever decrease, which rules out cycles
+// without ranks or locks. find() does path splitting with a CAS per step;
+// a lost CAS only means another thread already shortened the path.
+class ConcurrentUnionFind
+{
+public:
+    explicit ConcurrentUnionFind(usize n) : m_parent(std::make_unique<std::atomic<VertexId>[]>(n)), m_size(n)
+    {
+        parallel_for(0, n, [&](usize i) { m_parent[i].store(static_cast<VertexId>(i), std::memory_order_relaxed); });
+    }
+
+    [[nodiscard]] usize size() const noexcept { return m_size; }
+
+    [[nodiscard]] VertexId find(VertexId x) noexcept
+    {
+        while (true)
+        {
+            const VertexId p = m_parent[x].load(std::memory_order_relaxed);
+            if (p == x) return x;
+            const VertexId gp = m_parent[p].load(std::memory_order_relaxed);
+            if (p != gp)
+            {
+                VertexId expected = p;
+                m_parent[x].compare_exchange_weak(expected, gp, std::memory_order_relaxed);
+            }
+            x = p;
+        }
+    }
+
+    // Returns true if a and b were in different sets.
+    bool unite(VertexId a, VertexId b) noexcept
+    {
+        while (true)
+        {
+            VertexId ra = find(a);
+            VertexId rb = find(b);
+            if (ra == rb) return false;
+            if (ra < rb) std::swap(ra, rb);
+            // ra is the larger root; it may have been linked elsewhere meanwhile, then retry.
+            VertexId expected = ra;
+            if (m_parent[ra].compare_exchange_strong(expected, rb, std::memory_order_acq_rel)) return true;
+        }
+    }
+
+    [[nodiscard]] bool same(VertexId a, VertexId b) noexcept
+    {
+        while (true)
+        {
+            const VertexId ra = find(a);
+            const VertexId rb = find(b);
+            if (ra == rb) return true;
+            // Only a conclusive "no" if ra was still a root after reading rb.
+            if (m_parent[ra].load(std::memory_order_acquire) == ra) return false;
+        }
+    }
+
+    // Fully compressed representative (smallest member) of every element.
+    [[nodiscard]] std::vector<VertexId> labels()
+    {
+        std::vector<VertexId> out(m_size);
+        parallel_for(0, m_size, [&](usize i) { out[i] = find(static_cast<VertexId>(i)); });
+        return out;
+    }
+
+private:
+    std::unique_ptr<std::atomic<VertexId>[]> m_parent;
+    usize m_size;
+};
+} // namespace dsalgo
@@ -0,0 +1,675 @@
+// dsalgo/src/versioned_graph.hpp
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "graph.hpp"
+#include "parallel.hpp"
+#include "types.hpp"
+#include "util.hpp"
+
+namespace dsalgo
+{
+template <typename T>
+class VersionedGraph;
+
+namespace detail
+{
+// Node of a HashTrie: a 32-way bitmap-compressed branch. `entries` holds one
+// entry per set bit of `bitmap`, in bit order; an entry is either a leaf
+// (key and value) or a child branch.
+template <typename V>
+struct HashTrieNode
+{
+    struct Entry
+    {
+        u64 key = 0;
+        std::shared_ptr<HashTrieNode> child;
+        std::shared_ptr<V> value;
+    };
+
+    u64 edit = 0;
+    u32 bitmap = 0;
+    std::vector<Entry> entries;
+};
+
+// Persistent hash trie (HAMT) over keys that are already unique, uniformly
+// hashed 64-bit values, so two keys never collide on all levels. Copies share
+// every node; an edit copies only the root-to-leaf path it walks, and edits
+// nodes in place when their `edit` tag matches, i.e. they were created by the
+// same writer and are not yet visible to anyone else.
+template <typename V>
+class HashTrie
+{
+public:
+    using Node = HashTrieNode<V>;
+    using Entry = typename Node::Entry;
+
+    [[nodiscard]] const Node* root() const noexcept { return m_root.get(); }
+
+    [[nodiscard]] const V* find(u64 key) const noexcept
+    {
+        const Node* n = m_root.get();
+        for (usize depth = 0;; ++depth)
+        {
+            const u32 bit = u32{1} << slot(key, depth);
+            if ((n->bitmap & bit) == 0) return nullptr;
+            const auto& e = n->entries[index(n->bitmap, bit)];
+            if (!e.child) return e.key == key ? e.value.get() : nullptr;
+            n = e.child.get();
+        }
+    }
+
+    // Calls f(const V&) for every value, in no particular order.
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        for_each_in(*m_root, f);
+    }
+
+    // Requires `key` to be absent.
+    void insert(u64 key, std::shared_ptr<V> value, u64 edit)
+    {
+        assert(find(key) == nullptr);
+        Node* n = &writable(m_root, edit);
+        for (usize depth = 0;; ++depth)
+        {
+            const u32 bit = u32{1} << slot(key, depth);
+            const usize i = index(n->bitmap, bit);
+            if ((n->bitmap & bit) == 0)
+            {
+                n->entries.insert(n->entries.begin() + static_cast<std::ptrdiff_t>(i), Entry{key, nullptr, std::move(value)});
+                n->bitmap |= bit;
+                return;
+            }
+            auto& e = n->entries[i];
+            if (!e.child)
+            {
+                // Push the resident leaf one level down and continue there.
+                auto child = std::make_shared<Node>();
+                child->edit = edit;
+                child->bitmap = u32{1} << slot(e.key, depth + 1);
+                child->entries.push_back(std::move(e));
+                e = Entry{0, std::move(child), nullptr};
+            }
+            n = &writable(e.child, edit);
+        }
+    }
+
+    // Returns false if `key` is absent.
+    bool erase(u64 key, u64 edit)
+    {
+        if (find(key) == nullptr) return false;
+        erase_in(writable(m_root, edit), key, 0, edit);
+        return true;
+    }
+
+    // The slot holding `key`'s value, on a path this writer owns, or nullptr
+    // if `key` is absent. The value itself is still shared.
+    [[nodiscard]] std::shared_ptr<V>* find_for_edit(u64 key, u64 edit)
+    {
+        if (find(key) == nullptr) return nullptr;
+        Node* n = &writable(m_root, edit);
+        for (usize depth = 0;; ++depth)
+        {
+            auto& e = n->entries[index(n->bitmap, u32{1} << slot(key, depth))];
+            if (!e.child) return &e.value;
+            n = &writable(e.child, edit);
+        }
+    }
+
+private:
+    static constexpr usize levels = 13;
+
+    // Top bits first: the caller shards on the low bits. Twelve 5-bit levels
+    // and a last 4-bit one cover all 64.
+    [[nodiscard]] static u32 slot(u64 key, usize depth) noexcept
+    {
+        assert(depth < levels);
+        if (depth + 1 < levels) return static_cast<u32>(key >> (64 - 5 * (depth + 1))) & 31u;
+        return static_cast<u32>(key) & 15u;
+    }
+
+    [[nodiscard]] static usize index(u32 bitmap, u32 bit) noexcept
+    {
+        return static_cast<usize>(std::popcount(bitmap & (bit - 1)));
+    }
+
+    static Node& writable(std::shared_ptr<Node>& node, u64 edit)
+    {
+        if (node->edit != edit)
+        {
+            auto copy = std::make_shared<Node>(*node);
+            copy->edit = edit;
+            node = std::move(copy);
+        }
+        return *node;
+    }
+
+    static void erase_in(Node& n, u64 key, usize depth, u64 edit)
+    {
+        const u32 bit = u32{1} << slot(key, depth);
+        const usize i = index(n.bitmap, bit);
+        auto& e = n.entries[i];
+        if (e.child)
+        {
+            Node& child = writable(e.child, edit);
+            erase_in(child, key, depth + 1, edit);
+            // A branch down to a single leaf collapses back into that leaf.
+            if (child.entries.size() == 1 && !child.entries.front().child)
+            {
+                auto leaf = std::move(child.entries.front());
+                e = std::move(leaf);
+            }
+            return;
+        }
+        n.entries.erase(n.entries.begin() + static_cast<std::ptrdiff_t>(i));
+        n.bitmap &= ~bit;
+    }
+
+    template <typename F>
+    static void for_each_in(const Node& n, F& f)
+    {
+        for (const auto& e : n.entries)
+        {
+            if (e.child) for_each_in(*e.child, f);
+            else f(std::as_const(*e.value));
+        }
+    }
+
+    std::shared_ptr<Node> m_root = std::make_shared<Node>();
+};
+} // namespace detail
+
+// A node of a VersionedGraph. The sorted neighbor list is split into shared
+// blocks of a few dozen entries, so an edit copies the blocks it lands in and
+// the list of block pointers rather than the whole list of a hub.
+template <typename T>
+class VersionedNode
+{
+public:
+    // A block that grows past twice this size is cut into pieces of it.
+    static constexpr usize block_size = 64;
+
+    struct Block
+    {
+        std::vector<GraphIndex> targets; // sorted, never empty
+        std::vector<EdgeWeight> weights; // parallel to targets
+        u64 edit = 0;
+    };
+
+    VersionedNode(T value, GraphIndex idx, u64 edit) : m_value(std::move(value)), m_idx(idx), m_edit(edit) {}
+
+    [[nodiscard]] const T& value() const noexcept { return m_value; }
+    [[nodiscard]] GraphIndex get_idx() const noexcept { return m_idx; }
+    [[nodiscard]] usize degree() const noexcept { return m_degree; }
+
+    [[nodiscard]] usize block_count() const noexcept { return m_blocks.size(); }
+    [[nodiscard]] const Block& block(usize i) const noexcept { return *m_blocks[i]; }
+
+    [[nodiscard]] std::optional<EdgeWeight> weight_to(GraphIndex to) const noexcept
+    {
+        const usize b = block_for(to);
+        if (b == m_blocks.size()) return std::nullopt;
+        const Block& blk = *m_blocks[b];
+        const GraphIndex* it = branchless_lower_bound(std::span<const GraphIndex>{blk.targets}, to);
+        if (it == blk.targets.data() + blk.targets.size() || *it != to) return std::nullopt;
+        return blk.weights[static_cast<usize>(it - blk.targets.data())];
+    }
+
+    [[nodiscard]] bool contains_edge(GraphIndex to) const noexcept { return weight_to(to).has_value(); }
+
+    // Calls f(targets, weights) per block; concatenated, the targets are the
+    // sorted neighbor list.
+    template <typename F>
+    void for_each_run(F&& f) const
+    {
+        for (const auto& b : m_blocks) f(std::span<const GraphIndex>{b->targets}, std::span<const EdgeWeight>{b->weights});
+    }
+
+    template <typename F>
+    void for_each_neighbor(F&& f) const
+    {
+        for (const auto& b : m_blocks)
+        {
+            for (GraphIndex to : b->targets) f(to);
+        }
+    }
+
+private:
+    friend class VersionedGraph<T>;
+
+    // First block whose last target is >= to, or block_count().
+    [[nodiscard]] usize block_for(GraphIndex to) const noexcept
+    {
+        const auto it = std::ranges::partition_point(m_blocks, [to](const auto& b) { return b->targets.back() < to; });
+        return static_cast<usize>(it - m_blocks.begin());
+    }
+
+    Block& writable_block(usize b, u64 edit)
+    {
+        if (m_blocks[b]->edit != edit)
+        {
+            auto copy = std::make_shared<Block>(*m_blocks[b]);
+            copy->edit = edit;
+            m_blocks[b] = std::move(copy);
+        }
+        return *m_blocks[b];
+    }
+
+    void split_block(usize b, u64 edit)
+    {
+        if (m_blocks[b]->targets.size() <= 2 * block_size) return;
+        Block whole = std::move(*m_blocks[b]);
+        std::vector<std::shared_ptr<Block>> pieces;
+        for (usize lo = 0; lo < whole.targets.size(); lo += block_size)
+        {
+            const usize hi = std::min(lo + block_size, whole.targets.size());
+            auto piece = std::make_shared<Block>();
+            piece->targets.assign(whole.targets.begin() + static_cast<std::ptrdiff_t>(lo),
+                                  whole.targets.begin() + static_cast<std::ptrdiff_t>(hi));
+            piece->weights.assign(whole.weights.begin() + static_cast<std::ptrdiff_t>(lo),
+                                  whole.weights.begin() + static_cast<std::ptrdiff_t>(hi));
+            piece->edit = edit;
+            pieces.push_back(std::move(piece));
+        }
+        m_blocks.erase(m_blocks.begin() + static_cast<std::ptrdiff_t>(b));
+        m_blocks.insert(m_blocks.begin() + static_cast<std::ptrdiff_t>(b), pieces.begin(), pieces.end());
+    }
+
+    // Adds a sorted, duplicate-free batch of new neighbors. Walks the batch
+    // back to front so splitting a block never shifts one still to visit.
+    void merge_neighbors(std::span<const GraphIndex> sorted, std::span<const EdgeWeight> weights, u64 edit)
+    {
+        assert(sorted.size() == weights.size());
+        if (sorted.empty()) return;
+        m_degree += sorted.size();
+        if (m_blocks.empty())
+        {
+            auto fresh = std::make_shared<Block>();
+            fresh->targets.assign(sorted.begin(), sorted.end());
+            fresh->weights.assign(weights.begin(), weights.end());
+            fresh->edit = edit;
+            m_blocks.push_back(std::move(fresh));
+            split_block(0, edit);
+            return;
+        }
+
+        std::vector<GraphIndex> merged;
+        std::vector<EdgeWeight> merged_weights;
+        for (usize end = sorted.size(); end > 0;)
+        {
+            const usize b = std::min(block_for(sorted[end - 1]), m_blocks.size() - 1);
+            usize begin = end;
+            while (begin > 0 && (b == 0 || sorted[begin - 1] > m_blocks[b - 1]->targets.back())) --begin;
+
+            Block& blk = writable_block(b, edit);
+            merged.clear();
+            merged_weights.clear();
+            usize i = 0;
+            usize j = begin;
+            while (i < blk.targets.size() || j < end)
+            {
+                if (j == end || (i < blk.targets.size() && blk.targets[i] < sorted[j]))
+                {
+                    merged.push_back(blk.targets[i]);
+                    merged_weights.push_back(blk.weights[i++]);
+                }
+                else
+                {
+                    merged.push_back(sorted[j]);
+                    merged_weights.push_back(weights[j++]);
+                }
+            }
+            blk.targets.swap(merged);
+            blk.weights.swap(merged_weights);
+            split_block(b, edit);
+            end = begin;
+        }
+    }
+
+    // Removes a sorted batch of existing neighbors; emptied blocks are dropped.
+    void erase_neighbors(std::span<const GraphIndex> sorted, u64 edit)
+    {
+        m_degree -= sorted.size();
+        for (usize end = sorted.size(); end > 0;)
+        {
+            const usize b = block_for(sorted[end - 1]);
+            assert(b < m_blocks.size());
+            usize begin = end;
+            while (begin > 0 && (b == 0 || sorted[begin - 1] > m_blocks[b - 1]->targets.back())) --begin;
+            erase_from_block(b, edit, [&](GraphIndex to) {
+                return std::ranges::binary_search(sorted.subspan(begin, end - begin), to);
+            });
+            end = begin;
+        }
+    }
+
+    // Copies only the blocks that hold a neighbor matching `pred`.
+    template <typename Pred>
+    usize erase_neighbors_if(Pred pred, u64 edit)
+    {
+        usize removed = 0;
+        for (usize b = m_blocks.size(); b-- > 0;)
+        {
+            if (std::ranges::any_of(m_blocks[b]->targets, pred)) removed += erase_from_block(b, edit, pred);
+        }
+        m_degree -= removed;
+        return removed;
+    }
+
+    template <typename Pred>
+    usize erase_from_block(usize b, u64 edit, Pred pred)
+    {
+        Block& blk = writable_block(b, edit);
+        usize kept = 0;
+        for (usize i = 0; i < blk.targets.size(); ++i)
+        {
+            if (pred(blk.targets[i])) continue;
+            blk.targets[kept] = blk.targets[i];
+            blk.weights[kept++] = blk.weights[i];
+        }
+        const usize removed = blk.targets.size() - kept;
+        blk.targets.resize(kept);
+        blk.weights.resize(kept);
+        if (kept == 0) m_blocks.erase(m_blocks.begin() + static_cast<std::ptrdiff_t>(b));
+        return removed;
+    }
+
+    T m_value;
+    GraphIndex m_idx;
+    u64 m_edit;
+    usize m_degree = 0;
+    std::vector<std::shared_ptr<Block>> m_blocks;
+};
+
+// Immutable view of a VersionedGraph at one version. Nodes live in shards
+// (by hash of their index), each a persistent hash trie shared with the
+// versions before and after it, so holding a snapshot costs nothing while
+// writers move on; it stays valid as long as the shared_ptr is held.
+template <typename T>
+class GraphSnapshot
+{
+public:
+    using Node = VersionedNode<T>;
+    using IndexNode = detail::HashTrieNode<Node>;
+
+    [[nodiscard]] u64 version() const noexcept { return m_version; }
+    [[nodiscard]] usize node_count() const noexcept { return m_node_count; }
+
+    [[nodiscard]] const Node* node(GraphIndex idx) const noexcept
+    {
+        const u64 key = hash_int(idx);
+        return m_shards[shard_of(key)].find(key);
+    }
+
+    [[nodiscard]] bool contains_edge(GraphIndex from, GraphIndex to) const noexcept
+    {
+        const Node* n = node(from);
+        return n != nullptr && n->contains_edge(to);
+    }
+
+    // Calls f(const VersionedNode<T>&) for every node, in no particular order.
+    template <typename F>
+    void for_each_node(F&& f) const
+    {
+        for (const auto& shard : m_shards) shard.for_each(f);
+    }
+
+    // Shard roots, for checking what two versions share.
+    [[nodiscard]] usize shard_count() const noexcept { return m_shards.size(); }
+    [[nodiscard]] const IndexNode* shard_root(usize s) const noexcept { return m_shards[s].root(); }
+
+    // Same as Graph::freeze, for running the CSR algorithms on this version.
+    [[nodiscard]] std::expected<CsrGraph<T>, typename Graph<T>::FreezeError> freeze() const
+    {
+        std::vector<GraphIndex> ids;
+        ids.reserve(m_node_count);
+        for_each_node([&](const Node& n) { ids.push_back(n.get_idx()); });
+        return Graph<T>::freeze_nodes(std::move(ids), [&](GraphIndex idx) -> const Node& { return *node(idx); });
+    }
+
+private:
+    friend class VersionedGraph<T>;
+
+    [[nodiscard]] usize shard_of(u64 key) const noexcept { return static_cast<usize>(key % m_shards.size()); }
+
+    std::vector<detail::HashTrie<Node>> m_shards;
+    usize m_node_count = 0;
+    u64 m_version = 0;
+};
+
+// A graph that readers traverse through snapshots while a writer applies
+// GraphBatch updates. apply() builds the next version copy-on-write: it copies
+// the index path to each node it touches, the node, and the neighbor blocks
+// it edits; everything else is shared with the previous version. The result
+// is published through an atomic shared_ptr, so readers never wait on a
+// writer. Writers are serialized. Shards only split the work of the parallel
+// phases; each costs one pointer per version. Batch semantics and the report
+// match Graph::apply.
+template <typename T>
+class VersionedGraph
+{
+public:
+    using BatchReport = typename Graph<T>::BatchReport;
+
+    explicit VersionedGraph(usize shard_count = 64)
+    {
+        auto initial = std::make_shared<GraphSnapshot<T>>();
+        initial->m_shards.resize(std::max<usize>(shard_count, 1));
+        m_current.store(std::move(initial));
+    }
+
+    [[nodiscard]] std::shared_ptr<const GraphSnapshot<T>> snapshot() const { return m_current.load(); }
+
+    BatchReport apply(const GraphBatch<T>& batch)
+    {
+        std::scoped_lock write_lock{m_write};
+        const std::shared_ptr<const GraphSnapshot<T>> base = snapshot();
+        Builder b{*base, ++m_edits};
+        BatchReport report;
+
+        report.removed_edges = b.remove_edges(batch.remove_edges);
+        report.nodes_removed = b.remove_nodes(batch.remove_nodes);
+        report.nodes_missing = batch.remove_nodes.size() - report.nodes_removed;
+        for (const auto& [idx, value] : batch.add_nodes)
+        {
+            if (b.add_node(idx, value)) ++report.nodes_added;
+            else ++report.nodes_rejected;
+        }
+        report.added_edges = b.add_edges(batch.add_edges);
+
+        auto next = std::make_shared<GraphSnapshot<T>>(std::move(b.next));
+        next->m_version = base->m_version + 1;
+        next->m_node_count = base->m_node_count + report.nodes_added - report.nodes_removed;
+        m_current.store(std::move(next));
+        return report;
+    }
+
+private:
+    using Node = VersionedNode<T>;
+
+    // Next version under construction. Everything it copies is tagged with
+    // `edit`, unique per batch, so later phases of the same batch edit the
+    // copies in place.
+    struct Builder
+    {
+        GraphSnapshot<T> next;
+        u64 edit;
+
+        Builder(const GraphSnapshot<T>& base, u64 edit_tag) : next(base), edit(edit_tag) {}
+
+        [[nodiscard]] usize shard_count() const noexcept { return next.m_shards.size(); }
+
+        Node& writable_node(usize s, GraphIndex idx)
+        {
+            std::shared_ptr<Node>& slot = *next.m_shards[s].find_for_edit(hash_int(idx), edit);
+            if (slot->m_edit != edit)
+            {
+                auto copy = std::make_shared<Node>(*slot);
+                copy->m_edit = edit;
+                slot = std::move(copy);
+            }
+            return *slot;
+        }
+
+        // Groups edges by the shard of their source, sorted by (from, to) so
+        // each source's edges are contiguous; a stable sort keeps the first of
+        // repeated edges first.
+        template <typename Edge, typename From, typename To>
+        std::vector<std::vector<Edge>> by_shard(std::span<const Edge> edges, From from, To to) const
+        {
+            std::vector<std::vector<Edge>> groups(shard_count());
+            for (const Edge& e : edges) groups[next.shard_of(hash_int(from(e)))].push_back(e);
+            for (auto& g : groups) std::ranges::stable_sort(g, {}, [&](const Edge& e) { return std::pair{from(e), to(e)}; });
+            return groups;
+        }
+
+        typename Graph<T>::RemoveEdgesReport remove_edges(std::span<const std::pair<GraphIndex, GraphIndex>> edges)
+        {
+            using Edge = std::pair<GraphIndex, GraphIndex>;
+            const auto groups = by_shard(edges, [](const Edge& e) { return e.first; }, [](const Edge& e) { return e.second; });
+
+            std::vector<typename Graph<T>::RemoveEdgesReport> partial(shard_count());
+            default_thread_pool().run(shard_count(), [&](usize s, usize) {
+                const auto& group = groups[s];
+                auto& r = partial[s];
+                std::vector<GraphIndex> targets;
+                for (usize i = 0; i < group.size();)
+                {
+                    const GraphIndex from = group[i].first;
+                    usize end = i;
+                    while (end < group.size() && group[end].first == from) ++end;
+
+                    const Node* n = next.node(from);
+                    if (n == nullptr)
+                    {
+                        r.node_from_missing += end - i;
+                        i = end;
+                        continue;
+                    }
+
+                    targets.clear();
+                    for (; i < end; ++i)
+                    {
+                        const GraphIndex to = group[i].second;
+                        if (!targets.empty() && targets.back() == to) ++r.edge_missing;
+                        else if (!n->contains_edge(to)) ++r.edge_missing;
+                        else targets.push_back(to);
+                    }
+                    if (targets.empty()) continue;
+                    writable_node(s, from).erase_neighbors(targets, edit);
+                    r.removed += targets.size();
+                }
+            });
+
+            typename Graph<T>::RemoveEdgesReport report;
+            for (const auto& r : partial) report += r;
+            return report;
+        }
+
+        // Erases the nodes, then sweeps every shard in parallel for edges into
+        // them; only nodes and blocks that actually lose an edge are copied.
+        usize remove_nodes(std::span<const GraphIndex> idxs)
+        {
+            std::vector<GraphIndex> gone;
+            for (GraphIndex idx : idxs)
+            {
+                const u64 key = hash_int(idx);
+                if (next.m_shards[next.shard_of(key)].erase(key, edit)) gone.push_back(idx);
+            }
+            if (gone.empty()) return 0;
+            std::ranges::sort(gone);
+
+            const auto is_gone = [&](GraphIndex nb) { return std::ranges::binary_search(gone, nb); };
+            default_thread_pool().run(shard_count(), [&](usize s, usize) {
+                std::vector<GraphIndex> hit;
+                next.m_shards[s].for_each([&](const Node& node) {
+                    bool any = false;
+                    node.for_each_run([&](std::span<const GraphIndex> targets, std::span<const EdgeWeight>) {
+                        any = any || std::ranges::any_of(targets, is_gone);
+                    });
+                    if (any) hit.push_back(node.get_idx());
+                });
+                for (GraphIndex idx : hit) (void)writable_node(s, idx).erase_neighbors_if(is_gone, edit);
+            });
+            return gone.size();
+        }
+
+        bool add_node(GraphIndex idx, const T& value)
+        {
+            const u64 key = hash_int(idx);
+            auto& shard = next.m_shards[next.shard_of(key)];
+            if (shard.find(key) != nullptr) return false;
+            shard.insert(key, std::make_shared<Node>(value, idx, edit), edit);
+            return true;
+        }
+
+        // Existence checks happen up front on one thread, so the parallel
+        // phase only ever reads and writes its own shard.
+        typename Graph<T>::AddEdgesReport add_edges(std::span<const WeightedEdge> edges)
+        {
+            typename Graph<T>::AddEdgesReport report;
+            std::vector<WeightedEdge> valid;
+            valid.reserve(edges.size());
+            for (const WeightedEdge& e : edges)
+            {
+                if (e.from == e.to) ++report.self_loop;
+                else if (next.node(e.from) == nullptr) ++report.node_from_missing;
+                else if (next.node(e.to) == nullptr) ++report.node_to_missing;
+                else valid.push_back(e);
+            }
+
+            const auto groups = by_shard(std::span<const WeightedEdge>{valid},
+                                         [](const WeightedEdge& e) { return e.from; },
+                                         [](const WeightedEdge& e) { return e.to; });
+
+            std::vector<typename Graph<T>::AddEdgesReport> partial(shard_count());
+            default_thread_pool().run(shard_count(), [&](usize s, usize) {
+                const auto& group = groups[s];
+                auto& r = partial[s];
+                std::vector<GraphIndex> targets;
+                std::vector<EdgeWeight> weights;
+                for (usize i = 0; i < group.size();)
+                {
+                    const GraphIndex from = group[i].from;
+                    const Node& current = *next.node(from);
+                    targets.clear();
+                    weights.clear();
+                    for (; i < group.size() && group[i].from == from; ++i)
+                    {
+                        const GraphIndex to = group[i].to;
+                        if ((!targets.empty() && targets.back() == to) || current.contains_edge(to)) ++r.edge_exists;
+                        else
+                        {
+                            targets.push_back(to);
+                            weights.push_back(group[i].weight);
+                        }
+                    }
+                    if (targets.empty()) continue;
+                    writable_node(s, from).merge_neighbors(targets, weights, edit);
+                    r.added += targets.size();
+                }
+            });
+
+            for (const auto& r : partial) report += r;
+            return report;
+        }
+    };
+
+    std::mutex m_write;
+    u64 m_edits = 0;
+    std::atomic<std::shared_ptr<const GraphSnapshot<T>>> m_current;
+};
+} // namespace dsalgo
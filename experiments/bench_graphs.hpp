@@ -0,0 +1,110 @@
+// experiments/bench_graphs.hpp
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "types.hpp"
+
+namespace dsalgo::bench
+{
+struct WeightedArc
+{
+    VertexId from;
+    VertexId to;
+    EdgeWeight weight;
+};
+
+// Sorts, drops self-loops and keeps the first weight of repeated arcs (see
+// EdgeWeight).
+inline CsrAdjacency to_csr(usize n, std::vector<WeightedArc> arcs)
+{
+    std::ranges::stable_sort(arcs, {}, [](const WeightedArc& a) { return std::pair{a.from, a.to}; });
+    CsrAdjacency adj;
+    adj.offsets.assign(n + 1, 0);
+    adj.edges.reserve(arcs.size());
+    adj.weights.reserve(arcs.size());
+    for (usize i = 0; i < arcs.size(); ++i)
+    {
+        const WeightedArc& a = arcs[i];
+        if (a.from == a.to) continue;
+        if (i > 0 && arcs[i - 1].from == a.from && arcs[i - 1].to == a.to) continue;
+        adj.edges.push_back(a.to);
+        adj.weights.push_back(a.weight);
+        ++adj.offsets[a.from + 1];
+    }
+    for (usize v = 0; v < n; ++v) adj.offsets[v + 1] += adj.offsets[v];
+    return adj;
+}
+
+// Road-like: a width x height grid with both directions of every street,
+// bounded degree and large diameter.
+inline CsrAdjacency grid_graph(u32 width, u32 height, EdgeWeight max_weight, u64 seed)
+{
+    std::mt19937_64 rng{seed};
+    std::uniform_int_distribution<EdgeWeight> weight{1, max_weight};
+    std::vector<WeightedArc> arcs;
+    arcs.reserve(usize{4} * width * height);
+
+    const auto id = [width](u32 x, u32 y) { return y * width + x; };
+    for (u32 y = 0; y < height; ++y)
+    {
+        for (u32 x = 0; x < width; ++x)
+        {
+            if (x + 1 < width)
+            {
+                const EdgeWeight w = weight(rng);
+                arcs.push_back({id(x, y), id(x + 1, y), w});
+                arcs.push_back({id(x + 1, y), id(x, y), w});
+            }
+            if (y + 1 < height)
+            {
+                const EdgeWeight w = weight(rng);
+                arcs.push_back({id(x, y), id(x, y + 1), w});
+                arcs.push_back({id(x, y + 1), id(x, y), w});
+            }
+        }
+    }
+    return to_csr(usize{width} * height, std::move(arcs));
+}
+
+// Power-law: R-MAT with the Graph500 quadrant probabilities, 2^scale
+// vertices and edge_factor * 2^scale arcs before deduplication.
+inline CsrAdjacency rmat_graph(u32 scale, u32 edge_factor, EdgeWeight max_weight, u64 seed)
+{
+    constexpr double a = 0.57, b = 0.19, c = 0.19;
+    std::mt19937_64 rng{seed};
+    std::uniform_real_distribution<double> coin{0.0, 1.0};
+    std::uniform_int_distribution<EdgeWeight> weight{1, max_weight};
+
+    const usize n = usize{1} << scale;
+    std::vector<WeightedArc> arcs(n * edge_factor);
+    for (WeightedArc& arc : arcs)
+    {
+        VertexId from = 0;
+        VertexId to = 0;
+        for (u32 bit = 0; bit < scale; ++bit)
+        {
+            const double p = coin(rng);
+            const VertexId right = (p >= a && p < a + b) || p >= a + b + c;
+            const VertexId down = p >= a + b;
+            from |= down << bit;
+            to |= right << bit;
+        }
+        arc = {from, to, weight(rng)};
+    }
+    return to_csr(n, std::move(arcs));
+}
+
+template <typename F>
+double time_ms(F&& f)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    f();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+} // namespace dsalgo::bench
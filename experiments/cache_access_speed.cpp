@@ -1,17 +1,43 @@
 // cache_access_speed.cpp
+//
+// Usage: cache_access_speed [latency|mlp|bandwidth|threads|all]
+//   latency    single pointer chase over growing working sets (default; the
+//              CSV feeds cache_access_speed_plotter.py)
+//   mlp        K independent chases interleaved: how many misses the core
+//              keeps in flight at each level
+//   bandwidth  sequential read / write / copy, plain and streaming stores
+//   threads    chase and bandwidth on 1..N threads pinned one per physical
+//              core, per-thread working sets in cache and in DRAM
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <format>
 #include <numeric>
 #include <print>
 #include <random>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include "cpu_topology.hpp"
+
+#if defined(__SSE2__) && defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 using u64 = std::uint64_t;
 using u32 = std::uint32_t;
 
@@ -107,6 +133,22 @@ struct RunConfig
     int extra_den = 16;
     int extra_num_lo = 12;
     int extra_num_hi = 20;
+
+    // mlp: chains per run, and working sets spread over the hierarchy.
+    std::vector<std::size_t> mlp_chains = {1, 2, 4, 8, 16, 32};
+    std::vector<u64> mlp_sizes = {32ULL * 1024, 512ULL * 1024, 8ULL * 1024 * 1024, 128ULL * 1024 * 1024};
+
+    // bandwidth / threads: bytes each thread moves per trial (whole passes
+    // over its working set, at least one).
+    u64 bw_bytes_per_trial = 256ULL * 1024 * 1024;
+    int trials_bw = 5;
+
+    // threads: per-thread working sets, one private-cache sized and one well
+    // past the last level. Buffers are per thread, so DRAM use is
+    // threads * 2 * thread_dram_ws.
+    u64 thread_cache_ws = 64ULL * 1024;
+    u64 thread_dram_ws = 32ULL * 1024 * 1024;
+    std::size_t thread_mlp_chains = 16;
 };
 
 static void touch_prefix_pages(std::vector<std::byte>& buf, u64 ws_bytes, std::size_t page_size)
@@ -117,13 +159,15 @@ static void touch_prefix_pages(std::vector<std::byte>& buf, u64 ws_bytes, std::s
     escape(static_cast<u64>(sink));
 }
 
-static void build_chain_prefix(std::vector<std::byte>& buf,
-                               u64 ws_bytes,
-                               u64 stride,
-                               std::mt19937_64& rng)
+// Links the nodes of the first ws_bytes into one random cycle and returns
+// the node order along it.
+static std::vector<u32> build_chain_prefix(std::vector<std::byte>& buf,
+                                           u64 ws_bytes,
+                                           u64 stride,
+                                           std::mt19937_64& rng)
 {
     const std::size_t n_nodes = static_cast<std::size_t>(ws_bytes / stride);
-    if (n_nodes < 2) return;
+    if (n_nodes < 2) return {};
 
     std::vector<u32> perm(n_nodes);
     std::iota(perm.begin(), perm.end(), 0U);
@@ -135,6 +179,7 @@ static void build_chain_prefix(std::vector<std::byte>& buf,
         store_u32(buf.data() + static_cast<std::size_t>(from) * stride, to);
     }
     store_u32(buf.data() + static_cast<std::size_t>(perm.back()) * stride, perm[0]);
+    return perm;
 }
 
 static double time_chase_ns_per_access(const std::vector<std::byte>& buf,
@@ -228,10 +273,8 @@ static void add_granular_around(std::vector<u64>& sizes,
     }
 }
 
-int main()
+static void run_latency_sweep(const RunConfig& cfg)
 {
-    RunConfig cfg;
-
     const u64 stride = std::max<u64>(cfg.stride_bytes, static_cast<u64>(sizeof(u32)));
     const u64 min_ws = std::max<u64>(cfg.min_ws, 2 * stride);
     const u64 max_ws = align_down(cfg.max_ws, stride);
@@ -352,6 +395,445 @@ int main()
     for (const auto& [ws, p] : results) {
         std::println("{},{:.6f},{:.6f}", ws, p.warm, p.cold);
     }
+}
+
+// ---------------------------------------------------------------------------
+// Memory-level parallelism: K chains over the same cycle, started n/K nodes
+// apart and advanced round-robin. Each chain is still serially dependent,
+// but the K loads of one round are independent, so the core can overlap
+// their misses. ns/access at K over ns/access at 1 is the MLP it achieves.
+
+template <std::size_t K>
+static void chase_chains(const std::byte* base, u64 stride, std::array<u32, K>& cursors, std::size_t rounds)
+{
+    for (std::size_t i = 0; i < rounds; ++i) {
+        for (std::size_t k = 0; k < K; ++k)
+            cursors[k] = load_u32(base + static_cast<std::size_t>(cursors[k]) * stride);
+    }
+}
+
+// Runs `accesses` loads split over `chains` chains; returns the accesses done.
+template <std::size_t K>
+static u64 chase_k(const std::vector<std::byte>& buf, const std::vector<u32>& order, u64 stride,
+                   std::size_t accesses)
+{
+    std::array<u32, K> cursors{};
+    for (std::size_t k = 0; k < K; ++k)
+        cursors[k] = order[k * order.size() / K];
+    const std::size_t rounds = std::max<std::size_t>(1, accesses / K);
+    chase_chains(buf.data(), stride, cursors, rounds);
+
+    u64 sink = 0;
+    for (u32 c : cursors)
+        sink += c;
+    escape(sink);
+    return static_cast<u64>(rounds) * K;
+}
+
+static u64 chase(const std::vector<std::byte>& buf, const std::vector<u32>& order, u64 stride,
+                 std::size_t chains, std::size_t accesses)
+{
+    switch (chains) {
+    case 1: return chase_k<1>(buf, order, stride, accesses);
+    case 2: return chase_k<2>(buf, order, stride, accesses);
+    case 4: return chase_k<4>(buf, order, stride, accesses);
+    case 8: return chase_k<8>(buf, order, stride, accesses);
+    case 16: return chase_k<16>(buf, order, stride, accesses);
+    case 32: return chase_k<32>(buf, order, stride, accesses);
+    default: throw std::invalid_argument(std::format("unsupported chain count {}", chains));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Sequential bandwidth over u64 words.
+
+#if defined(__SSE2__) && defined(__x86_64__)
+static constexpr bool has_streaming_stores = true;
+#else
+static constexpr bool has_streaming_stores = false;
+#endif
+
+// Non-temporal store: goes around the caches and skips the read-for-ownership
+// a normal store miss does, so writing a line moves it over the bus once
+// instead of twice. Plain store where the target has no such instruction.
+static inline void stream_store(u64* p, u64 v)
+{
+#if defined(__SSE2__) && defined(__x86_64__)
+    _mm_stream_si64(reinterpret_cast<long long*>(p), static_cast<long long>(v));
+#else
+    *p = v;
+#endif
+}
+
+static inline void stream_fence()
+{
+#if defined(__SSE2__) && defined(__x86_64__)
+    _mm_sfence();
+#endif
+}
+
+enum class Kernel
+{
+    Read,
+    Write,
+    Copy,
+    StreamWrite,
+    StreamCopy,
+};
+
+static constexpr std::array<Kernel, 5> all_kernels = {
+    Kernel::Read, Kernel::Write, Kernel::Copy, Kernel::StreamWrite, Kernel::StreamCopy};
+
+static const char* kernel_name(Kernel k)
+{
+    switch (k) {
+    case Kernel::Read: return "read";
+    case Kernel::Write: return "write";
+    case Kernel::Copy: return "copy";
+    case Kernel::StreamWrite: return "nt-write";
+    case Kernel::StreamCopy: return "nt-copy";
+    }
+    return "?";
+}
+
+static bool kernel_reads(Kernel k) { return k == Kernel::Read || k == Kernel::Copy || k == Kernel::StreamCopy; }
+static bool kernel_writes(Kernel k) { return k != Kernel::Read; }
+
+// One pass over n words; returns the bytes moved (a copy counts its read and
+// its write; the read-for-ownership of plain stores is not counted).
+static u64 run_kernel(Kernel k, const u64* src, u64* dst, std::size_t n, u64 pass)
+{
+    switch (k) {
+    case Kernel::Read: {
+        u64 s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            s0 += src[i];
+            s1 += src[i + 1];
+            s2 += src[i + 2];
+            s3 += src[i + 3];
+        }
+        for (; i < n; ++i)
+            s0 += src[i];
+        escape(s0 + s1 + s2 + s3);
+        return n * sizeof(u64);
+    }
+    case Kernel::Write:
+        for (std::size_t i = 0; i < n; ++i)
+            dst[i] = pass;
+        escape(dst[n / 2]);
+        return n * sizeof(u64);
+    case Kernel::Copy:
+        std::memcpy(dst, src, n * sizeof(u64));
+        escape(dst[n / 2]);
+        return 2 * n * sizeof(u64);
+    case Kernel::StreamWrite:
+        for (std::size_t i = 0; i < n; ++i)
+            stream_store(dst + i, pass);
+        stream_fence();
+        return n * sizeof(u64);
+    case Kernel::StreamCopy:
+        for (std::size_t i = 0; i < n; ++i)
+            stream_store(dst + i, src[i]);
+        stream_fence();
+        return 2 * n * sizeof(u64);
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Pinned threads.
+
+#if defined(__linux__)
+static constexpr bool can_pin = true;
+#else
+static constexpr bool can_pin = false; // macOS only takes affinity hints
+#endif
+
+// True if the calling thread is now bound to `cpu`.
+static bool pin_current_thread(int cpu)
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<std::size_t>(cpu), &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// A measurement and whether every thread behind it was pinned; unpinned
+// runs are marked with '*' in the tables.
+struct Sample
+{
+    double value = 0.0;
+    bool pinned = true;
+};
+
+static const char* pin_mark(bool pinned) { return pinned || !can_pin ? " " : "*"; }
+
+// Runs `threads` copies of a test, thread t pinned to cpus[t]. Each thread
+// builds and first-touches its own state (so it lands on that thread's NUMA
+// node) before the first trial, and all threads start every trial together
+// at a barrier. Returns the median over trials of the slowest thread's time
+// in seconds, what one thread's measure() call reported, and whether every
+// thread was pinned.
+struct PinnedRun
+{
+    double secs = 0.0;
+    u64 work = 0;
+    bool pinned = true;
+};
+
+template <typename Prepare, typename Measure>
+static PinnedRun run_pinned(std::size_t threads,
+                                         const std::vector<int>& cpus,
+                                         int trials,
+                                         bool skip_first,
+                                         Prepare prepare,
+                                         Measure measure)
+{
+    const std::size_t n_trials = static_cast<std::size_t>(trials);
+    std::vector<std::vector<double>> secs(n_trials, std::vector<double>(threads));
+    std::vector<u64> work(threads);
+    std::barrier sync(static_cast<std::ptrdiff_t>(threads));
+    std::atomic<bool> pinned{true};
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    for (std::size_t t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            if (!pin_current_thread(cpus[t % cpus.size()]))
+                pinned.store(false, std::memory_order_relaxed);
+            auto state = prepare();
+            for (std::size_t trial = 0; trial < n_trials; ++trial) {
+                sync.arrive_and_wait();
+                const auto t0 = std::chrono::steady_clock::now();
+                work[t] = measure(state);
+                const auto t1 = std::chrono::steady_clock::now();
+                secs[trial][t] = std::chrono::duration<double>(t1 - t0).count();
+            }
+        });
+    }
+    for (auto& th : pool)
+        th.join();
+
+    std::vector<double> samples;
+    for (std::size_t trial = (skip_first && n_trials > 1) ? 1 : 0; trial < n_trials; ++trial)
+        samples.push_back(*std::max_element(secs[trial].begin(), secs[trial].end()));
+    return {median(samples), work[0], pinned.load()};
+}
+
+struct ChaseState
+{
+    std::vector<std::byte> buf;
+    std::vector<u32> order;
+};
+
+// ns per access of `chains` interleaved chases over ws bytes on each thread.
+static Sample chase_ns(const RunConfig& cfg, const std::vector<int>& cpus, std::size_t threads, u64 ws,
+                       std::size_t chains, u64 stride)
+{
+    const auto prepare = [&] {
+        ChaseState s;
+        s.buf.resize(static_cast<std::size_t>(ws));
+        std::mt19937_64 rng(123456789);
+        s.order = build_chain_prefix(s.buf, ws, stride, rng);
+        touch_prefix_pages(s.buf, ws, cfg.page_size);
+        chase(s.buf, s.order, stride, chains, cfg.warmup);
+        return s;
+    };
+    const auto measure = [&](ChaseState& s) { return chase(s.buf, s.order, stride, chains, cfg.iters); };
+    const auto run = run_pinned(threads, cpus, cfg.trials_warm, cfg.skip_first, prepare, measure);
+    return {run.secs * 1e9 / static_cast<double>(run.work), run.pinned};
+}
+
+struct StreamState
+{
+    std::vector<u64> src;
+    std::vector<u64> dst;
+};
+
+// Aggregate GB/s of `threads` threads each running k over its own ws bytes.
+static Sample bandwidth_gbs(const RunConfig& cfg, const std::vector<int>& cpus, std::size_t threads, u64 ws,
+                            Kernel k)
+{
+    const std::size_t n = static_cast<std::size_t>(ws / sizeof(u64));
+    const u64 passes = std::max<u64>(1, cfg.bw_bytes_per_trial / ws);
+    const auto prepare = [&] {
+        StreamState s;
+        // Resizing writes every word, which also faults the pages in.
+        if (kernel_reads(k)) s.src.assign(n, 1);
+        if (kernel_writes(k)) s.dst.assign(n, 0);
+        return s;
+    };
+    const auto measure = [&](StreamState& s) {
+        u64 bytes = 0;
+        for (u64 p = 0; p < passes; ++p)
+            bytes += run_kernel(k, s.src.data(), s.dst.data(), n, p);
+        return bytes;
+    };
+    const auto run = run_pinned(threads, cpus, cfg.trials_bw, cfg.skip_first, prepare, measure);
+    return {static_cast<double>(run.work) * static_cast<double>(threads) / run.secs / 1e9, run.pinned};
+}
+
+static u64 chase_stride(const RunConfig& cfg) { return std::max<u64>(cfg.stride_bytes, static_cast<u64>(sizeof(u32))); }
+
+static void print_pin_note(bool any_unpinned)
+{
+    if (any_unpinned)
+        std::println("* pinning failed for this run; its threads may have moved between CPUs");
+}
+
+static void run_mlp_sweep(const RunConfig& cfg, const std::vector<int>& cpus)
+{
+    const u64 stride = chase_stride(cfg);
+    std::println("MLP: {} accesses/trial split over K chains, stride {}, median of {} trials",
+                 cfg.iters, format_bytes(stride), cfg.trials_warm);
+    std::println("");
+
+    std::string header = std::format("{:>12} |", "WorkingSet");
+    for (std::size_t k : cfg.mlp_chains)
+        header += std::format(" {:>8} |", std::format("K={}", k));
+    std::println("{} {:>8}", header, "MLP");
+
+    std::vector<std::string> csv;
+    bool any_unpinned = false;
+    for (u64 size : cfg.mlp_sizes) {
+        const u64 ws = align_down(size, stride);
+        std::string line = std::format("{:>12} |", format_bytes(ws));
+        double single = 0.0;
+        double best = 0.0;
+        for (std::size_t k : cfg.mlp_chains) {
+            const auto [ns, pinned] = chase_ns(cfg, cpus, 1, ws, k, stride);
+            any_unpinned = any_unpinned || !pinned;
+            if (k == 1) single = ns;
+            if (single > 0.0) best = std::max(best, single / ns);
+            line += std::format(" {:>8.3f}{}|", ns, pin_mark(pinned));
+            csv.push_back(std::format("{},{},{:.6f}", ws, k, ns));
+        }
+        std::println("{} {:>8.2f}", line, best);
+    }
+    print_pin_note(any_unpinned);
+
+    std::println("");
+    std::println("CSV (bytes,chains,ns_per_access):");
+    for (const auto& row : csv)
+        std::println("{}", row);
+}
+
+static void run_bandwidth_sweep(const RunConfig& cfg, const std::vector<int>& cpus)
+{
+    std::println("Bandwidth: {}/trial per kernel, median of {} trials, GB/s = 1e9 B/s{}",
+                 format_bytes(cfg.bw_bytes_per_trial), cfg.trials_bw,
+                 has_streaming_stores ? "" : " (no streaming stores here: nt-* use plain stores)");
+    std::println("");
+
+    std::string header = std::format("{:>12} |", "WorkingSet");
+    for (Kernel k : all_kernels)
+        header += std::format(" {:>9} |", kernel_name(k));
+    std::println("{}", header);
+
+    std::vector<std::string> csv;
+    bool any_unpinned = false;
+    for (u64 ws = std::max<u64>(cfg.min_ws, 64); ws <= cfg.max_ws; ws *= 2) {
+        std::string line = std::format("{:>12} |", format_bytes(ws));
+        std::string row = std::format("{}", ws);
+        for (Kernel k : all_kernels) {
+            const auto [gbs, pinned] = bandwidth_gbs(cfg, cpus, 1, ws, k);
+            any_unpinned = any_unpinned || !pinned;
+            line += std::format(" {:>9.2f}{}|", gbs, pin_mark(pinned));
+            row += std::format(",{:.3f}", gbs);
+        }
+        std::println("{}", line);
+        csv.push_back(row);
+    }
+    print_pin_note(any_unpinned);
+
+    std::println("");
+    std::println("CSV (bytes,read_gbs,write_gbs,copy_gbs,stream_write_gbs,stream_copy_gbs):");
+    for (const auto& row : csv)
+        std::println("{}", row);
+}
+
+static std::vector<std::size_t> thread_counts(std::size_t max_threads)
+{
+    std::vector<std::size_t> counts;
+    for (std::size_t t = 1; t < max_threads; t *= 2)
+        counts.push_back(t);
+    counts.push_back(max_threads);
+    return counts;
+}
+
+// Threads go one per physical core, so SMT siblings never share a core's
+// caches and load ports; without topology they go one per hardware thread.
+static void run_thread_sweep(const RunConfig& cfg, const CpuList& cpus)
+{
+    const u64 stride = chase_stride(cfg);
+    const char* unit = cpus.topology_known ? "cores" : "hw threads";
+    if (cpus.topology_known)
+        std::println("Threads: 1..{} on distinct physical cores ({} hardware threads allowed), {}", cpus.cores,
+                     cpus.cpus.size(), can_pin ? "pinned one per core" : "not pinned (no affinity API on this platform)");
+    else
+        std::println("Threads: 1..{} hardware threads (core topology unknown; SMT siblings may share a core), {}",
+                     cpus.cores, can_pin ? "pinned one per hardware thread" : "not pinned (no affinity API on this platform)");
+    std::println("  chase: ns/access per thread; bandwidth: aggregate GB/s over all threads");
+    std::println("");
+
+    std::vector<std::string> csv;
+    bool any_unpinned = false;
+    for (u64 ws : {align_down(cfg.thread_cache_ws, stride), align_down(cfg.thread_dram_ws, stride)}) {
+        std::println("Per-thread working set {}", format_bytes(ws));
+        std::string header = std::format("{:>10} | {:>9} | {:>9} |", unit, "chase",
+                                         std::format("chase x{}", cfg.thread_mlp_chains));
+        for (Kernel k : all_kernels)
+            header += std::format(" {:>9} |", kernel_name(k));
+        std::println("{}", header);
+
+        for (std::size_t threads : thread_counts(cpus.cores)) {
+            const Sample lat = chase_ns(cfg, cpus.cpus, threads, ws, 1, stride);
+            const Sample mlp = chase_ns(cfg, cpus.cpus, threads, ws, cfg.thread_mlp_chains, stride);
+            bool pinned = lat.pinned && mlp.pinned;
+            std::string line = std::format("{:>10} | {:>9.3f}{}| {:>9.3f}{}|", threads, lat.value, pin_mark(lat.pinned),
+                                           mlp.value, pin_mark(mlp.pinned));
+            std::string row = std::format("{},{},{:.6f},{:.6f}", threads, ws, lat.value, mlp.value);
+            for (Kernel k : all_kernels) {
+                const Sample gbs = bandwidth_gbs(cfg, cpus.cpus, threads, ws, k);
+                pinned = pinned && gbs.pinned;
+                line += std::format(" {:>9.2f}{}|", gbs.value, pin_mark(gbs.pinned));
+                row += std::format(",{:.3f}", gbs.value);
+            }
+            any_unpinned = any_unpinned || !pinned;
+            std::println("{}", line);
+            csv.push_back(std::format("{},{}", row, pinned ? 1 : 0));
+        }
+        std::println("");
+    }
+    print_pin_note(any_unpinned);
 
+    std::println("CSV (threads,bytes_per_thread,chase_ns,mlp_chase_ns,read_gbs,write_gbs,copy_gbs,"
+                 "stream_write_gbs,stream_copy_gbs,pinned):");
+    for (const auto& row : csv)
+        std::println("{}", row);
+}
+
+int main(int argc, char** argv)
+{
+    const std::string_view mode = argc > 1 ? std::string_view{argv[1]} : std::string_view{"latency"};
+    const bool all = mode == "all";
+    if (!all && mode != "latency" && mode != "mlp" && mode != "bandwidth" && mode != "threads") {
+        std::println(stderr, "usage: {} [latency|mlp|bandwidth|threads|all]", argv[0]);
+        return 1;
+    }
+
+    const RunConfig cfg;
+    const CpuList cpus = allowed_cpus();
+
+    if (all || mode == "latency") run_latency_sweep(cfg);
+    if (all || mode == "mlp") run_mlp_sweep(cfg, cpus.cpus);
+    if (all || mode == "bandwidth") run_bandwidth_sweep(cfg, cpus.cpus);
+    if (all || mode == "threads") run_thread_sweep(cfg, cpus);
     return 0;
-}
\ No newline at end of file
+}
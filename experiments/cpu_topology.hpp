@@ -0,0 +1,72 @@
+// experiments/cpu_topology.hpp
+//
+// Which CPUs the benchmarks may use and which of them share a physical core,
+// read from the affinity mask and sysfs. Shared by cache_access_speed and
+// gemm_bench.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <fstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+// CPUs this process may run on, one hardware thread of every physical core
+// first (cpus[0 .. cores)), then the remaining SMT siblings. Cores are told
+// apart by the (package, core) ids in sysfs, since sibling numbering varies
+// between machines; if those are unreadable every CPU counts as a core and
+// `topology_known` is false.
+struct CpuList
+{
+    std::vector<int> cpus;
+    std::size_t cores = 0;
+    bool topology_known = false;
+};
+
+inline bool read_topology_id(int cpu, const char* name, long& id)
+{
+    std::ifstream in(std::format("/sys/devices/system/cpu/cpu{}/topology/{}", cpu, name));
+    return static_cast<bool>(in >> id);
+}
+
+inline CpuList allowed_cpus()
+{
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (std::size_t c = 0; c < CPU_SETSIZE; ++c)
+            if (CPU_ISSET(c, &set)) cpus.push_back(static_cast<int>(c));
+    }
+#endif
+    if (cpus.empty()) {
+        const unsigned n = std::max(1U, std::thread::hardware_concurrency());
+        for (unsigned c = 0; c < n; ++c)
+            cpus.push_back(static_cast<int>(c));
+    }
+
+    std::vector<std::pair<long, long>> seen;
+    std::vector<int> first;
+    std::vector<int> siblings;
+    for (int cpu : cpus) {
+        std::pair<long, long> core;
+        if (!read_topology_id(cpu, "physical_package_id", core.first) || !read_topology_id(cpu, "core_id", core.second))
+            return {cpus, cpus.size(), false};
+        if (std::find(seen.begin(), seen.end(), core) == seen.end()) {
+            seen.push_back(core);
+            first.push_back(cpu);
+        } else {
+            siblings.push_back(cpu);
+        }
+    }
+    const std::size_t cores = first.size();
+    first.insert(first.end(), siblings.begin(), siblings.end());
+    return {first, cores, true};
+}
@@ -0,0 +1,83 @@
+// gemm_bench.cpp
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <print>
+#include <string_view>
+#include <vector>
+
+#include "cpu_topology.hpp"
+#include "gemm.hpp"
+#include "parallel.hpp"
+
+using namespace dsalgo;
+
+static double median(std::vector<double> xs)
+{
+    std::ranges::sort(xs);
+    return xs[xs.size() / 2];
+}
+
+template <typename F>
+static double time_s(F&& f)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    f();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+template <typename T>
+static void run(std::string_view name, usize n, const std::vector<usize>& thread_counts)
+{
+    std::vector<T> a(n * n);
+    std::vector<T> b(n * n);
+    std::vector<T> c(n * n);
+    for (usize i = 0; i < n * n; ++i)
+    {
+        a[i] = static_cast<T>(i % 17) / T(17);
+        b[i] = static_cast<T>(i % 13) / T(13);
+    }
+    const double flops = 2.0 * static_cast<double>(n) * static_cast<double>(n) * static_cast<double>(n);
+
+    std::println("{} {}x{}:", name, n, n);
+    if (n <= 1024)
+    {
+        const double s = time_s([&] { gemm_naive(n, n, n, a.data(), n, b.data(), n, c.data(), n); });
+        std::println("  naive        {:>8.2f} GFLOP/s", flops / s * 1e-9);
+    }
+
+    double single = 0.0;
+    for (usize threads : thread_counts)
+    {
+        ThreadPool pool{threads};
+        std::vector<double> runs;
+        for (int i = 0; i < 3; ++i)
+        {
+            runs.push_back(time_s([&] { gemm_parallel(n, n, n, a.data(), n, b.data(), n, c.data(), n, false, pool); }));
+        }
+        const double gflops = flops / median(runs) * 1e-9;
+        if (threads == 1) single = gflops;
+        std::println("  {:>3} threads  {:>8.2f} GFLOP/s  ({:>5.2f}x)", threads, gflops, single > 0 ? gflops / single : 1.0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // Optional argument: matrix side (default 1024).
+    const usize n = argc > 1 ? static_cast<usize>(std::atoll(argv[1])) : 1024;
+
+    // 1, 2, 4, ... up to the physical core count, which is always included.
+    // SMT siblings share a core's FMA units, so they add no GEMM throughput.
+    const CpuList cpus = allowed_cpus();
+    const usize max_threads = cpus.cores;
+    std::println("{} {} ({} hardware threads allowed)", max_threads,
+                 cpus.topology_known ? "physical cores" : "CPUs, topology unknown", cpus.cpus.size());
+    std::vector<usize> thread_counts;
+    for (usize t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    run<f32>("f32", n, thread_counts);
+    run<f64>("f64", n, thread_counts);
+    return 0;
+}
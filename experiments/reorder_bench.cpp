@@ -0,0 +1,90 @@
+// reorder_bench.cpp
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <print>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "bench_graphs.hpp"
+#include "bfs.hpp"
+#include "pagerank.hpp"
+#include "parallel.hpp"
+#include "reorder.hpp"
+
+using namespace dsalgo;
+
+static double median(std::vector<double> xs)
+{
+    std::ranges::sort(xs);
+    return xs[xs.size() / 2];
+}
+
+// Scatters the ids the way user-supplied GraphIndex values usually are.
+static Permutation random_order(usize n, u64 seed)
+{
+    std::vector<VertexId> order(n);
+    std::iota(order.begin(), order.end(), VertexId{0});
+    std::shuffle(order.begin(), order.end(), std::mt19937_64{seed});
+    return Permutation::from_order(std::move(order));
+}
+
+static void measure(std::string_view name, const CsrAdjacency& g, VertexId source, double baseline_bfs,
+                    double baseline_pr, double* bfs_out = nullptr, double* pr_out = nullptr)
+{
+    constexpr int repeats = 5;
+    const CsrAdjacency in = g.transposed();
+
+    std::vector<double> bfs_ms;
+    std::vector<double> pr_ms;
+    for (int i = 0; i < repeats; ++i)
+    {
+        bfs_ms.push_back(bench::time_ms([&] { (void)bfs(g, in, source); }));
+        pr_ms.push_back(bench::time_ms([&] {
+            (void)pagerank<float>(g, in, PageRankOptions{.tolerance = 0.0, .max_iterations = 10});
+        }));
+    }
+    const double b = median(bfs_ms);
+    const double p = median(pr_ms);
+    if (bfs_out) *bfs_out = b;
+    if (pr_out) *pr_out = p;
+    std::println("  {:<10} bfs {:>9.2f} ms ({:>4.2f}x)   pagerank x10 {:>9.2f} ms ({:>4.2f}x)", name, b,
+                 baseline_bfs > 0 ? baseline_bfs / b : 1.0, p, baseline_pr > 0 ? baseline_pr / p : 1.0);
+}
+
+static void run(std::string_view name, const CsrAdjacency& generated)
+{
+    const auto scattered = permute(generated, random_order(generated.vertex_count(), 42));
+    std::println("{}: {} vertices, {} edges", name, scattered.vertex_count(), scattered.edge_count());
+
+    // BFS from the highest-degree vertex so every ordering explores the same component.
+    VertexId hub = 0;
+    for (VertexId v = 0; v < scattered.vertex_count(); ++v)
+    {
+        if (scattered.degree(v) > scattered.degree(hub)) hub = v;
+    }
+
+    double base_bfs = 0.0;
+    double base_pr = 0.0;
+    measure("scattered", scattered, hub, 0.0, 0.0, &base_bfs, &base_pr);
+
+    const auto with = [&](std::string_view label, const Permutation& p) {
+        measure(label, permute(scattered, p), p.old_to_new[hub], base_bfs, base_pr);
+    };
+    with("degree", degree_order(scattered));
+    with("rcm", rcm_order(scattered, scattered.transposed()));
+    with("bfs", bfs_order(scattered, hub));
+}
+
+int main(int argc, char** argv)
+{
+    // Optional argument: log2 of the vertex count (default 20).
+    const u32 scale = argc > 1 ? static_cast<u32>(std::atoi(argv[1])) : 20;
+    const u32 side = 1u << (scale / 2);
+
+    std::println("threads: {}", default_thread_pool().thread_count());
+    run("grid (road-like)", bench::grid_graph(side, side, 1, 1));
+    run("rmat (power-law)", bench::rmat_graph(scale, 16, 1, 2));
+    return 0;
+}
@@ -0,0 +1,51 @@
+// sssp_bench.cpp
+#include <algorithm>
+#include <cstdlib>
+#include <initializer_list>
+#include <print>
+#include <string_view>
+#include <vector>
+
+#include "bench_graphs.hpp"
+#include "parallel.hpp"
+#include "sssp.hpp"
+
+using namespace dsalgo;
+
+static double median(std::vector<double> xs)
+{
+    std::ranges::sort(xs);
+    return xs[xs.size() / 2];
+}
+
+static void run(std::string_view name, const CsrAdjacency& g, std::initializer_list<PathLength> deltas)
+{
+    constexpr int repeats = 5;
+    std::println("{}: {} vertices, {} edges", name, g.vertex_count(), g.edge_count());
+
+    std::vector<double> times;
+    SsspResult reference;
+    for (int i = 0; i < repeats; ++i) times.push_back(bench::time_ms([&] { reference = dijkstra(g, 0); }));
+    std::println("  {:<24} {:>10.2f} ms", "dijkstra (radix heap)", median(times));
+
+    for (PathLength delta : deltas)
+    {
+        times.clear();
+        SsspResult r;
+        for (int i = 0; i < repeats; ++i) times.push_back(bench::time_ms([&] { r = delta_stepping(g, 0, delta); }));
+        const bool ok = r.distance == reference.distance;
+        std::println("  delta-stepping d={:<8} {:>10.2f} ms{}", delta, median(times), ok ? "" : "  MISMATCH");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // Optional argument: log2 of the vertex count (default 20).
+    const u32 scale = argc > 1 ? static_cast<u32>(std::atoi(argv[1])) : 20;
+    const u32 side = 1u << (scale / 2);
+
+    std::println("threads: {}", default_thread_pool().thread_count());
+    run("grid (road-like)", bench::grid_graph(side, side, 1000, 1), {100, 1000, 10000});
+    run("rmat (power-law)", bench::rmat_graph(scale, 16, 1000, 2), {100, 1000, 10000});
+    return 0;
+}
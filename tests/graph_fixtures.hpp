@@ -0,0 +1,121 @@
+// tests/graph_fixtures.hpp
+#pragma once
+#include "csr_graph.hpp"
+#include "types.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Deterministic generators for the graph tests, all driven by iterating
+// hash_int over a seed.
+namespace dsalgo::Test
+{
+using namespace dsalgo;
+
+inline void sort_unique(std::vector<VertexId> &list)
+{
+    std::ranges::sort(list);
+    const auto dups = std::ranges::unique(list);
+    list.erase(dups.begin(), dups.end());
+}
+
+// Builds a CsrAdjacency from neighbor lists in any order, with repeats.
+inline CsrAdjacency adjacency_from_unsorted(std::vector<std::vector<VertexId>> lists)
+{
+    for (auto &list : lists) sort_unique(list);
+    return CsrAdjacency::from_lists(lists);
+}
+
+// Sorted, duplicate-free set of up to `size` values below `range`.
+inline std::vector<VertexId> random_set(u64 &state, usize size, u64 range)
+{
+    std::vector<VertexId> s;
+    for (usize i = 0; i < size; ++i)
+    {
+        state = hash_int(state);
+        s.push_back(static_cast<VertexId>(state % range));
+    }
+    sort_unique(s);
+    return s;
+}
+
+// Fisher-Yates shuffle of 0..n-1.
+inline std::vector<VertexId> random_permutation(usize n, u64 &state)
+{
+    std::vector<VertexId> p(n);
+    for (usize i = 0; i < n; ++i) p[i] = static_cast<VertexId>(i);
+    for (usize i = n - 1; i > 0; --i)
+    {
+        state = hash_int(state);
+        std::swap(p[i], p[state % (i + 1)]);
+    }
+    return p;
+}
+
+// Random directed graph: m edges drawn with replacement, neighbor lists
+// sorted and deduplicated.
+inline CsrAdjacency random_adjacency(usize n, usize m, u64 seed)
+{
+    std::vector<std::vector<VertexId>> lists(n);
+    u64 state = seed;
+    for (usize i = 0; i < m; ++i)
+    {
+        state = hash_int(state);
+        lists[state % n].push_back(static_cast<VertexId>((state >> 32) % n));
+    }
+    return adjacency_from_unsorted(std::move(lists));
+}
+
+inline CsrAdjacency random_symmetric(usize n, usize m, u64 seed)
+{
+    return random_adjacency(n, m, seed).symmetrized();
+}
+
+// As random_adjacency, with weights drawn from [min_weight, max_weight]; the
+// smallest weight wins among repeated arcs.
+inline CsrAdjacency random_weighted(usize n, usize m, EdgeWeight min_weight, EdgeWeight max_weight, u64 seed)
+{
+    std::vector<std::vector<std::pair<VertexId, EdgeWeight>>> lists(n);
+    u64 state = seed;
+    for (usize i = 0; i < m; ++i)
+    {
+        state = hash_int(state);
+        const auto w = min_weight + static_cast<EdgeWeight>(hash_int(state) % (max_weight - min_weight + 1));
+        lists[state % n].emplace_back(static_cast<VertexId>((state >> 32) % n), w);
+    }
+    CsrAdjacency adj;
+    for (auto &list : lists)
+    {
+        std::ranges::sort(list);
+        const auto dups = std::ranges::unique(list, {}, &std::pair<VertexId, EdgeWeight>::first);
+        list.erase(dups.begin(), dups.end());
+        for (const auto &[v, w] : list)
+        {
+            adj.edges.push_back(v);
+            adj.weights.push_back(w);
+        }
+        adj.offsets.push_back(adj.edges.size());
+    }
+    return adj;
+}
+
+// Random DAG: `draws` pairs, each kept as an arc from the lower to the
+// higher position of a shuffled labelling when they differ.
+inline CsrAdjacency random_dag(usize n, usize draws, u64 seed)
+{
+    u64 state = seed;
+    const std::vector<VertexId> label = random_permutation(n, state);
+    std::vector<std::vector<VertexId>> lists(n);
+    for (usize i = 0; i < draws; ++i)
+    {
+        state = hash_int(state);
+        const usize a = state % n;
+        const usize b = (state >> 32) % n;
+        if (a < b) lists[label[a]].push_back(label[b]);
+    }
+    return adjacency_from_unsorted(std::move(lists));
+}
+
+} // namespace dsalgo::Test
@@ -0,0 +1,51 @@
+// tests/small_stack.hpp
+#pragma once
+#include "types.hpp"
+
+#include <exception>
+#include <stdexcept>
+#include <type_traits>
+
+#include <pthread.h>
+
+namespace dsalgo::Test
+{
+// Runs `fn` to completion on a thread with only `stack_bytes` of stack, so
+// code that recurses once per tree level overflows after a few thousand
+// levels instead of hiding behind the default 8 MiB. Exceptions are
+// rethrown on the calling thread.
+template <class F>
+inline void run_on_small_stack(usize stack_bytes, F &&fn)
+{
+    struct Call
+    {
+        std::remove_reference_t<F> *fn;
+        std::exception_ptr error;
+    };
+    Call call{&fn, nullptr};
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, stack_bytes);
+    pthread_t thread;
+    const int rc = pthread_create(
+        &thread, &attr,
+        [](void *arg) -> void * {
+            auto *c = static_cast<Call *>(arg);
+            try
+            {
+                (*c->fn)();
+            }
+            catch (...)
+            {
+                c->error = std::current_exception();
+            }
+            return nullptr;
+        },
+        &call);
+    pthread_attr_destroy(&attr);
+    if (rc != 0) throw std::runtime_error("pthread_create failed");
+    pthread_join(thread, nullptr);
+    if (call.error) std::rethrow_exception(call.error);
+}
+} // namespace dsalgo::Test
@@ -0,0 +1,110 @@
+// tests/test_bfs.cpp
+#include "bfs.hpp"
+#include "common.hpp"
+#include "graph_fixtures.hpp"
+#include "graph.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static std::vector<u32> queue_bfs(const CsrAdjacency& adj, VertexId source)
+{
+    std::vector<u32> dist(adj.vertex_count(), BfsResult::unreachable);
+    std::deque<VertexId> queue{source};
+    dist[source] = 0;
+    while (!queue.empty())
+    {
+        const VertexId u = queue.front();
+        queue.pop_front();
+        for (VertexId v : adj.neighbors(u))
+        {
+            if (dist[v] != BfsResult::unreachable) continue;
+            dist[v] = dist[u] + 1;
+            queue.push_back(v);
+        }
+    }
+    return dist;
+}
+
+static void expect_valid_tree(const CsrAdjacency& adj, const BfsResult& r, VertexId source)
+{
+    const auto expected = queue_bfs(adj, source);
+    EXPECT_TRUE(r.distance == expected);
+    EXPECT_EQ(r.parent[source], source);
+    for (VertexId v = 0; v < adj.vertex_count(); ++v)
+    {
+        if (!r.reached(v) || v == source)
+        {
+            EXPECT_EQ(r.parent[v] == invalid_vertex, !r.reached(v));
+            continue;
+        }
+        const VertexId p = r.parent[v];
+        EXPECT_EQ(r.distance[p] + 1, r.distance[v]);
+        EXPECT_TRUE(std::ranges::binary_search(adj.neighbors(p), v));
+    }
+}
+
+static void test_matches_queue_bfs_in_every_mode()
+{
+    constexpr u64 never = std::numeric_limits<u64>::max();
+    const auto adj = random_adjacency(5000, 20000, 7);
+    const auto in = adj.transposed();
+
+    expect_valid_tree(adj, bfs(adj, in, 0), 0);
+    expect_valid_tree(adj, bfs(adj, in, 17, BfsOptions{.direction = BfsDirection::TopDown}), 17);
+    expect_valid_tree(adj, bfs(adj, in, 17, BfsOptions{.direction = BfsDirection::BottomUp}), 17);
+    expect_valid_tree(adj, bfs(adj, in, 4999, BfsOptions{.alpha = never, .beta = 2}), 4999); // flips back and forth
+    // Zero thresholds are clamped to 1 instead of dividing by zero.
+    expect_valid_tree(adj, bfs(adj, in, 17, BfsOptions{.alpha = 0, .beta = 0}), 17);
+}
+
+static void test_unreachable_and_out_of_range()
+{
+    CsrAdjacency adj;
+    adj.edges = {1, 2};
+    adj.offsets = {0, 1, 2, 2, 2}; // 0 -> 1 -> 2, 3 isolated
+    const auto r = bfs(adj, adj.transposed(), 0);
+    EXPECT_EQ(r.distance[2], 2u);
+    EXPECT_TRUE(!r.reached(3));
+    EXPECT_EQ(r.parent[3], invalid_vertex);
+
+    const auto none = bfs(adj, adj.transposed(), 9);
+    EXPECT_TRUE(!none.reached(0));
+}
+
+static void test_graph_overload_uses_external_ids()
+{
+    Graph<int> g;
+    for (GraphIndex idx : {GraphIndex{100}, GraphIndex{5}, GraphIndex{70}, GraphIndex{9}}) (void)g.create_node(0, idx);
+    const std::vector<std::pair<GraphIndex, GraphIndex>> edges{{100, 5}, {5, 70}, {100, 70}};
+    (void)g.add_edges(edges);
+
+    const auto r = bfs(g, 100);
+    EXPECT_TRUE(r.has_value());
+    EXPECT_EQ(r->distance(100).value(), 0u);
+    EXPECT_EQ(r->distance(5).value(), 1u);
+    EXPECT_EQ(r->distance(70).value(), 1u);
+    EXPECT_EQ(r->parent(70).value(), 100u);
+    EXPECT_TRUE(!r->distance(9).has_value());
+    EXPECT_TRUE(!r->parent(12345).has_value());
+
+    const auto missing = bfs(g, 6);
+    EXPECT_TRUE(!missing.has_value() && missing.error() == BfsError::SourceMissing);
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_matches_queue_bfs_in_every_mode();
+    test_unreachable_and_out_of_range();
+    test_graph_overload_uses_external_ids();
+    return 0;
+}
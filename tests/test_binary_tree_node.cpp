@@ -1,7 +1,9 @@
 // tests/test_binary_tree_node.cpp
 #include "binary_tree_node.hpp"
 #include "common.hpp"
+#include "small_stack.hpp"
 
+#include <cstdio>
 #include <format>
 #include <string>
 #include <type_traits>
@@ -97,6 +99,65 @@ static void test_formatter_smoke()
     EXPECT_TRUE(s.find("R: 7") != std::string::npos);
 }
 
+static void test_formatter_single_child_is_last()
+{
+    BinaryTreeNode<int> r{10};
+    r.set_right(15);
+    r.right()->set_left(12);
+
+    const std::string expected =
+        "root: 10\n"
+        "└── R: 15\n"
+        "    └── L: 12\n";
+    EXPECT_EQ(std::format("{}", r), expected);
+}
+
+// Alternates left and right links so teardown has to rotate as well as
+// walk the right spine.
+static BinaryTreeNode<u32> make_zigzag(u32 depth)
+{
+    BinaryTreeNode<u32> root{0};
+    BinaryTreeNode<u32>* node = &root;
+    for (u32 i = 1; i <= depth; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            node->set_left(i);
+            node = node->left();
+        }
+        else
+        {
+            node->set_right(i);
+            node = node->right();
+        }
+    }
+    return root;
+}
+
+static void test_deep_tree_on_small_stack()
+{
+    run_on_small_stack(128 * 1024, [] {
+        {
+            auto root = make_zigzag(1'000'000);
+            EXPECT_EQ(root.right()->m_value, 1u);
+            // Replacing a deep subtree frees it through the same loop.
+            root = make_zigzag(10);
+            EXPECT_EQ(root.right()->left()->m_value, 2u);
+        }
+
+        const auto root = make_zigzag(4'000);
+        std::FILE* f = std::tmpfile();
+        EXPECT_TRUE(f != nullptr);
+        EXPECT_TRUE(write_tree(fileno(f), root).has_value());
+        std::string dumped(static_cast<usize>(std::fseek(f, 0, SEEK_END) == 0 ? std::ftell(f) : 0), '\0');
+        std::rewind(f);
+        EXPECT_EQ(std::fread(dumped.data(), 1, dumped.size(), f), dumped.size());
+        std::fclose(f);
+        EXPECT_EQ(dumped, std::format("{}", root));
+        EXPECT_TRUE(dumped.ends_with("└── L: 4000\n"));
+    });
+}
+
 static void test_type_traits_move_only_node()
 {
     static_assert(!std::is_copy_constructible_v<BinaryTreeNode<int>>);
@@ -116,6 +177,8 @@ int main()
     test_const_overloads();
     test_move_only_payload_supported();
     test_formatter_smoke();
+    test_formatter_single_child_is_last();
+    test_deep_tree_on_small_stack();
     test_type_traits_move_only_node();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,171 @@
+// tests/test_bplus_tree.cpp
+#include "bplus_tree.hpp"
+#include "common.hpp"
+
+#include <map>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static void test_node_layout()
+{
+    using Tree = BPlusTree<u64, u64>;
+    static_assert(Tree::leaf_capacity == 15);
+    static_assert(Tree::inner_capacity == 20);
+    static_assert(BPlusTree<u32, u32, 2 * cache_line_bytes>::leaf_capacity == 15);
+    static_assert(bplus_node_bytes % cache_line_bytes == 0 && bplus_node_bytes <= page_bytes);
+}
+
+static void test_empty_tree()
+{
+    BPlusTree<u64, u32> t;
+    EXPECT_TRUE(t.empty());
+    EXPECT_TRUE(t.find(1) == nullptr);
+    EXPECT_TRUE(!t.erase(1));
+    EXPECT_TRUE(t.begin() == t.end());
+    EXPECT_TRUE(t.lower_bound(0) == t.end());
+    EXPECT_EQ(t.height(), 1zu);
+}
+
+static void test_insert_find_and_split_levels()
+{
+    BPlusTree<u64, u64> t;
+    constexpr u64 n = 10'000;
+    for (u64 i = 0; i < n; ++i) EXPECT_TRUE(t.insert(i * 3, i));
+
+    EXPECT_EQ(t.size(), static_cast<usize>(n));
+    EXPECT_TRUE(t.height() >= 3zu);
+
+    for (u64 i = 0; i < n; ++i)
+    {
+        const u64* v = t.find(i * 3);
+        EXPECT_TRUE(v != nullptr);
+        EXPECT_EQ(*v, i);
+        EXPECT_TRUE(t.find(i * 3 + 1) == nullptr);
+    }
+
+    EXPECT_TRUE(!t.insert(30, 999)); // overwrite
+    EXPECT_EQ(*t.find(30), 999u);
+    EXPECT_EQ(t.size(), static_cast<usize>(n));
+}
+
+static void test_randomized_against_std_map()
+{
+    std::mt19937_64 rng(7);
+    BPlusTree<u32, u32> t;
+    std::map<u32, u32> ref;
+
+    for (int step = 0; step < 50'000; ++step)
+    {
+        const u32 key = static_cast<u32>(rng() % 20'000);
+        if (rng() % 4 == 0)
+        {
+            EXPECT_EQ(t.erase(key), ref.erase(key) == 1);
+        }
+        else
+        {
+            const u32 val = static_cast<u32>(rng());
+            EXPECT_EQ(t.insert(key, val), !ref.contains(key));
+            ref[key] = val;
+        }
+    }
+
+    EXPECT_EQ(t.size(), ref.size());
+    auto it = ref.begin();
+    for (const auto [k, v] : t)
+    {
+        EXPECT_EQ(k, it->first);
+        EXPECT_EQ(v, it->second);
+        ++it;
+    }
+    EXPECT_TRUE(it == ref.end());
+
+    for (u32 probe = 0; probe < 20'001; probe += 13)
+    {
+        auto a = t.lower_bound(probe);
+        auto b = ref.lower_bound(probe);
+        EXPECT_EQ(a == t.end(), b == ref.end());
+        if (b != ref.end()) EXPECT_EQ((*a).first, b->first);
+    }
+}
+
+static void test_range_scan_over_leaf_chain()
+{
+    BPlusTree<u64, u32> t;
+    for (u32 i = 0; i < 1000; ++i) t.insert(1000 + 2 * u64{i}, i);
+
+    u64 expected = 1100;
+    usize count = 0;
+    for (const auto [k, v] : t.range(1099, 1301))
+    {
+        EXPECT_EQ(k, expected);
+        EXPECT_EQ(u64{v}, (k - 1000) / 2);
+        expected += 2;
+        ++count;
+    }
+    EXPECT_EQ(count, 101zu);
+    EXPECT_TRUE(t.range(5000, 6000).empty());
+}
+
+static void test_bulk_load()
+{
+    std::vector<u64> keys(100'000);
+    std::iota(keys.begin(), keys.end(), u64{0});
+    for (auto& k : keys) k *= 5;
+    std::vector<u32> values(keys.size());
+    std::iota(values.begin(), values.end(), u32{0});
+
+    auto t = BPlusTree<u64, u32>::bulk_load(keys, values);
+    EXPECT_EQ(t.size(), keys.size());
+    for (usize i = 0; i < keys.size(); i += 97) EXPECT_EQ(*t.find(keys[i]), values[i]);
+    EXPECT_TRUE(t.find(3) == nullptr);
+
+    usize n = 0;
+    for (const auto [k, v] : t)
+    {
+        EXPECT_EQ(k, keys[n]);
+        ++n;
+    }
+    EXPECT_EQ(n, keys.size());
+
+    // Still a regular tree afterwards.
+    EXPECT_TRUE(t.insert(7, 1));
+    EXPECT_EQ((*t.lower_bound(6)).first, 7u);
+
+    const std::vector<u64> bad_keys{1, 3, 3};
+    const std::vector<u32> bad_vals{0, 0, 0};
+    using Tree = BPlusTree<u64, u32>;
+    EXPECT_THROW(Tree::bulk_load(bad_keys, bad_vals));
+}
+
+static void test_extreme_keys()
+{
+    BPlusTree<i64, int> t;
+    const i64 hi = std::numeric_limits<i64>::max();
+    const i64 lo = std::numeric_limits<i64>::min();
+    for (i64 i = 0; i < 200; ++i) t.insert(i, 0);
+    EXPECT_TRUE(t.insert(hi, 1));
+    EXPECT_TRUE(t.insert(lo, 2));
+    EXPECT_EQ(*t.find(hi), 1);
+    EXPECT_EQ(*t.find(lo), 2);
+    EXPECT_EQ((*t.lower_bound(200)).first, hi);
+    EXPECT_EQ((*t.begin()).first, lo);
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_node_layout();
+    test_empty_tree();
+    test_insert_find_and_split_levels();
+    test_randomized_against_std_map();
+    test_range_scan_over_leaf_chain();
+    test_bulk_load();
+    test_extreme_keys();
+    return 0;
+}
@@ -0,0 +1,129 @@
+// tests/test_components.cpp
+#include "common.hpp"
+#include "graph_fixtures.hpp"
+#include "components.hpp"
+#include "graph.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+// Reference labels: smallest vertex reachable when edges are undirected.
+static std::vector<VertexId> flood_fill(const CsrAdjacency& out)
+{
+    const CsrAdjacency in = out.transposed();
+    std::vector<VertexId> label(out.vertex_count(), invalid_vertex);
+    for (VertexId s = 0; s < out.vertex_count(); ++s)
+    {
+        if (label[s] != invalid_vertex) continue;
+        std::vector<VertexId> stack{s};
+        label[s] = s;
+        while (!stack.empty())
+        {
+            const VertexId u = stack.back();
+            stack.pop_back();
+            for (const CsrAdjacency* adj : {&out, &in})
+            {
+                for (VertexId v : adj->neighbors(u))
+                {
+                    if (label[v] != invalid_vertex) continue;
+                    label[v] = s;
+                    stack.push_back(v);
+                }
+            }
+        }
+    }
+    return label;
+}
+
+static void test_wcc_matches_flood_fill()
+{
+    // A giant random component plus small satellites that only touch it through in-edges.
+    constexpr usize n = 20'000;
+    std::vector<std::vector<VertexId>> lists(n);
+    u64 state = 99;
+    for (usize i = 0; i < 3 * n; ++i)
+    {
+        state = hash_int(state);
+        const auto u = static_cast<VertexId>(state % (n / 2));
+        const auto v = static_cast<VertexId>((state >> 32) % (n / 2));
+        if (u != v) lists[u].push_back(v);
+    }
+    for (usize i = n / 2; i + 1 < n; i += 3)
+    {
+        lists[i].push_back(static_cast<VertexId>(i + 1));
+        lists[i % 50].push_back(static_cast<VertexId>(i + 2 < n ? i + 2 : i));
+    }
+    const CsrAdjacency out = adjacency_from_unsorted(std::move(lists));
+
+    const auto c = weakly_connected_components(out, out.transposed());
+    const auto expected = flood_fill(out);
+    EXPECT_TRUE(c.label == expected);
+    usize roots = 0;
+    for (VertexId v = 0; v < n; ++v) roots += expected[v] == v;
+    EXPECT_EQ(c.count, roots);
+}
+
+static void test_scc_small_graph()
+{
+    // {0, 1, 2} cycle -> {3, 4} cycle -> 5, and 6 isolated.
+    const CsrAdjacency g = CsrAdjacency::from_lists({{1}, {2}, {0, 3}, {4}, {3, 5}, {}, {}});
+    const auto c = strongly_connected_components(g);
+    EXPECT_EQ(c.count, 4zu);
+    EXPECT_EQ(c.label[0], c.label[1]);
+    EXPECT_EQ(c.label[1], c.label[2]);
+    EXPECT_EQ(c.label[3], c.label[4]);
+    EXPECT_TRUE(c.label[2] != c.label[3]);
+    // Reverse topological order: edges point to lower labels.
+    EXPECT_TRUE(c.label[5] < c.label[3] && c.label[3] < c.label[0]);
+}
+
+static void test_scc_deep_chain()
+{
+    // A 200k-long path closed into one cycle would overflow a recursive Tarjan.
+    constexpr usize n = 200'000;
+    std::vector<std::vector<VertexId>> lists(n);
+    for (usize i = 0; i < n; ++i) lists[i].push_back(static_cast<VertexId>((i + 1) % n));
+    const auto c = strongly_connected_components(CsrAdjacency::from_lists(lists));
+    EXPECT_EQ(c.count, 1zu);
+
+    lists.back().clear();
+    EXPECT_EQ(strongly_connected_components(CsrAdjacency::from_lists(lists)).count, n);
+}
+
+static void test_graph_overloads()
+{
+    Graph<int> g;
+    for (GraphIndex idx : {GraphIndex{10}, GraphIndex{20}, GraphIndex{30}, GraphIndex{40}}) (void)g.create_node(0, idx);
+    const std::vector<std::pair<GraphIndex, GraphIndex>> edges{{10, 20}, {20, 10}, {30, 20}};
+    (void)g.add_edges(edges);
+
+    const auto wcc = weakly_connected_components(g);
+    EXPECT_TRUE(wcc.has_value());
+    EXPECT_EQ(wcc->components.count, 2zu);
+    EXPECT_TRUE(wcc->same_component(10, 30));
+    EXPECT_TRUE(!wcc->same_component(10, 40));
+    EXPECT_TRUE(!wcc->component_of(99).has_value());
+
+    const auto scc = strongly_connected_components(g);
+    EXPECT_TRUE(scc.has_value());
+    EXPECT_EQ(scc->components.count, 3zu);
+    EXPECT_TRUE(scc->same_component(10, 20));
+    EXPECT_TRUE(!scc->same_component(20, 30));
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_wcc_matches_flood_fill();
+    test_scc_small_graph();
+    test_scc_deep_chain();
+    test_graph_overloads();
+    return 0;
+}
@@ -0,0 +1,168 @@
+// tests/test_csr_graph.cpp
+#include "common.hpp"
+#include "csr_graph.hpp"
+#include "graph.hpp"
+
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static Graph<std::string> make_sparse_graph()
+{
+    // External ids deliberately sparse and inserted out of order.
+    Graph<std::string> g;
+    for (GraphIndex idx : {GraphIndex{500}, GraphIndex{7}, GraphIndex{42}, GraphIndex{1'000'000}})
+    {
+        (void)g.create_node("n" + std::to_string(idx), idx);
+    }
+    (void)g.add_edge(7, 42);
+    (void)g.add_edge(7, 1'000'000);
+    (void)g.add_edge(42, 500);
+    (void)g.add_edge(1'000'000, 7);
+    (void)g.add_edge(1'000'000, 42);
+    return g;
+}
+
+static void test_freeze_renumbers_densely_in_id_order()
+{
+    const auto g = make_sparse_graph();
+    const auto frozen = g.freeze();
+    EXPECT_TRUE(frozen.has_value());
+    const CsrGraph<std::string>& c = *frozen;
+
+    EXPECT_EQ(c.vertex_count(), 4zu);
+    EXPECT_EQ(c.edge_count(), 5zu);
+
+    const GraphIndex expected_ids[] = {7, 42, 500, 1'000'000};
+    for (VertexId v = 0; v < 4; ++v)
+    {
+        EXPECT_EQ(c.external_id(v), expected_ids[v]);
+        EXPECT_EQ(c.value(v), "n" + std::to_string(expected_ids[v]));
+        EXPECT_EQ(c.dense_id(expected_ids[v]).value(), v);
+    }
+    EXPECT_TRUE(!c.dense_id(8).has_value());
+
+    // 7 -> {42, 1'000'000} becomes 0 -> {1, 3}, still sorted.
+    const auto n0 = c.neighbors(0);
+    EXPECT_EQ(n0.size(), 2zu);
+    EXPECT_EQ(n0[0], 1u);
+    EXPECT_EQ(n0[1], 3u);
+    EXPECT_EQ(c.degree(2), 0zu);
+
+    EXPECT_TRUE(c.contains_edge(3, 0));
+    EXPECT_TRUE(c.contains_edge(1, 2));
+    EXPECT_TRUE(!c.contains_edge(2, 1));
+}
+
+static void test_transposed_adjacency()
+{
+    const auto c = *make_sparse_graph().freeze();
+    const CsrAdjacency in = c.adjacency().transposed();
+
+    EXPECT_EQ(in.vertex_count(), 4zu);
+    EXPECT_EQ(in.edge_count(), 5zu);
+    // in-neighbors of 42 (dense 1): 7 (0) and 1'000'000 (3)
+    const auto n1 = in.neighbors(1);
+    EXPECT_EQ(n1.size(), 2zu);
+    EXPECT_EQ(n1[0], 0u);
+    EXPECT_EQ(n1[1], 3u);
+    EXPECT_EQ(in.degree(3), 1zu);
+}
+
+static void test_in_adjacency_is_cached()
+{
+    const auto c = *make_sparse_graph().freeze();
+    const CsrAdjacency& in = c.in_adjacency();
+    const CsrAdjacency expected = c.adjacency().transposed();
+    EXPECT_TRUE(in.offsets == expected.offsets && in.edges == expected.edges);
+    EXPECT_TRUE(&c.in_adjacency() == &in);
+
+    // Copies share the cache, moves carry it along.
+    CsrGraph<std::string> copy = c;
+    EXPECT_TRUE(&copy.in_adjacency() == &in);
+    const CsrGraph<std::string> moved = std::move(copy);
+    EXPECT_TRUE(&moved.in_adjacency() == &in);
+}
+
+static void test_from_lists()
+{
+    const auto adj = CsrAdjacency::from_lists({{2, 1}, {}, {0}});
+    EXPECT_EQ(adj.vertex_count(), 3zu);
+    EXPECT_EQ(adj.edge_count(), 3zu);
+    EXPECT_TRUE((adj.offsets == std::vector<u64>{0, 2, 2, 3}));
+    EXPECT_EQ(adj.neighbors(0)[0], 2u); // order kept
+    EXPECT_TRUE(!adj.weighted());
+    EXPECT_EQ(CsrAdjacency::from_lists({}).vertex_count(), 0zu);
+}
+
+static void test_freeze_carries_weights()
+{
+    Graph<int> g;
+    for (GraphIndex idx : {GraphIndex{1}, GraphIndex{2}, GraphIndex{3}}) (void)g.create_node(0, idx);
+    (void)g.add_edge(1, 3, 7);
+    (void)g.add_edge(1, 2);
+    (void)g.add_edge(3, 2, 4);
+
+    const auto c = *g.freeze();
+    EXPECT_TRUE(c.adjacency().weighted());
+    const auto w0 = c.edge_weights(0);
+    EXPECT_EQ(w0.size(), 2zu);
+    EXPECT_EQ(w0[0], default_edge_weight); // 1 -> 2
+    EXPECT_EQ(w0[1], 7u);                  // 1 -> 3
+
+    // In-edges of 2 (dense 1) come from 1 and 3 with weights 1 and 4.
+    const CsrAdjacency in = c.adjacency().transposed();
+    const auto w1 = in.edge_weights(1);
+    EXPECT_EQ(w1.size(), 2zu);
+    EXPECT_EQ(w1[0], 1u);
+    EXPECT_EQ(w1[1], 4u);
+}
+
+static void test_freeze_reports_dangling_edge()
+{
+    Graph<int> g;
+    auto n = g.create_node(1, 0);
+    EXPECT_TRUE(n.has_value());
+    EXPECT_TRUE((*n)->add_neighbor(99).has_value()); // node 99 never created
+
+    const auto frozen = g.freeze();
+    EXPECT_TRUE(!frozen.has_value());
+    EXPECT_TRUE(frozen.error() == Graph<int>::FreezeError::DanglingEdge);
+}
+
+static void test_empty_graph()
+{
+    const Graph<int> g;
+    const auto c = *g.freeze();
+    EXPECT_EQ(c.vertex_count(), 0zu);
+    EXPECT_EQ(c.edge_count(), 0zu);
+    EXPECT_TRUE(!c.dense_id(0).has_value());
+}
+
+static void test_constructor_validates_inputs()
+{
+    CsrAdjacency adj;
+    adj.offsets = {0, 0, 0};
+    EXPECT_THROW(CsrGraph<int>({1, 2}, {0}, adj));
+    EXPECT_THROW(CsrGraph<int>({2, 1}, {0, 0}, adj));
+    EXPECT_NO_THROW(CsrGraph<int>({1, 2}, {0, 0}, adj));
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_freeze_renumbers_densely_in_id_order();
+    test_transposed_adjacency();
+    test_in_adjacency_is_cached();
+    test_from_lists();
+    test_freeze_carries_weights();
+    test_freeze_reports_dangling_edge();
+    test_empty_graph();
+    test_constructor_validates_inputs();
+    return 0;
+}
@@ -0,0 +1,125 @@
+// tests/test_edge_map.cpp
+#include "bfs.hpp"
+#include "common.hpp"
+#include "graph_fixtures.hpp"
+#include "components.hpp"
+#include "edge_map.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static void test_vertex_subset_conversions()
+{
+    VertexSubset s{130, std::vector<VertexId>{129, 3, 64}};
+    EXPECT_TRUE(!s.is_dense() && s.size() == 3);
+    EXPECT_TRUE(s.contains(64) && !s.contains(65));
+
+    s.to_dense();
+    EXPECT_TRUE(s.is_dense() && s.size() == 3);
+    EXPECT_TRUE(s.contains(3) && s.contains(129) && !s.contains(128));
+
+    s.to_sparse();
+    EXPECT_TRUE(std::ranges::equal(s.ids(), std::vector<VertexId>{3, 64, 129}));
+
+    const VertexSubset all = VertexSubset::all(70);
+    EXPECT_EQ(all.size(), 70zu);
+    EXPECT_TRUE(all.contains(69));
+    EXPECT_EQ(std::popcount(all.bits()[1]), 6);
+
+    // vertex_filter keeps the representation.
+    const VertexSubset even = vertex_filter(all, [](VertexId v) { return v % 2 == 0; });
+    EXPECT_TRUE(even.is_dense() && even.size() == 35);
+    const VertexSubset odd = vertex_filter(VertexSubset{70, std::vector<VertexId>{1, 2, 3}}, [](VertexId v) { return v % 2 == 1; });
+    EXPECT_TRUE(std::ranges::equal(odd.ids(), std::vector<VertexId>{1, 3}));
+
+    std::vector<u32> hits(70, 0);
+    vertex_map(even, [&](VertexId v) { ++hits[v]; });
+    EXPECT_EQ(std::ranges::count(hits, 1u), 35);
+}
+
+// BFS in a dozen lines on top of edge_map.
+static std::vector<VertexId> edge_map_bfs(const CsrAdjacency& out, const CsrAdjacency& in, VertexId source,
+                                          EdgeMapDirection direction)
+{
+    std::vector<VertexId> parent(out.vertex_count(), invalid_vertex);
+    parent[source] = source;
+    VertexSubset frontier{out.vertex_count(), source};
+    while (!frontier.empty())
+    {
+        frontier = edge_map(
+            out, in, frontier,
+            [&](VertexId u, VertexId v) { return compare_and_swap(parent[v], invalid_vertex, u); },
+            [&](VertexId v) { return std::atomic_ref<VertexId>{parent[v]}.load(std::memory_order_relaxed) == invalid_vertex; },
+            EdgeMapOptions{.direction = direction});
+    }
+    return parent;
+}
+
+static void test_bfs_matches_in_every_direction()
+{
+    const CsrAdjacency out = random_adjacency(5000, 20000, 41);
+    const CsrAdjacency in = out.transposed();
+    const BfsResult expected = bfs(out, in, 0);
+
+    for (EdgeMapDirection d : {EdgeMapDirection::Push, EdgeMapDirection::Pull, EdgeMapDirection::Auto})
+    {
+        const auto parent = edge_map_bfs(out, in, 0, d);
+        for (VertexId v = 0; v < out.vertex_count(); ++v)
+        {
+            EXPECT_EQ(parent[v] == invalid_vertex, expected.distance[v] == BfsResult::unreachable);
+            if (parent[v] == invalid_vertex || v == 0) continue;
+            // Any BFS tree works; the parent just has to sit one level up.
+            EXPECT_EQ(expected.distance[parent[v]] + 1, expected.distance[v]);
+        }
+    }
+}
+
+static void test_label_propagation_components()
+{
+    const CsrAdjacency sym = random_symmetric(3000, 2500, 8);
+    std::vector<VertexId> label(sym.vertex_count());
+    for (VertexId v = 0; v < sym.vertex_count(); ++v) label[v] = v;
+
+    VertexSubset active = VertexSubset::all(sym.vertex_count());
+    usize rounds = 0;
+    while (!active.empty())
+    {
+        active = edge_map(
+            sym, sym, active, [&](VertexId u, VertexId v) { return write_min(label[v], std::atomic_ref<VertexId>{label[u]}.load(std::memory_order_relaxed)); },
+            [](VertexId) { return true; });
+        ++rounds;
+    }
+    EXPECT_TRUE(rounds > 2);
+    EXPECT_TRUE(label == weakly_connected_components(sym, sym).label);
+}
+
+static void test_atomic_helpers()
+{
+    u32 x = 10;
+    EXPECT_TRUE(write_min(x, 4u));
+    EXPECT_TRUE(!write_min(x, 7u));
+    EXPECT_EQ(x, 4u);
+    EXPECT_TRUE(compare_and_swap(x, 4u, 9u));
+    EXPECT_TRUE(!compare_and_swap(x, 4u, 1u));
+    EXPECT_EQ(fetch_add(x, 2u), 9u);
+    EXPECT_EQ(x, 11u);
+
+    double d = 1.5;
+    EXPECT_TRUE(write_min(d, -2.0));
+    EXPECT_NEAR(d, -2.0);
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_vertex_subset_conversions();
+    test_bfs_matches_in_every_direction();
+    test_label_propagation_components();
+    test_atomic_helpers();
+    return 0;
+}
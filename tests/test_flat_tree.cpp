@@ -0,0 +1,113 @@
+// tests/test_flat_tree.cpp
+#include "common.hpp"
+#include "flat_tree.hpp"
+#include "tree_node.hpp"
+
+#include <format>
+#include <string>
+
+namespace dsalgo::Test
+{
+
+static void test_basic_construction_and_children()
+{
+    FlatTree<int> t{0};
+    EXPECT_EQ(t.size(), 1zu);
+    EXPECT_EQ(t.value(t.root()), 0);
+    EXPECT_EQ(t.child_count(t.root()), 0zu);
+    EXPECT_EQ(t.first_child(t.root()), FlatTree<int>::npos);
+
+    const auto a = t.create_new_child(t.root(), 10);
+    const auto b = t.create_new_child(t.root(), 20);
+    const auto c = t.create_new_child(t.root(), 30);
+
+    EXPECT_EQ(t.size(), 4zu);
+    EXPECT_EQ(t.child_count(t.root()), 3zu);
+    EXPECT_EQ(t.child(t.root(), 0), a);
+    EXPECT_EQ(t.child(t.root(), 1), b);
+    EXPECT_EQ(t.child(t.root(), 2), c);
+    EXPECT_EQ(t.next_sibling(a), b);
+    EXPECT_EQ(t.next_sibling(c), FlatTree<int>::npos);
+
+    const auto d = t.create_new_child(b, 42);
+    EXPECT_EQ(t.child_count(b), 1zu);
+    EXPECT_EQ(t.value(t.child(b, 0)), 42);
+    EXPECT_EQ(t.child(b, 0), d);
+}
+
+static void test_bounds_throw()
+{
+    FlatTree<int> t{0};
+    EXPECT_THROW(t.child(t.root(), 0));
+    EXPECT_THROW(t.value(1));
+    EXPECT_THROW(t.create_new_child(5, 1));
+
+    (void)t.create_new_child(t.root(), 1);
+    EXPECT_NO_THROW(t.child(t.root(), 0));
+    EXPECT_THROW(t.child(t.root(), 1));
+}
+
+static void test_from_tree_node_is_bfs_ordered()
+{
+    TreeNode<int> root{0};
+    root.create_new_child(1);
+    root.create_new_child(2);
+    root.create_new_child(3);
+    root.child_ptr(0)->create_new_child(10);
+    root.child_ptr(2)->create_new_child(30);
+    root.child_ptr(2)->create_new_child(31);
+
+    const auto t = FlatTree<int>::from_tree_node(root);
+    EXPECT_EQ(t.size(), 7zu);
+
+    // BFS: 0 | 1 2 3 | 10 30 31
+    const int expected[] = {0, 1, 2, 3, 10, 30, 31};
+    for (u32 i = 0; i < 7; ++i) EXPECT_EQ(t.value(i), expected[i]);
+
+    EXPECT_EQ(t.child_count(3), 2zu);
+    EXPECT_EQ(t.child(3, 0), 5u);
+    EXPECT_EQ(t.child(3, 1), 6u);
+}
+
+static void test_formatter_matches_tree_node()
+{
+    TreeNode<int> root{0};
+    root.create_new_child(1);
+    root.create_new_child(2);
+    root.create_new_child(3);
+    root.child_ptr(1)->create_new_child(42);
+    root.child_ptr(1)->create_new_child(43);
+    root.child_ptr(1)->child_ptr(0)->create_new_child(99);
+
+    const auto flat = FlatTree<int>::from_tree_node(root);
+    EXPECT_EQ(std::format("{}", flat), std::format("{}", root));
+}
+
+static void test_formatter_deep_chain()
+{
+    // Output is quadratic in depth for a chain (every line repeats the prefix), keep it moderate.
+    constexpr u32 depth = 2'000;
+    FlatTree<u32> t{0};
+    t.reserve(depth + 1);
+    u32 node = t.root();
+    for (u32 i = 1; i <= depth; ++i) node = t.create_new_child(node, i);
+
+    const std::string s = std::format("{}", t);
+    usize lines = 0;
+    for (char ch : s) lines += (ch == '\n');
+    EXPECT_EQ(lines, static_cast<usize>(depth) + 1);
+    EXPECT_TRUE(s.ends_with("└── 0: 2000\n"));
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_basic_construction_and_children();
+    test_bounds_throw();
+    test_from_tree_node_is_bfs_ordered();
+    test_formatter_matches_tree_node();
+    test_formatter_deep_chain();
+    return 0;
+}
@@ -0,0 +1,168 @@
+// tests/test_gemm.cpp
+#include "common.hpp"
+#include "gemm.hpp"
+#include "matrix.hpp"
+#include "util.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+template <typename T>
+static std::vector<T> random_values(usize count, u64 seed)
+{
+    std::vector<T> v(count);
+    for (T& x : v)
+    {
+        seed = hash_int(seed);
+        x = static_cast<T>(static_cast<double>(seed % 2001) / 1000.0 - 1.0);
+    }
+    return v;
+}
+
+template <typename T>
+static bool close(const std::vector<T>& a, const std::vector<T>& b, usize k)
+{
+    // Each entry is a k-term dot product of values in [-1, 1].
+    const T tol = static_cast<T>(k) * (sizeof(T) == 4 ? T(1e-5) : T(1e-12));
+    for (usize i = 0; i < a.size(); ++i)
+    {
+        if (std::abs(a[i] - b[i]) > tol) return false;
+    }
+    return true;
+}
+
+// Sizes around every blocking boundary: partial micro-tiles, several kc
+// slices and more than one mc block.
+template <typename T>
+static void test_matches_naive()
+{
+    using B = GemmBlocking<T>;
+    const usize shapes[][3] = {
+        {1, 1, 1},
+        {B::mr - 1, B::nr + 1, 3},
+        {2 * B::mr + 1, 3 * B::nr - 1, B::kc + 7},
+        {B::mc + B::mr + 1, 2 * B::nr, 2 * B::kc + 1},
+        {37, 41, 43},
+    };
+    for (const auto& [m, n, k] : shapes)
+    {
+        const auto a = random_values<T>(m * k, m);
+        const auto b = random_values<T>(k * n, n);
+        std::vector<T> expected(m * n);
+        gemm_naive(m, n, k, a.data(), k, b.data(), n, expected.data(), n);
+
+        std::vector<T> c(m * n, T(99));
+        gemm(m, n, k, a.data(), k, b.data(), n, c.data(), n);
+        EXPECT_TRUE(close(c, expected, k));
+
+        // accumulate adds on top of what is there.
+        std::vector<T> twice = c;
+        gemm(m, n, k, a.data(), k, b.data(), n, twice.data(), n, true);
+        for (T& x : expected) x *= T(2);
+        EXPECT_TRUE(close(twice, expected, 2 * k));
+    }
+}
+
+template <typename T>
+static void test_parallel_matches_serial()
+{
+    using B = GemmBlocking<T>;
+    // Tall, wide and square shapes so both row blocks and column groups get
+    // split; 20 rows are fewer MR slivers than 7 threads want tasks.
+    const usize shapes[][3] = {
+        {300, 90, 70}, {13, 2 * B::nr + 5, B::kc + 3}, {B::mc + 17, 200, 2 * B::kc + 5}, {20, 300, 80}};
+    for (usize threads : {2zu, 3zu, 5zu, 7zu})
+    {
+        ThreadPool pool{threads};
+        for (const auto& [m, n, k] : shapes)
+        {
+            const auto a = random_values<T>(m * k, 3 * m);
+            const auto b = random_values<T>(k * n, 5 * n);
+            std::vector<T> expected(m * n);
+            gemm(m, n, k, a.data(), k, b.data(), n, expected.data(), n);
+
+            std::vector<T> c(m * n, T(7));
+            gemm_parallel(m, n, k, a.data(), k, b.data(), n, c.data(), n, false, pool);
+            EXPECT_TRUE(close(c, expected, k));
+
+            gemm_parallel(m, n, k, a.data(), k, b.data(), n, c.data(), n, true, pool);
+            for (T& x : expected) x *= T(2);
+            EXPECT_TRUE(close(c, expected, 2 * k));
+        }
+    }
+}
+
+static void test_leading_dimensions()
+{
+    // Multiply the 5 x 4 and 4 x 3 top-left corners of larger buffers into
+    // the middle of a larger C; everything outside the window stays put.
+    constexpr usize lda = 9, ldb = 7, ldc = 8;
+    const auto a = random_values<f64>(5 * lda, 1);
+    const auto b = random_values<f64>(4 * ldb, 2);
+    std::vector<f64> c(7 * ldc, -5.0);
+    gemm<f64>(5, 3, 4, a.data(), lda, b.data(), ldb, c.data() + ldc + 2, ldc);
+
+    for (usize i = 0; i < 7; ++i)
+    {
+        for (usize j = 0; j < ldc; ++j)
+        {
+            const bool inside = i >= 1 && i < 6 && j >= 2 && j < 5;
+            if (!inside)
+            {
+                EXPECT_NEAR(c[i * ldc + j], -5.0);
+                continue;
+            }
+            f64 expected = 0.0;
+            for (usize p = 0; p < 4; ++p) expected += a[(i - 1) * lda + p] * b[p * ldb + (j - 2)];
+            EXPECT_NEAR(c[i * ldc + j], expected);
+        }
+    }
+}
+
+static void test_empty_inner_dimension()
+{
+    std::vector<f32> c(6, 3.0f);
+    gemm<f32>(2, 3, 0, nullptr, 0, nullptr, 3, c.data(), 3);
+    for (f32 x : c) EXPECT_NEAR(x, 0.0f);
+}
+
+static void test_matrix_gemm()
+{
+    auto a = Matrix<f32, 4, 4>::Diagonal(2.0f);
+    a(0, 3) = 1.0f;
+    const auto b = Matrix<f32, 4, 4>::Diagonal(-3.0f);
+    const auto c = GEMM(a, b);
+    EXPECT_NEAR(c(0, 0), -6.0f);
+    EXPECT_NEAR(c(0, 3), -3.0f);
+    EXPECT_NEAR(c(3, 3), -6.0f);
+    EXPECT_NEAR(c(1, 0), 0.0f);
+
+    Matrix<f64, 3, 70> wide{};
+    Matrix<f64, 70, 2> tall{};
+    for (usize i = 0; i < 70; ++i)
+    {
+        wide(1, i) = 1.0;
+        tall(i, 1) = static_cast<f64>(i);
+    }
+    const auto r = GEMM(wide, tall);
+    EXPECT_NEAR(r(1, 1), 69.0 * 70.0 / 2.0);
+    EXPECT_NEAR(r(0, 1), 0.0);
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_matches_naive<dsalgo::f32>();
+    test_matches_naive<dsalgo::f64>();
+    test_parallel_matches_serial<dsalgo::f32>();
+    test_parallel_matches_serial<dsalgo::f64>();
+    test_leading_dimensions();
+    test_empty_inner_dimension();
+    test_matrix_gemm();
+    return 0;
+}
@@ -0,0 +1,307 @@
+// tests/test_graph.cpp
+#include "common.hpp"
+#include "graph.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static void test_auto_index_follows_max()
+{
+    Graph<int> g;
+    EXPECT_EQ((*g.create_node(10))->get_idx(), 0u);
+    EXPECT_EQ((*g.create_node(11))->get_idx(), 1u);
+    EXPECT_TRUE(g.create_node(12, 100).has_value());
+    EXPECT_EQ((*g.create_node(13))->get_idx(), 101u);
+    EXPECT_TRUE(g.create_node(14, 50).has_value()); // below the max, does not move it
+    EXPECT_EQ((*g.create_node(15))->get_idx(), 102u);
+    EXPECT_EQ(g.node_count(), 6zu);
+    EXPECT_EQ(*g.value_by_idx(101), 13);
+}
+
+static void test_create_node_errors()
+{
+    using E = Graph<int>::CreateNodeError;
+    Graph<int> g;
+    EXPECT_TRUE(g.create_node(1, 5).has_value());
+    const auto dup = g.create_node(2, 5);
+    EXPECT_TRUE(!dup.has_value() && dup.error() == E::IndexExists);
+
+    EXPECT_TRUE(g.create_node(3, std::numeric_limits<GraphIndex>::max()).has_value());
+    const auto overflow = g.create_node(4);
+    EXPECT_TRUE(!overflow.has_value() && overflow.error() == E::IndexOverflowing);
+    const std::vector<int> more{1, 2};
+    const auto bulk = g.create_nodes(more);
+    EXPECT_TRUE(!bulk.has_value() && bulk.error() == E::IndexOverflowing);
+}
+
+static void test_create_nodes_returns_contiguous_range()
+{
+    Graph<int> g;
+    g.reserve(1000);
+    EXPECT_TRUE(g.create_node(-1, 9).has_value());
+
+    std::vector<int> values(1000);
+    for (int i = 0; i < 1000; ++i) values[static_cast<usize>(i)] = i;
+    const auto range = g.create_nodes(values);
+    EXPECT_TRUE(range.has_value());
+    EXPECT_EQ(range->first, 10u);
+    EXPECT_EQ(range->second, 1010u);
+    EXPECT_EQ(g.node_count(), 1001zu);
+    for (GraphIndex idx = range->first; idx < range->second; ++idx)
+    {
+        EXPECT_EQ(*g.value_by_idx(idx), static_cast<int>(idx - 10));
+    }
+
+    const auto empty = g.create_nodes({});
+    EXPECT_TRUE(empty.has_value());
+    EXPECT_EQ(empty->first, empty->second);
+    EXPECT_EQ((*g.create_node(0))->get_idx(), 1010u);
+}
+
+static void test_create_nodes_near_index_limit()
+{
+    using E = Graph<int>::CreateNodeError;
+    constexpr GraphIndex max = std::numeric_limits<GraphIndex>::max();
+    Graph<int> g;
+    EXPECT_TRUE(g.create_node(0, max - 3).has_value());
+
+    const std::vector<int> three{1, 2, 3};
+    const auto too_many = g.create_nodes(three);
+    EXPECT_TRUE(!too_many.has_value() && too_many.error() == E::IndexOverflowing);
+    EXPECT_EQ(g.node_count(), 1zu);
+
+    const std::vector<int> two{1, 2};
+    const auto ok = g.create_nodes(two);
+    EXPECT_TRUE(ok.has_value());
+    EXPECT_EQ(ok->second, max);
+}
+
+static void test_add_edge_errors()
+{
+    using E = Graph<int>::AddEdgeError;
+    Graph<int> g;
+    (void)g.create_node(0, 0);
+    (void)g.create_node(1, 1);
+
+    EXPECT_TRUE(g.add_edge(0, 1).has_value());
+    EXPECT_TRUE(g.add_edge(0, 1).error() == E::EdgeExists);
+    EXPECT_TRUE(g.add_edge(0, 0).error() == E::SelfLoop);
+    EXPECT_TRUE(g.add_edge(7, 1).error() == E::NodeFromMissing);
+    EXPECT_TRUE(g.add_edge(1, 7).error() == E::NodeToMissing);
+    EXPECT_TRUE(g.validate_all().has_value());
+}
+
+static void test_add_edges_reports_like_add_edge()
+{
+    using E = Graph<int>::AddEdgeError;
+    Graph<int> g;
+    for (GraphIndex i = 0; i < 4; ++i) (void)g.create_node(0, i);
+    EXPECT_TRUE(g.add_edge(0, 2).has_value());
+
+    const std::vector<std::pair<GraphIndex, GraphIndex>> edges{
+        {0, 3}, {0, 1}, {0, 2}, {0, 3}, {1, 1}, {9, 0}, {9, 1}, {2, 9}, {3, 0}, {2, 0},
+    };
+    const auto report = g.add_edges(edges);
+    EXPECT_EQ(report.added, 4zu);
+    EXPECT_EQ(report.count(E::EdgeExists), 2zu);
+    EXPECT_EQ(report.count(E::SelfLoop), 1zu);
+    EXPECT_EQ(report.count(E::NodeFromMissing), 2zu);
+    EXPECT_EQ(report.count(E::NodeToMissing), 1zu);
+    EXPECT_EQ(report.added + report.rejected(), edges.size());
+    EXPECT_TRUE(g.validate_all().has_value());
+
+    const auto csr = *g.freeze();
+    EXPECT_EQ(csr.edge_count(), 5zu);
+    EXPECT_TRUE(csr.contains_edge(0, 1) && csr.contains_edge(0, 2) && csr.contains_edge(0, 3));
+    EXPECT_TRUE(csr.contains_edge(3, 0) && csr.contains_edge(2, 0));
+}
+
+static void test_add_edges_matches_sequential_add_edge()
+{
+    constexpr GraphIndex n = 500;
+    Graph<int> bulk;
+    Graph<int> single;
+    for (GraphIndex i = 0; i < n; ++i)
+    {
+        (void)bulk.create_node(0, i * 3);
+        (void)single.create_node(0, i * 3);
+    }
+
+    // Pseudo-random edges, including repeats, self-loops and holes between ids.
+    std::vector<std::pair<GraphIndex, GraphIndex>> edges;
+    u64 state = 12345;
+    for (usize i = 0; i < 20000; ++i)
+    {
+        state = hash_int(state);
+        edges.emplace_back(state % (3 * n), (state >> 32) % (3 * n));
+    }
+
+    usize added = 0;
+    usize rejected = 0;
+    for (const auto& [from, to] : edges)
+    {
+        if (single.add_edge(from, to)) ++added;
+        else ++rejected;
+    }
+
+    const auto report = bulk.add_edges(edges);
+    EXPECT_EQ(report.added, added);
+    EXPECT_EQ(report.rejected(), rejected);
+    EXPECT_TRUE(bulk.validate_all().has_value());
+
+    const auto a = *bulk.freeze();
+    const auto b = *single.freeze();
+    EXPECT_TRUE(std::ranges::equal(a.adjacency().offsets, b.adjacency().offsets));
+    EXPECT_TRUE(std::ranges::equal(a.adjacency().edges, b.adjacency().edges));
+}
+
+static void test_weighted_edges()
+{
+    using WE = Graph<int>::WeightedEdge;
+    Graph<int> g;
+    for (GraphIndex i = 0; i < 3; ++i) (void)g.create_node(0, i);
+    EXPECT_TRUE(g.add_edge(0, 2, 5).has_value());
+    EXPECT_TRUE(g.add_edge(0, 2, 9).error() == Graph<int>::AddEdgeError::EdgeExists);
+
+    // First weight of a repeated edge wins, existing edges keep theirs.
+    const std::vector<WE> edges{{0, 1, 3}, {0, 1, 8}, {0, 2, 1}, {1, 0}};
+    const auto report = g.add_edges(edges);
+    EXPECT_EQ(report.added, 2zu);
+    EXPECT_EQ(report.edge_exists, 2zu);
+
+    const auto csr = *g.freeze();
+    const auto w0 = csr.edge_weights(0);
+    EXPECT_EQ(w0.size(), 2zu);
+    EXPECT_EQ(w0[0], 3u);
+    EXPECT_EQ(w0[1], 5u);
+    EXPECT_EQ(csr.edge_weights(1)[0], default_edge_weight);
+}
+
+static void test_remove_edge_and_node()
+{
+    Graph<int> g;
+    for (GraphIndex i = 0; i < 4; ++i) (void)g.create_node(0, i);
+    for (GraphIndex i = 0; i < 4; ++i)
+    {
+        for (GraphIndex j = 0; j < 4; ++j) (void)g.add_edge(i, j, static_cast<EdgeWeight>(10 * i + j));
+    }
+
+    using RE = Graph<int>::RemoveEdgeError;
+    EXPECT_TRUE(g.remove_edge(0, 2).has_value());
+    EXPECT_TRUE(g.remove_edge(0, 2).error() == RE::EdgeMissing);
+    EXPECT_TRUE(g.remove_edge(9, 2).error() == RE::NodeFromMissing);
+
+    // Removing 1 drops its out-edges and every edge into it.
+    EXPECT_TRUE(g.remove_node(1).has_value());
+    EXPECT_TRUE(g.remove_node(1).error() == Graph<int>::RemoveNodeError::NodeMissing);
+    EXPECT_EQ(g.node_count(), 3zu);
+    EXPECT_TRUE(g.validate_all().has_value());
+    EXPECT_EQ((*g.create_node(0))->get_idx(), 4u); // removed indices are not reused
+
+    const auto csr = *g.freeze();
+    // Left: 0->3, 2->0, 2->3, 3->0, 3->2.
+    EXPECT_EQ(csr.edge_count(), 5zu);
+    EXPECT_TRUE(!csr.contains_edge(*csr.dense_id(0), *csr.dense_id(2)));
+    EXPECT_TRUE(csr.contains_edge(*csr.dense_id(2), *csr.dense_id(3)));
+    EXPECT_EQ(csr.edge_weights(*csr.dense_id(3))[0], 30u); // weights stay aligned after compaction
+}
+
+static void test_remove_edges_matches_sequential_remove_edge()
+{
+    constexpr GraphIndex n = 300;
+    Graph<int> bulk;
+    Graph<int> single;
+    std::vector<std::pair<GraphIndex, GraphIndex>> edges;
+    u64 state = 777;
+    for (usize i = 0; i < 6000; ++i)
+    {
+        state = hash_int(state);
+        edges.emplace_back(state % n, (state >> 32) % n);
+    }
+    for (Graph<int>* g : {&bulk, &single})
+    {
+        for (GraphIndex i = 0; i < n; ++i) (void)g->create_node(0, i);
+        (void)g->add_edges(edges);
+    }
+
+    // Half of the added edges, some repeated, plus sources that do not exist.
+    std::vector<std::pair<GraphIndex, GraphIndex>> removals(edges.begin(), edges.begin() + 3000);
+    removals.insert(removals.end(), edges.begin(), edges.begin() + 100);
+    removals.emplace_back(n + 5, 0);
+
+    usize removed = 0;
+    usize rejected = 0;
+    for (const auto& [from, to] : removals)
+    {
+        if (single.remove_edge(from, to)) ++removed;
+        else ++rejected;
+    }
+    const auto report = bulk.remove_edges(removals);
+    EXPECT_EQ(report.removed, removed);
+    EXPECT_EQ(report.rejected(), rejected);
+    EXPECT_EQ(report.node_from_missing, 1zu);
+    EXPECT_TRUE(bulk.validate_all().has_value());
+
+    const auto a = *bulk.freeze();
+    const auto b = *single.freeze();
+    EXPECT_TRUE(std::ranges::equal(a.adjacency().offsets, b.adjacency().offsets));
+    EXPECT_TRUE(std::ranges::equal(a.adjacency().edges, b.adjacency().edges));
+    EXPECT_TRUE(std::ranges::equal(a.adjacency().weights, b.adjacency().weights));
+}
+
+static void test_apply_batch()
+{
+    Graph<int> g;
+    for (GraphIndex i = 0; i < 3; ++i) (void)g.create_node(static_cast<int>(i), i);
+    (void)g.add_edge(0, 1);
+    (void)g.add_edge(1, 2);
+    (void)g.add_edge(2, 0);
+
+    // Node 2 is dropped and re-created empty; 5 is new and used by an edge right away.
+    GraphBatch<int> batch;
+    batch.remove_edges = {{0, 1}, {0, 1}};
+    batch.remove_nodes = {2, 2, 8};
+    batch.add_nodes = {{2, 20}, {5, 50}, {0, 99}};
+    batch.add_edges = {{5, 0, 4}, {1, 5}, {2, 2}};
+
+    const auto r = g.apply(batch);
+    EXPECT_EQ(r.removed_edges.removed, 1zu);
+    EXPECT_EQ(r.removed_edges.edge_missing, 1zu);
+    EXPECT_EQ(r.nodes_removed, 1zu);
+    EXPECT_EQ(r.nodes_missing, 2zu);
+    EXPECT_EQ(r.nodes_added, 2zu);
+    EXPECT_EQ(r.nodes_rejected, 1zu);
+    EXPECT_EQ(r.added_edges.added, 2zu);
+    EXPECT_EQ(r.added_edges.self_loop, 1zu);
+
+    EXPECT_EQ(*g.value_by_idx(2), 20);
+    EXPECT_EQ(*g.value_by_idx(0), 0);
+    const auto csr = *g.freeze();
+    EXPECT_EQ(csr.edge_count(), 2zu);
+    EXPECT_TRUE(csr.contains_edge(*csr.dense_id(5), *csr.dense_id(0)));
+    EXPECT_TRUE(csr.contains_edge(*csr.dense_id(1), *csr.dense_id(5)));
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_auto_index_follows_max();
+    test_create_node_errors();
+    test_create_nodes_returns_contiguous_range();
+    test_create_nodes_near_index_limit();
+    test_add_edge_errors();
+    test_add_edges_reports_like_add_edge();
+    test_add_edges_matches_sequential_add_edge();
+    test_weighted_edges();
+    test_remove_edge_and_node();
+    test_remove_edges_matches_sequential_remove_edge();
+    test_apply_batch();
+    return 0;
+}
@@ -0,0 +1,202 @@
+// tests/test_graph_io.cpp
+#include "common.hpp"
+#include "graph.hpp"
+#include "graph_io.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <format>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace dsalgo::Test
+{
+
+static std::string temp_path(const char* name)
+{
+    return std::format("/tmp/dsalgo_test_{}_{}", ::getpid(), name);
+}
+
+static void write_file(const std::string& path, const std::string& text)
+{
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    EXPECT_TRUE(f != nullptr);
+    EXPECT_EQ(std::fwrite(text.data(), 1, text.size(), f), text.size());
+    std::fclose(f);
+}
+
+static void test_edge_list_basics()
+{
+    const std::string text = "# comment\n"
+                             "100\t7\n"
+                             "\n"
+                             "7 5000000000\r\n"
+                             "100 7\n"        // repeated
+                             "42 42\n"        // self-loop
+                             "  5000000000   100";
+    const auto g = parse_edge_list(text);
+    EXPECT_TRUE(g.has_value());
+    EXPECT_EQ(g->vertex_count(), 4zu); // 7, 42, 100, 5e9
+    EXPECT_EQ(g->edge_count(), 3zu);
+    EXPECT_TRUE(!g->adjacency().weighted());
+
+    const auto v7 = *g->dense_id(7);
+    const auto v100 = *g->dense_id(100);
+    const auto vbig = *g->dense_id(5'000'000'000);
+    EXPECT_TRUE(g->contains_edge(v100, v7));
+    EXPECT_TRUE(g->contains_edge(v7, vbig));
+    EXPECT_TRUE(g->contains_edge(vbig, v100));
+    EXPECT_EQ(g->degree(*g->dense_id(42)), 0zu);
+}
+
+static void test_edge_list_weights_and_errors()
+{
+    const auto g = parse_edge_list("1 2 10\n2 3\n1 2 4\n");
+    EXPECT_TRUE(g.has_value() && g->adjacency().weighted());
+    EXPECT_EQ(g->edge_weights(0)[0], 10u); // first of the repeats
+    EXPECT_EQ(g->edge_weights(1)[0], 1u);
+
+    // Same policy as Graph::add_edges, also when the repeats land in
+    // different parse chunks (about 1 MiB each).
+    std::string text = "1 2 9\n";
+    while (text.size() < 3 * (usize{1} << 20)) text += "3 4 2\n";
+    text += "1 2 3\n3 4 7\n";
+    const auto big = parse_edge_list(text);
+    EXPECT_TRUE(big.has_value());
+    EXPECT_EQ(big->edge_weights(*big->dense_id(1))[0], 9u);
+    EXPECT_EQ(big->edge_weights(*big->dense_id(3))[0], 2u);
+
+    using WE = Graph<int>::WeightedEdge;
+    Graph<int> built;
+    for (GraphIndex idx : {GraphIndex{1}, GraphIndex{2}}) (void)built.create_node(0, idx);
+    const std::vector<WE> repeats{{1, 2, 9}, {1, 2, 3}};
+    (void)built.add_edges(repeats);
+    EXPECT_EQ(built.freeze()->edge_weights(0)[0], 9u);
+
+    const auto bad = parse_edge_list("1 2\n3 x\n");
+    EXPECT_TRUE(!bad.has_value() && bad.error() == GraphIoError::ParseError);
+    EXPECT_TRUE(!parse_edge_list("1 2 3 4\n").has_value());
+    EXPECT_EQ(parse_edge_list("").value().vertex_count(), 0zu);
+}
+
+static void test_large_edge_list_matches_add_edges()
+{
+    // Big enough to be cut into several parse chunks.
+    std::string text;
+    std::vector<std::pair<GraphIndex, GraphIndex>> edges;
+    u64 state = 3;
+    for (usize i = 0; i < 300'000; ++i)
+    {
+        state = hash_int(state);
+        const GraphIndex a = (state % 20'000) * 1'000;
+        const GraphIndex b = ((state >> 32) % 20'000) * 1'000;
+        text += std::format("{} {}\n", a, b);
+        edges.emplace_back(a, b);
+    }
+    const auto parsed = parse_edge_list(text);
+    EXPECT_TRUE(parsed.has_value());
+
+    Graph<std::monostate> g;
+    for (GraphIndex id : parsed->external_ids()) (void)g.create_node({}, id);
+    (void)g.add_edges(edges);
+    const auto expected = *g.freeze();
+    EXPECT_TRUE(std::ranges::equal(parsed->adjacency().offsets, expected.adjacency().offsets));
+    EXPECT_TRUE(std::ranges::equal(parsed->adjacency().edges, expected.adjacency().edges));
+}
+
+static void test_matrix_market()
+{
+    const std::string text = "%%MatrixMarket matrix coordinate integer symmetric\n"
+                             "% a comment\n"
+                             "4 4 3\n"
+                             "2 1 5\n"
+                             "3 1 6\n"
+                             "4 4 1\n";
+    const auto g = parse_matrix_market(text);
+    EXPECT_TRUE(g.has_value());
+    EXPECT_EQ(g->vertex_count(), 4zu);
+    EXPECT_EQ(g->edge_count(), 4zu); // both directions, diagonal dropped
+    EXPECT_EQ(g->external_id(0), 1u);
+    EXPECT_TRUE(g->contains_edge(0, 1) && g->contains_edge(1, 0) && g->contains_edge(0, 2));
+    EXPECT_EQ(g->edge_weights(0)[1], 6u);
+
+    EXPECT_TRUE(parse_matrix_market("%%MatrixMarket matrix coordinate real general\n1 1 0\n").error() ==
+                GraphIoError::BadHeader);
+    EXPECT_TRUE(parse_matrix_market("%%MatrixMarket matrix coordinate pattern general\n2 2 1\n3 1\n").error() ==
+                GraphIoError::VertexOutOfRange);
+    EXPECT_TRUE(parse_matrix_market("%%MatrixMarket matrix coordinate pattern general\n2 2 2\n1 2\n").error() ==
+                GraphIoError::ParseError);
+}
+
+static void test_load_from_files()
+{
+    const std::string path = temp_path("edges.txt");
+    write_file(path, "1 2\n2 3\n");
+    const auto g = load_edge_list(path.c_str());
+    EXPECT_TRUE(g.has_value() && g->edge_count() == 2);
+    std::remove(path.c_str());
+
+    const auto missing = load_edge_list(path.c_str());
+    EXPECT_TRUE(!missing.has_value() && missing.error() == GraphIoError::OpenFailed);
+}
+
+static void test_binary_round_trip()
+{
+    const auto g = *parse_edge_list("900 5 3\n5 900 2\n5 70 9\n70 900 1\n");
+    const std::string path = temp_path("graph.csr");
+    EXPECT_TRUE(write_csr(path.c_str(), g).has_value());
+
+    const auto mapped = MappedCsr::open(path.c_str());
+    EXPECT_TRUE(mapped.has_value());
+    EXPECT_TRUE(mapped->validate());
+    EXPECT_EQ(mapped->vertex_count(), 3zu);
+    EXPECT_EQ(mapped->edge_count(), 4zu);
+    for (VertexId v = 0; v < 3; ++v)
+    {
+        EXPECT_TRUE(std::ranges::equal(mapped->neighbors(v), g.neighbors(v)));
+        EXPECT_TRUE(std::ranges::equal(mapped->edge_weights(v), g.edge_weights(v)));
+        EXPECT_EQ(mapped->dense_id(g.external_id(v)).value(), v);
+    }
+    EXPECT_TRUE(!mapped->dense_id(6).has_value());
+
+    const auto copy = mapped->to_csr_graph<int>();
+    EXPECT_EQ(copy.edge_count(), 4zu);
+    EXPECT_EQ(copy.dense_id(70).value(), g.dense_id(70).value());
+    std::remove(path.c_str());
+}
+
+static void test_binary_rejects_bad_files()
+{
+    const std::string path = temp_path("bad.csr");
+    write_file(path, "not a csr file at all, but long enough for a header");
+    EXPECT_TRUE(MappedCsr::open(path.c_str()).error() == GraphIoError::BadMagic);
+
+    const auto g = *parse_edge_list("1 2\n2 3\n");
+    EXPECT_TRUE(write_csr(path.c_str(), g).has_value());
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    std::string bytes(4096, '\0');
+    bytes.resize(std::fread(bytes.data(), 1, bytes.size(), f));
+    std::fclose(f);
+    bytes.resize(bytes.size() - 4);
+    write_file(path, bytes);
+    EXPECT_TRUE(MappedCsr::open(path.c_str()).error() == GraphIoError::Truncated);
+    std::remove(path.c_str());
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_edge_list_basics();
+    test_edge_list_weights_and_errors();
+    test_large_edge_list_matches_add_edges();
+    test_matrix_market();
+    test_load_from_files();
+    test_binary_round_trip();
+    test_binary_rejects_bad_files();
+    return 0;
+}
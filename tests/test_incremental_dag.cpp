@@ -0,0 +1,104 @@
+// tests/test_incremental_dag.cpp
+#include "common.hpp"
+#include "incremental_dag.hpp"
+#include "toposort.hpp"
+#include "util.hpp"
+
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static bool order_is_valid(const IncrementalDag& dag)
+{
+    for (VertexId v = 0; v < dag.vertex_count(); ++v)
+    {
+        if (dag.order()[dag.position(v)] != v) return false;
+        for (VertexId w : dag.successors(v))
+        {
+            if (dag.position(v) >= dag.position(w)) return false;
+        }
+    }
+    return true;
+}
+
+static bool reaches(const IncrementalDag& dag, VertexId from, VertexId to)
+{
+    std::vector<bool> seen(dag.vertex_count(), false);
+    std::vector<VertexId> stack{from};
+    seen[from] = true;
+    while (!stack.empty())
+    {
+        const VertexId u = stack.back();
+        stack.pop_back();
+        if (u == to) return true;
+        for (VertexId w : dag.successors(u))
+        {
+            if (!seen[w])
+            {
+                seen[w] = true;
+                stack.push_back(w);
+            }
+        }
+    }
+    return false;
+}
+
+static void test_errors()
+{
+    using E = IncrementalDag::AddEdgeError;
+    IncrementalDag dag{3};
+    EXPECT_TRUE(dag.add_edge(0, 1).has_value());
+    EXPECT_TRUE(dag.add_edge(1, 2).has_value());
+    EXPECT_TRUE(dag.add_edge(0, 1).error() == E::EdgeExists);
+    EXPECT_TRUE(dag.add_edge(1, 1).error() == E::SelfLoop);
+    EXPECT_TRUE(dag.add_edge(1, 7).error() == E::VertexMissing);
+    EXPECT_TRUE(dag.add_edge(2, 0).error() == E::CreatesCycle);
+    EXPECT_EQ(dag.edge_count(), 2zu);
+
+    // After removing 1 -> 2 the back edge is fine and the order adapts.
+    EXPECT_TRUE(dag.remove_edge(1, 2));
+    EXPECT_TRUE(!dag.remove_edge(1, 2));
+    EXPECT_TRUE(dag.add_edge(2, 0).has_value());
+    EXPECT_TRUE(dag.position(2) < dag.position(0));
+    EXPECT_TRUE(order_is_valid(dag));
+}
+
+static void test_random_insertions_match_reachability()
+{
+    constexpr usize n = 120;
+    IncrementalDag dag{n};
+    u64 state = 17;
+    usize rejected = 0;
+    for (usize i = 0; i < 3000; ++i)
+    {
+        state = hash_int(state);
+        const auto a = static_cast<VertexId>(state % n);
+        const auto b = static_cast<VertexId>((state >> 32) % n);
+        if (a == b || dag.contains_edge(a, b)) continue;
+
+        const bool cycle = reaches(dag, b, a);
+        const auto r = dag.add_edge(a, b);
+        EXPECT_EQ(r.has_value(), !cycle);
+        rejected += cycle;
+        if (i % 50 == 0) EXPECT_TRUE(order_is_valid(dag));
+    }
+    EXPECT_TRUE(rejected > 0);
+    EXPECT_TRUE(order_is_valid(dag));
+
+    // Vertices added later join at the end and can be wired in anywhere.
+    const VertexId extra = dag.add_vertex();
+    EXPECT_TRUE(dag.add_edge(extra, dag.order().front()).has_value());
+    EXPECT_TRUE(order_is_valid(dag));
+    EXPECT_TRUE(topological_sort(dag.to_csr()).acyclic());
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_errors();
+    test_random_insertions_match_reachability();
+    return 0;
+}
@@ -0,0 +1,91 @@
+// tests/test_kcore.cpp
+#include "common.hpp"
+#include "graph_fixtures.hpp"
+#include "kcore.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+// Reference: repeatedly strip every vertex of degree < k.
+static std::vector<u32> naive_cores(const CsrAdjacency& sym)
+{
+    const usize n = sym.vertex_count();
+    std::vector<u32> core(n, 0);
+    std::vector<bool> alive(n, true);
+    for (u32 k = 1;; ++k)
+    {
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (VertexId v = 0; v < n; ++v)
+            {
+                if (!alive[v]) continue;
+                usize d = 0;
+                for (VertexId u : sym.neighbors(v)) d += alive[u];
+                if (d < k)
+                {
+                    alive[v] = false;
+                    changed = true;
+                }
+            }
+        }
+        if (std::ranges::none_of(alive, [](bool a) { return a; })) return core;
+        for (usize v = 0; v < n; ++v) core[v] += alive[v];
+    }
+}
+
+static void test_small_graph()
+{
+    // K4 on {0..3}, a tail 3-4-5 and isolated 6.
+    const CsrAdjacency sym = CsrAdjacency::from_lists({{1, 2, 3}, {2, 3}, {3}, {4}, {5}, {}, {}}).symmetrized();
+    const CoreDecomposition d = core_decomposition(sym);
+    EXPECT_TRUE(d.core == (std::vector<u32>{3, 3, 3, 3, 1, 1, 0}));
+    EXPECT_EQ(d.degeneracy, 3u);
+}
+
+static void test_random_graph_matches_peeling()
+{
+    constexpr usize n = 400;
+    std::vector<std::vector<VertexId>> lists(n);
+    u64 state = 21;
+    for (usize i = 0; i < 2500; ++i)
+    {
+        state = hash_int(state);
+        // Skewed endpoints so the cores are nested several levels deep.
+        const auto u = static_cast<VertexId>(state % n);
+        const auto v = static_cast<VertexId>((state >> 32) % (1 + u % 97 + n / 4));
+        lists[u].push_back(v);
+    }
+    const CsrAdjacency sym = adjacency_from_unsorted(std::move(lists)).symmetrized();
+    const CoreDecomposition d = core_decomposition(sym);
+    EXPECT_TRUE(d.core == naive_cores(sym));
+    EXPECT_EQ(d.degeneracy, std::ranges::max(d.core));
+}
+
+static void test_empty_and_csr_graph()
+{
+    const CoreDecomposition empty = core_decomposition(CsrAdjacency{});
+    EXPECT_TRUE(empty.core.empty());
+    EXPECT_EQ(empty.degeneracy, 0u);
+
+    // Directed 3-cycle: undirected it is a triangle, a 2-core.
+    const CsrGraph<int> g({1, 2, 3}, {0, 0, 0}, CsrAdjacency::from_lists({{1}, {2}, {0}}));
+    EXPECT_TRUE(core_decomposition(g).core == (std::vector<u32>{2, 2, 2}));
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_small_graph();
+    test_random_graph_matches_peeling();
+    test_empty_and_csr_graph();
+    return 0;
+}
@@ -0,0 +1,304 @@
+// tests/test_matrix.cpp
+#include "common.hpp"
+#include "matrix.hpp"
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dsalgo::Test
+{
+template <typename A>
+static void fill(A& a, f64 seed)
+{
+    using V = typename A::value_type;
+    for (usize i = 0; i < a.rows(); ++i)
+    {
+        for (usize j = 0; j < a.cols(); ++j) a(i, j) = static_cast<V>(seed + static_cast<f64>(i * 7 + j * 3 % 5) * 0.25);
+    }
+}
+
+template <typename A, typename B, typename C>
+static DynMatrix<f64> reference_mul_add(const A& a, const B& b, const C& c)
+{
+    DynMatrix<f64> out(a.rows(), b.cols());
+    for (usize i = 0; i < a.rows(); ++i)
+    {
+        for (usize j = 0; j < b.cols(); ++j)
+        {
+            f64 sum = c(i, j);
+            for (usize p = 0; p < a.cols(); ++p) sum += a(i, p) * b(p, j);
+            out(i, j) = sum;
+        }
+    }
+    return out;
+}
+
+template <typename A, typename B>
+static void expect_same(const A& a, const B& b)
+{
+    EXPECT_EQ(a.rows(), b.rows());
+    EXPECT_EQ(a.cols(), b.cols());
+    for (usize i = 0; i < a.rows(); ++i)
+    {
+        for (usize j = 0; j < a.cols(); ++j) EXPECT_NEAR(a(i, j), b(i, j));
+    }
+}
+
+static void test_matrix_copy_move()
+{
+    auto a = Matrix<f32, 3, 3>::Diagonal(2.0f);
+    Matrix<f32, 3, 3> b = a;
+    b(0, 1) = 5.0f;
+    EXPECT_NEAR(a(0, 1), 0.0f);
+    EXPECT_NEAR(b(0, 0), 2.0f);
+
+    const f32* storage = b.data();
+    Matrix<f32, 3, 3> c = std::move(b);
+    EXPECT_TRUE(c.data() == storage);
+    EXPECT_NEAR(c(0, 1), 5.0f);
+
+    b = a; // moved-from matrices can be assigned again
+    EXPECT_NEAR(b(1, 1), 2.0f);
+    a = std::move(c);
+    EXPECT_NEAR(a(0, 1), 5.0f);
+
+    Matrix<f32, 2, 2> z{};
+    EXPECT_NEAR(z(1, 0), 0.0f);
+}
+
+static void test_small_matrix_constexpr()
+{
+    using M3 = SmallMatrix<f64, 3, 3>;
+    static_assert(std::is_trivially_copyable_v<M3>);
+    static_assert(sizeof(M3) == 9 * sizeof(f64));
+
+    constexpr auto product = [] {
+        M3 scale = M3::Diagonal(2.0);
+        M3 shear = M3::Diagonal();
+        shear(0, 1) = 3.0;
+        return scale * shear + M3::Diagonal();
+    }();
+    static_assert(nearly_equal(product(0, 0), 3.0, 0.0, 0.0));
+    static_assert(nearly_equal(product(0, 1), 6.0, 0.0, 0.0));
+    static_assert(nearly_equal(product(1, 0), 0.0, 0.0, 0.0));
+
+    constexpr SmallMatrix<f64, 2, 3> wide{{1, 2, 3, 4, 5, 6}};
+    constexpr auto gram = wide * wide.transposed();
+    static_assert(gram.rows() == 2 && gram.cols() == 2);
+    static_assert(nearly_equal(gram(0, 1), 32.0, 0.0, 0.0));
+    static_assert(nearly_equal(gram(1, 1), 77.0, 0.0, 0.0));
+
+    SmallMatrix32<2, 2> m{{1, 2, 3, 4}};
+    m += 2.0f * m;
+    m -= SmallMatrix32<2, 2>::Diagonal();
+    EXPECT_NEAR(m(0, 0), 2.0f);
+    EXPECT_NEAR(m(1, 0), 9.0f);
+}
+
+static void test_dyn_matrix()
+{
+    DynMatrix<f64> a(3, 5);
+    EXPECT_EQ(a.rows(), 3u);
+    EXPECT_EQ(a.cols(), 5u);
+    EXPECT_NEAR(a(2, 4), 0.0);
+    a(2, 4) = 1.5;
+    DynMatrix<f64> b = a;
+    b(2, 4) = 0.0;
+    EXPECT_NEAR(a(2, 4), 1.5);
+
+    const auto i = DynMatrix<f64>::identity(4);
+    EXPECT_NEAR(i(3, 3), 1.0);
+    EXPECT_NEAR(i(3, 2), 0.0);
+}
+
+static void test_fused_mul_add()
+{
+    for (usize n : {1u, 7u, 65u})
+    {
+        DynMatrix<f64> a(n, n + 3), b(n + 3, n), c(n, n);
+        fill(a, 0.5);
+        fill(b, -1.0);
+        fill(c, 2.0);
+        const auto expected = reference_mul_add(a, b, c);
+
+        DynMatrix<f64> d = a * b + c;
+        expect_same(d, expected);
+        DynMatrix<f64> e = c + a * b;
+        expect_same(e, expected);
+
+        // Assigning over an addend reuses it in place.
+        c = a * b + c;
+        expect_same(c, expected);
+    }
+
+    Matrix<f64, 4, 6> a;
+    Matrix<f64, 6, 4> b;
+    Matrix<f64, 4, 4> c;
+    fill(a, 1.0);
+    fill(b, 0.5);
+    fill(c, -2.0);
+    const auto expected = reference_mul_add(a, b, c);
+    Matrix<f64, 4, 4> d = a * b + c;
+    expect_same(d, expected);
+}
+
+static void test_elementwise_and_nested()
+{
+    DynMatrix<f64> a(4, 4), b(4, 4), c(4, 4);
+    fill(a, 1.0);
+    fill(b, 2.0);
+    fill(c, 3.0);
+
+    const DynMatrix<f64> lin = 2.0 * a - b * 0.5 + c;
+    for (usize i = 0; i < 4; ++i)
+    {
+        for (usize j = 0; j < 4; ++j) EXPECT_NEAR(lin(i, j), 2.0 * a(i, j) - 0.5 * b(i, j) + c(i, j));
+    }
+
+    // Products nested inside other expressions and chained products.
+    const DynMatrix<f64> ab = a * b;
+    const DynMatrix<f64> scaled = 3.0 * (a * b) - c;
+    for (usize i = 0; i < 4; ++i)
+    {
+        for (usize j = 0; j < 4; ++j) EXPECT_NEAR(scaled(i, j), 3.0 * ab(i, j) - c(i, j));
+    }
+    const DynMatrix<f64> abc = a * b * c;
+    const DynMatrix<f64> expected = reference_mul_add(ab, c, DynMatrix<f64>(4, 4));
+    expect_same(abc, expected);
+
+    // The destination appears as a product operand: evaluated via a temporary.
+    DynMatrix<f64> d = a;
+    d = d * b + c;
+    expect_same(d, reference_mul_add(a, b, c));
+
+    // Shape change on assignment.
+    DynMatrix<f64> tall(6, 2), wide(2, 6);
+    fill(tall, 1.0);
+    fill(wide, 1.0);
+    DynMatrix<f64> r(4, 4);
+    r = tall * wide;
+    EXPECT_EQ(r.rows(), 6u);
+    EXPECT_EQ(r.cols(), 6u);
+    expect_same(r, reference_mul_add(tall, wide, DynMatrix<f64>(6, 6)));
+}
+
+static void test_dimension_mismatch_throws()
+{
+    DynMatrix<f32> a(2, 3), b(2, 3), c(3, 3);
+    expect_exception([&] { (void)(a + c); }, "sum of mismatched shapes should throw");
+    expect_exception([&] { (void)(a * b); }, "product of mismatched shapes should throw");
+    Matrix<f32, 2, 2> fixed;
+    expect_exception([&] { fixed = a + b; }, "assigning a 2x3 into a 2x2 should throw");
+}
+
+static void test_padded_strides()
+{
+    static_assert(padded_stride<f32>(3) == 3);
+    static_assert(padded_stride<f64>(100) == 104);
+    static_assert(padded_stride<f32>(1024) == 1040); // 64 lines -> 65
+    static_assert(Matrix<f64, 2, 256>::stride() == 264);
+
+    DynMatrix<f32> wide(3, 512);
+    EXPECT_EQ(wide.stride(), 528u);
+    EXPECT_TRUE(reinterpret_cast<std::uintptr_t>(wide.row(2)) % cache_line_bytes == 0);
+    const DynMatrix<f32> packed(3, 512, 512);
+    EXPECT_EQ(packed.stride(), 512u);
+    expect_exception([] { DynMatrix<f32> bad(3, 512, 100); }, "stride shorter than a row should throw");
+
+    // Padding is invisible to products and expressions.
+    DynMatrix<f64> a(5, 256), b(256, 3), c(5, 3);
+    fill(a, 0.5);
+    fill(b, -1.0);
+    fill(c, 1.0);
+    const DynMatrix<f64> d = a * b + c;
+    expect_same(d, reference_mul_add(a, b, c));
+}
+
+static void test_layouts_and_transpose()
+{
+    DynMatrix<f64> r(37, 300);
+    fill(r, 1.0);
+
+    const DynMatrix<f64, Layout::ColMajor> c = r;
+    expect_same(c, r);
+    EXPECT_EQ(c.stride(), 37u);
+    EXPECT_NEAR(c.col(5)[2], r(2, 5));
+    const DynMatrix<f64> back = c;
+    expect_same(back, r);
+
+    const auto t = r.transposed();
+    EXPECT_EQ(t.rows(), 300u);
+    for (usize i = 0; i < r.rows(); ++i)
+    {
+        for (usize j = 0; j < r.cols(); ++j) EXPECT_NEAR(t(j, i), r(i, j));
+    }
+    const auto ct = c.transposed();
+    expect_same(ct, t);
+
+    auto moved = DynMatrix<f64>(r);
+    const f64* storage = moved.data();
+    const DynMatrix<f64, Layout::ColMajor> free_t = std::move(moved).into_transposed();
+    EXPECT_TRUE(free_t.data() == storage);
+    expect_same(free_t, t);
+
+    DynMatrix<f64> sq(70, 70);
+    fill(sq, 2.0);
+    auto sq_t = sq;
+    sq_t.transpose_in_place();
+    expect_same(sq_t, sq.transposed());
+    auto rect = r;
+    rect.transpose_in_place();
+    expect_same(rect, t);
+
+    Matrix<f32, 3, 5> m;
+    fill(m, 0.0);
+    const auto mt = m.transposed();
+    EXPECT_NEAR(mt(4, 1), m(1, 4));
+    Matrix<f32, 4, 4> ms;
+    fill(ms, 0.0);
+    auto ms_t = ms;
+    ms_t.transpose_in_place();
+    EXPECT_NEAR(ms_t(3, 0), ms(0, 3));
+}
+
+static void test_col_major_products()
+{
+    using ColMat = DynMatrix<f64, Layout::ColMajor>;
+    DynMatrix<f64> a(9, 70), b(70, 11), c(9, 11);
+    fill(a, 0.5);
+    fill(b, 1.5);
+    fill(c, -1.0);
+    const auto expected = reference_mul_add(a, b, c);
+
+    const ColMat ac = a, bc = b, cc = c;
+    const ColMat all_col = ac * bc + cc;
+    expect_same(all_col, expected);
+    // Mixed layouts convert the operands to the destination's layout.
+    const ColMat mixed = a * bc + c;
+    expect_same(mixed, expected);
+    const DynMatrix<f64> row_dst = ac * b + cc;
+    expect_same(row_dst, expected);
+    const ColMat scaled = 3.0 * cc - c;
+    for (usize i = 0; i < 9; ++i)
+    {
+        for (usize j = 0; j < 11; ++j) EXPECT_NEAR(scaled(i, j), 2.0 * c(i, j));
+    }
+}
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_matrix_copy_move();
+    test_small_matrix_constexpr();
+    test_dyn_matrix();
+    test_fused_mul_add();
+    test_elementwise_and_nested();
+    test_dimension_mismatch_throws();
+    test_padded_strides();
+    test_layouts_and_transpose();
+    test_col_major_products();
+    return 0;
+}
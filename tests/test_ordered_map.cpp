@@ -0,0 +1,213 @@
+// tests/test_ordered_map.cpp
+#include "common.hpp"
+#include "node_pool.hpp"
+#include "ordered_map.hpp"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static void test_empty_map()
+{
+    OrderedMap<u64, int> m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.size(), 0zu);
+    EXPECT_TRUE(m.find(1) == nullptr);
+    EXPECT_TRUE(!m.contains(1));
+    EXPECT_TRUE(!m.erase(1));
+    EXPECT_TRUE(m.begin() == m.end());
+    EXPECT_TRUE(m.lower_bound(0) == m.end());
+    EXPECT_EQ(m.height(), 0);
+}
+
+static void test_insert_find_overwrite()
+{
+    OrderedMap<u64, std::string> m;
+    EXPECT_TRUE(m.insert(5, "five"));
+    EXPECT_TRUE(m.insert(1, "one"));
+    EXPECT_TRUE(m.insert(9, "nine"));
+    EXPECT_EQ(m.size(), 3zu);
+
+    EXPECT_TRUE(!m.insert(5, "FIVE")); // overwrite
+    EXPECT_EQ(m.size(), 3zu);
+    EXPECT_EQ(*m.find(5), std::string{"FIVE"});
+
+    const auto& cm = m;
+    EXPECT_TRUE(cm.find(1) != nullptr);
+    EXPECT_EQ(*cm.find(9), std::string{"nine"});
+    EXPECT_TRUE(cm.find(2) == nullptr);
+}
+
+static void test_in_order_iteration_and_balance()
+{
+    // Sorted input is the worst case for an unbalanced BST.
+    OrderedMap<u32, u32> m;
+    constexpr u32 n = 1u << 14;
+    for (u32 i = 0; i < n; ++i) m.insert(i, i * 2);
+
+    EXPECT_EQ(m.size(), static_cast<usize>(n));
+    EXPECT_TRUE(m.height() <= 20); // AVL bound: < 1.44 * log2(n + 2)
+
+    u32 expected = 0;
+    for (const auto& [k, v] : m)
+    {
+        EXPECT_EQ(k, expected);
+        EXPECT_EQ(v, expected * 2);
+        ++expected;
+    }
+    EXPECT_EQ(expected, n);
+}
+
+static void test_lower_upper_bound_and_range()
+{
+    // Timestamps as in input.csv
+    OrderedMap<u64, u32> by_ts;
+    const u64 ts[] = {1000, 1003, 1005, 1007, 1010, 1012};
+    for (u32 i = 0; i < 6; ++i) by_ts.insert(ts[i], i);
+
+    EXPECT_EQ(by_ts.lower_bound(1003)->first, 1003u);
+    EXPECT_EQ(by_ts.lower_bound(1004)->first, 1005u);
+    EXPECT_EQ(by_ts.upper_bound(1005)->first, 1007u);
+    EXPECT_TRUE(by_ts.lower_bound(1013) == by_ts.end());
+    EXPECT_TRUE(by_ts.upper_bound(1012) == by_ts.end());
+    EXPECT_EQ(by_ts.lower_bound(0)->first, 1000u);
+
+    std::vector<u64> seen;
+    for (const auto& [k, v] : by_ts.range(1004, 1011)) seen.push_back(k);
+    EXPECT_EQ(seen, (std::vector<u64>{1005, 1007, 1010}));
+
+    EXPECT_TRUE(by_ts.range(1100, 1200).empty());
+
+    // Reversed bounds give an empty range rather than walking off the end.
+    EXPECT_TRUE(by_ts.range(1011, 1004).empty());
+    EXPECT_TRUE(std::as_const(by_ts).range(1012, 0).empty());
+    usize visited = 0;
+    for ([[maybe_unused]] const auto& kv : by_ts.range(1010, 1003)) ++visited;
+    EXPECT_EQ(visited, 0zu);
+}
+
+static void test_throwing_comparator_propagates()
+{
+    struct Picky
+    {
+        bool operator()(int a, int b) const
+        {
+            if (a < 0 || b < 0) throw std::invalid_argument("negative key");
+            return a < b;
+        }
+    };
+    OrderedMap<int, int, Picky> m;
+    for (int k = 0; k < 8; ++k) m.insert(k, k);
+    static_assert(!noexcept(m.lower_bound(1)));
+    EXPECT_THROW(m.lower_bound(-1));
+    EXPECT_THROW(m.range(2, -1));
+}
+
+static void test_erase_all_shapes()
+{
+    OrderedMap<int, int> m;
+    for (int k : {50, 30, 70, 20, 40, 60, 80, 35, 45, 65}) m.insert(k, k);
+
+    EXPECT_TRUE(m.erase(20)); // leaf
+    EXPECT_TRUE(m.erase(60)); // one child
+    EXPECT_TRUE(m.erase(30)); // two children, successor deeper
+    EXPECT_TRUE(m.erase(50)); // root
+    EXPECT_TRUE(!m.erase(50));
+    EXPECT_EQ(m.size(), 6zu);
+
+    std::vector<int> keys;
+    for (const auto& kv : m) keys.push_back(kv.first);
+    EXPECT_EQ(keys, (std::vector<int>{35, 40, 45, 65, 70, 80}));
+}
+
+static void test_randomized_against_std_map()
+{
+    std::mt19937_64 rng(42);
+    OrderedMap<u64, u64> m;
+    std::map<u64, u64> ref;
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        const u64 key = rng() % 2000;
+        if (rng() % 3 == 0)
+        {
+            EXPECT_EQ(m.erase(key), ref.erase(key) == 1);
+        }
+        else
+        {
+            const u64 val = rng();
+            EXPECT_EQ(m.insert(key, val), !ref.contains(key));
+            ref[key] = val;
+        }
+    }
+
+    EXPECT_EQ(m.size(), ref.size());
+    auto it = ref.begin();
+    for (const auto& [k, v] : m)
+    {
+        EXPECT_EQ(k, it->first);
+        EXPECT_EQ(v, it->second);
+        ++it;
+    }
+
+    for (u64 probe = 0; probe < 2001; probe += 7)
+    {
+        auto a = m.lower_bound(probe);
+        auto b = ref.lower_bound(probe);
+        EXPECT_EQ(a == m.end(), b == ref.end());
+        if (b != ref.end()) EXPECT_EQ(a->first, b->first);
+    }
+}
+
+static void test_move_only_values_and_move()
+{
+    OrderedMap<int, std::unique_ptr<int>> m;
+    m.insert(1, std::make_unique<int>(10));
+    m.insert(2, std::make_unique<int>(20));
+
+    OrderedMap<int, std::unique_ptr<int>> moved = std::move(m);
+    EXPECT_EQ(moved.size(), 2zu);
+    EXPECT_EQ(**moved.find(2), 20);
+}
+
+static void test_node_pool_recycles_slots()
+{
+    NodePool<u64, 4> pool;
+    u64* a = pool.create(1u);
+    u64* b = pool.create(2u);
+    EXPECT_EQ(pool.live(), 2zu);
+    EXPECT_EQ(pool.capacity(), 4zu);
+
+    pool.destroy(a);
+    u64* c = pool.create(3u);
+    EXPECT_TRUE(c == a); // free list is LIFO
+    EXPECT_EQ(*b, 2u);
+
+    for (u64 i = 0; i < 4; ++i) (void)pool.create(i);
+    EXPECT_EQ(pool.capacity(), 8zu);
+    EXPECT_EQ(pool.live(), 6zu);
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_empty_map();
+    test_insert_find_overwrite();
+    test_in_order_iteration_and_balance();
+    test_lower_upper_bound_and_range();
+    test_throwing_comparator_propagates();
+    test_erase_all_shapes();
+    test_randomized_against_std_map();
+    test_move_only_values_and_move();
+    test_node_pool_recycles_slots();
+    return 0;
+}
@@ -0,0 +1,123 @@
+// tests/test_parallel.cpp
+#include "common.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static void test_run_visits_every_task_once()
+{
+    ThreadPool pool{4};
+    EXPECT_EQ(pool.thread_count(), 4zu);
+
+    std::vector<std::atomic<int>> hits(1000);
+    std::vector<std::atomic<int>> per_worker(pool.thread_count());
+    for (int round = 0; round < 20; ++round)
+    {
+        pool.run(hits.size(), [&](usize task, usize worker) {
+            hits[task].fetch_add(1);
+            per_worker[worker].fetch_add(1);
+        });
+    }
+    for (const auto& h : hits) EXPECT_EQ(h.load(), 20);
+
+    int total = 0;
+    for (const auto& w : per_worker) total += w.load();
+    EXPECT_EQ(total, 20000);
+}
+
+static void test_nested_run_executes_inline()
+{
+    ThreadPool pool{3};
+    std::atomic<usize> sum{0};
+    pool.run(8, [&](usize outer, usize worker) {
+        pool.run(8, [&](usize inner, usize inner_worker) {
+            EXPECT_EQ(inner_worker, worker);
+            sum.fetch_add(outer * 8 + inner);
+        });
+    });
+    EXPECT_EQ(sum.load(), 63zu * 64 / 2);
+}
+
+static void test_exception_propagates()
+{
+    ThreadPool pool{4};
+    expect_exception([&] {
+        pool.run(100, [](usize task, usize) {
+            if (task == 37) throw std::runtime_error("task failed");
+        });
+    }, "run should rethrow a task exception");
+
+    // The pool stays usable afterwards.
+    std::atomic<usize> count{0};
+    pool.run(50, [&](usize, usize) { count.fetch_add(1); });
+    EXPECT_EQ(count.load(), 50zu);
+}
+
+static void test_parallel_for_covers_range()
+{
+    std::vector<int> data(10007, 0);
+    parallel_for(3, data.size(), [&](usize i) { data[i] = static_cast<int>(i); }, 64);
+    for (usize i = 0; i < data.size(); ++i) EXPECT_EQ(data[i], i < 3 ? 0 : static_cast<int>(i));
+
+    usize chunks = 0;
+    parallel_for_range(5, 5, 16, [&](usize, usize, usize) { ++chunks; });
+    EXPECT_EQ(chunks, 0zu);
+}
+
+static void test_parallel_sum()
+{
+    const u64 total = parallel_sum<u64>(1, 100'001, [](usize i) { return static_cast<u64>(i); }, 128);
+    EXPECT_EQ(total, 100'000ull * 100'001 / 2);
+    EXPECT_EQ(parallel_sum<u64>(7, 7, [](usize) { return u64{1}; }), 0u);
+}
+
+static void test_parallel_sort()
+{
+    for (usize n : {0zu, 10zu, 100'000zu, 123'457zu})
+    {
+        std::vector<u64> data(n);
+        u64 state = n;
+        for (u64& x : data) x = state = state * 6364136223846793005ull + 1442695040888963407ull;
+        std::vector<u64> expected = data;
+        std::ranges::sort(expected);
+        parallel_sort(data.begin(), data.end());
+        EXPECT_TRUE(data == expected);
+    }
+
+    std::vector<int> desc{3, 9, 1, 7};
+    parallel_sort(desc.begin(), desc.end(), std::ranges::greater{});
+    EXPECT_TRUE((desc == std::vector<int>{9, 7, 3, 1}));
+}
+
+static void test_single_thread_pool()
+{
+    ThreadPool pool{1};
+    usize count = 0;
+    pool.run(10, [&](usize, usize worker) {
+        EXPECT_EQ(worker, 0zu);
+        ++count;
+    });
+    EXPECT_EQ(count, 10zu);
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_run_visits_every_task_once();
+    test_nested_run_executes_inline();
+    test_exception_propagates();
+    test_parallel_for_covers_range();
+    test_parallel_sum();
+    test_parallel_sort();
+    test_single_thread_pool();
+    return 0;
+}
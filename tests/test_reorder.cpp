@@ -0,0 +1,133 @@
+// tests/test_reorder.cpp
+#include "common.hpp"
+#include "graph_fixtures.hpp"
+#include "graph.hpp"
+#include "reorder.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+// A path 0 - 1 - ... - n-1 (both directions) with its vertices shuffled.
+static CsrAdjacency shuffled_path(usize n)
+{
+    u64 state = 17;
+    const std::vector<VertexId> name = random_permutation(n, state);
+    std::vector<std::vector<VertexId>> lists(n);
+    for (usize i = 0; i + 1 < n; ++i)
+    {
+        lists[name[i]].push_back(name[i + 1]);
+        lists[name[i + 1]].push_back(name[i]);
+    }
+    for (auto& list : lists) std::ranges::sort(list);
+    return CsrAdjacency::from_lists(lists);
+}
+
+static u64 bandwidth(const CsrAdjacency& g)
+{
+    u64 b = 0;
+    for (VertexId u = 0; u < g.vertex_count(); ++u)
+    {
+        for (VertexId v : g.neighbors(u)) b = std::max<u64>(b, u > v ? u - v : v - u);
+    }
+    return b;
+}
+
+static void expect_permutation(const Permutation& p, usize n)
+{
+    EXPECT_EQ(p.size(), n);
+    for (usize i = 0; i < n; ++i) EXPECT_EQ(p.old_to_new[p.new_to_old[i]], i);
+}
+
+static void expect_isomorphic(const CsrAdjacency& a, const CsrAdjacency& b, const Permutation& p)
+{
+    EXPECT_EQ(a.edge_count(), b.edge_count());
+    for (VertexId u = 0; u < a.vertex_count(); ++u)
+    {
+        const VertexId nu = p.old_to_new[u];
+        EXPECT_TRUE(std::ranges::is_sorted(b.neighbors(nu)));
+        for (usize k = 0; k < a.degree(u); ++k)
+        {
+            const VertexId nv = p.old_to_new[a.neighbors(u)[k]];
+            const auto ns = b.neighbors(nu);
+            const auto it = std::ranges::lower_bound(ns, nv);
+            EXPECT_TRUE(it != ns.end() && *it == nv);
+            EXPECT_EQ(b.weight(b.offsets[nu] + static_cast<u64>(it - ns.begin())), a.weight(a.offsets[u] + k));
+        }
+    }
+}
+
+static void test_rcm_recovers_path_bandwidth()
+{
+    const CsrAdjacency g = shuffled_path(5000);
+    EXPECT_TRUE(bandwidth(g) > 100);
+    const auto p = rcm_order(g, g.transposed());
+    expect_permutation(p, 5000);
+    const CsrAdjacency r = permute(g, p);
+    expect_isomorphic(g, r, p);
+    EXPECT_EQ(bandwidth(r), 1u);
+}
+
+static void test_bfs_order_is_discovery_order()
+{
+    const CsrAdjacency g = CsrAdjacency::from_lists({{3}, {}, {0}, {2, 4}, {}, {1}});
+    const auto p = bfs_order(g, 3);
+    EXPECT_TRUE((p.new_to_old == std::vector<VertexId>{3, 2, 4, 0, 1, 5}));
+    expect_isomorphic(g, permute(g, p), p);
+}
+
+static void test_degree_order_keeps_weights()
+{
+    CsrAdjacency g = CsrAdjacency::from_lists({{1}, {0, 2, 3}, {1, 3}, {}});
+    g.weights = {5, 6, 7, 8, 9, 10};
+    const auto p = degree_order(g);
+    EXPECT_TRUE((p.new_to_old == std::vector<VertexId>{1, 2, 0, 3}));
+    expect_isomorphic(g, permute(g, p), p);
+}
+
+static void test_reorder_frozen_graph_keeps_external_ids()
+{
+    Graph<int> g;
+    for (GraphIndex idx = 0; idx < 6; ++idx) (void)g.create_node(static_cast<int>(idx) * 10, idx * 100);
+    const std::vector<std::pair<GraphIndex, GraphIndex>> edges{{0, 500}, {500, 300}, {300, 100}, {500, 200}};
+    (void)g.add_edges(edges);
+    const auto frozen = *g.freeze();
+
+    for (VertexOrder order : {VertexOrder::Degree, VertexOrder::ReverseCuthillMcKee, VertexOrder::Bfs})
+    {
+        const auto r = reorder(frozen, order);
+        expect_isomorphic(frozen.adjacency(), r.graph.adjacency(), r.permutation);
+        for (GraphIndex idx = 0; idx < 6; ++idx)
+        {
+            const VertexId v = r.graph.dense_id(idx * 100).value();
+            EXPECT_EQ(r.graph.external_id(v), idx * 100);
+            EXPECT_EQ(r.graph.value(v), static_cast<int>(idx) * 10);
+        }
+        EXPECT_TRUE(!r.graph.dense_id(50).has_value());
+    }
+}
+
+static void test_relabeled_rejects_duplicate_ids()
+{
+    CsrAdjacency adj;
+    adj.offsets = {0, 0, 0};
+    EXPECT_NO_THROW(CsrGraph<int>::relabeled({9, 4}, {0, 0}, adj));
+    EXPECT_THROW(CsrGraph<int>::relabeled({4, 4}, {0, 0}, adj));
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_rcm_recovers_path_bandwidth();
+    test_bfs_order_is_discovery_order();
+    test_degree_order_keeps_weights();
+    test_reorder_frozen_graph_keeps_external_ids();
+    test_relabeled_rejects_duplicate_ids();
+    return 0;
+}
@@ -0,0 +1,204 @@
+// tests/test_soa.cpp
+#include "common.hpp"
+#include "soa.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace dsalgo::Test
+{
+// Odd sizes so every kernel runs both its vector body and its scalar tail,
+// and one past the parallel grain so the work is split into tasks.
+static constexpr usize sizes[] = {0, 1, 13, (usize{1} << 14) + 37};
+
+template <typename T>
+static T coord(usize i, usize d)
+{
+    return static_cast<T>(static_cast<f64>((i * 37 + d * 11) % 101) * 0.25 - 12.0);
+}
+
+template <typename T, usize Dim>
+static VecSoA<T, Dim> make_points(usize n)
+{
+    VecSoA<T, Dim> v(n);
+    for (usize d = 0; d < Dim; ++d)
+    {
+        for (usize i = 0; i < n; ++i) v.lane(d)[i] = coord<T>(i, d);
+    }
+    return v;
+}
+
+static void test_container()
+{
+    const std::vector<Vec3f> points = {{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}};
+    Vec3fSoA soa{std::span<const Vec3f>{points}};
+    EXPECT_EQ(soa.size(), 2u);
+    EXPECT_NEAR(soa.y()[1], 5.0f);
+    soa.push_back(Vec3f{7.0f, 8.0f, 9.0f});
+    EXPECT_EQ(soa.size(), 3u);
+    EXPECT_NEAR(soa.get(2).z, 9.0f);
+    soa.set(0, Vec3f{-1.0f, -2.0f, -3.0f});
+    const auto aos = soa.to_aos();
+    EXPECT_NEAR(aos[0].x, -1.0f);
+    EXPECT_NEAR(aos[1].z, 6.0f);
+    EXPECT_TRUE(reinterpret_cast<std::uintptr_t>(soa.z().data()) % cache_line_bytes == 0);
+
+    Vec4dSoA h;
+    h.push_back(Vec4d{1.0, 2.0, 3.0, 1.0});
+    EXPECT_NEAR(h.w()[0], 1.0);
+}
+
+template <typename T>
+static void test_transform_points()
+{
+    SmallMatrix<T, 4, 4> m{{0, -1, 0, 5, 1, 0, 0, -2, 0, 0, 2, 1, 0, 0, 0, 1}};
+    for (usize n : sizes)
+    {
+        const auto in = make_points<T, 3>(n);
+        VecSoA<T, 3> out;
+        transform_points(m, in, out);
+        EXPECT_EQ(out.size(), n);
+        for (usize i = 0; i < n; ++i)
+        {
+            EXPECT_NEAR(out.x()[i], -in.y()[i] + T{5});
+            EXPECT_NEAR(out.y()[i], in.x()[i] - T{2});
+            EXPECT_NEAR(out.z()[i], T{2} * in.z()[i] + T{1});
+        }
+
+        auto in_place = in;
+        transform_points(m, in_place, in_place);
+        for (usize i = 0; i < n; ++i) EXPECT_NEAR(in_place.x()[i], out.x()[i]);
+    }
+}
+
+template <typename T>
+static void test_transform_homogeneous()
+{
+    SmallMatrix<T, 4, 4> m{};
+    for (usize r = 0; r < 4; ++r)
+    {
+        for (usize c = 0; c < 4; ++c) m(r, c) = static_cast<T>(r * 4 + c) * static_cast<T>(0.5) - T{3};
+    }
+    for (usize n : sizes)
+    {
+        const auto in = make_points<T, 4>(n);
+        VecSoA<T, 4> out;
+        transform(m, in, out);
+        for (usize i = 0; i < n; ++i)
+        {
+            for (usize r = 0; r < 4; ++r)
+            {
+                T expect{0};
+                for (usize c = 0; c < 4; ++c) expect += m(r, c) * in.lane(c)[i];
+                EXPECT_TRUE(nearly_equal(out.lane(r)[i], expect, static_cast<T>(1e-5), static_cast<T>(1e-4)));
+            }
+        }
+    }
+}
+
+template <typename T>
+static void test_dot_cross_normalize()
+{
+    for (usize n : sizes)
+    {
+        const auto a = make_points<T, 3>(n);
+        auto b = make_points<T, 3>(n);
+        for (usize i = 0; i < n; ++i) b.x()[i] += T{1};
+
+        std::vector<T> d(n);
+        dot(a, b, std::span<T>{d});
+        VecSoA<T, 3> c;
+        cross(a, b, c);
+        for (usize i = 0; i < n; ++i)
+        {
+            const auto u = a.get(i);
+            const auto v = b.get(i);
+            EXPECT_NEAR(d[i], u.x * v.x + u.y * v.y + u.z * v.z);
+            EXPECT_NEAR(c.x()[i], u.y * v.z - u.z * v.y);
+            EXPECT_NEAR(c.y()[i], u.z * v.x - u.x * v.z);
+            EXPECT_NEAR(c.z()[i], u.x * v.y - u.y * v.x);
+        }
+
+        auto unit = a;
+        normalize(unit);
+        std::vector<T> len2(n);
+        dot(unit, unit, std::span<T>{len2});
+        for (usize i = 0; i < n; ++i)
+        {
+            const auto u = a.get(i);
+            if (!(u.x * u.x + u.y * u.y + u.z * u.z > T{0})) continue;
+            EXPECT_TRUE(nearly_equal(len2[i], T{1}, static_cast<T>(1e-5), static_cast<T>(1e-5)));
+        }
+    }
+
+    VecSoA<T, 4> zero(5);
+    zero.x()[2] = T{3};
+    zero.w()[2] = T{4};
+    normalize(zero);
+    EXPECT_NEAR(zero.x()[0], T{0});
+    EXPECT_NEAR(zero.w()[4], T{0});
+    EXPECT_NEAR(zero.x()[2], static_cast<T>(0.6));
+    EXPECT_NEAR(zero.w()[2], static_cast<T>(0.8));
+}
+
+static void test_size_mismatch_throws()
+{
+    const auto a = make_points<f32, 3>(8);
+    const auto shorter = make_points<f32, 3>(7);
+    std::vector<f32> d(8);
+    expect_exception([&] { dot(a, shorter, std::span<f32>{d}); }, "dot must reject inputs of different sizes");
+    expect_exception([&] { dot(a, a, std::span<f32>{d}.first(7)); }, "dot must reject a short output");
+    dot(a, a, std::span<f32>{d});
+
+    VecSoA<f32, 3> c(3);
+    expect_exception([&] { cross(a, shorter, c); }, "cross must reject inputs of different sizes");
+    cross(a, a, c);
+    EXPECT_EQ(c.size(), 8zu);
+}
+
+template <typename T>
+static void test_bounds()
+{
+    for (usize n : sizes)
+    {
+        const auto v = make_points<T, 3>(n);
+        const auto box = bounds(v);
+        EXPECT_EQ(box.empty(), n == 0);
+        for (usize d = 0; d < 3 && n > 0; ++d)
+        {
+            T mn = v.lane(d)[0];
+            T mx = mn;
+            for (T x : v.lane(d))
+            {
+                mn = std::min(mn, x);
+                mx = std::max(mx, x);
+            }
+            EXPECT_NEAR(box.min[d], mn);
+            EXPECT_NEAR(box.max[d], mx);
+        }
+    }
+
+    VecSoA<T, 3> one;
+    one.push_back({T{1}, T{-2}, T{3}});
+    const auto box = bounds(one);
+    EXPECT_NEAR(box.min[1], T{-2});
+    EXPECT_NEAR(box.max[1], T{-2});
+}
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_container();
+    test_transform_points<dsalgo::f32>();
+    test_transform_points<dsalgo::f64>();
+    test_transform_homogeneous<dsalgo::f32>();
+    test_transform_homogeneous<dsalgo::f64>();
+    test_dot_cross_normalize<dsalgo::f32>();
+    test_dot_cross_normalize<dsalgo::f64>();
+    test_size_mismatch_throws();
+    test_bounds<dsalgo::f32>();
+    test_bounds<dsalgo::f64>();
+    return 0;
+}
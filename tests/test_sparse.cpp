@@ -0,0 +1,281 @@
+// tests/test_sparse.cpp
+#include "common.hpp"
+#include "sparse.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace dsalgo::Test
+{
+// Deterministic pseudo-random pattern with a few much longer rows, so the
+// balanced row blocks and the SELL length sort both have something to do.
+template <typename T>
+static CsrMatrix<T> make_matrix(usize rows, usize cols)
+{
+    CooMatrix<T> coo{rows, cols};
+    u64 state = 0x9e3779b97f4a7c15ull;
+    const auto next = [&] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (usize r = 0; r < rows; ++r)
+    {
+        const usize len = (r % 97 == 5) ? cols / 2 : next() % 9;
+        for (usize j = 0; j < len; ++j)
+        {
+            const auto c = static_cast<SparseIndex>(next() % cols);
+            coo.add(static_cast<SparseIndex>(r), c, static_cast<T>(static_cast<f64>(next() % 17) * 0.125 - 1.0));
+        }
+    }
+    return to_csr(coo);
+}
+
+template <typename T>
+static std::vector<T> make_vector(usize n, f64 seed)
+{
+    std::vector<T> x(n);
+    for (usize i = 0; i < n; ++i) x[i] = static_cast<T>(seed + static_cast<f64>(i % 13) * 0.5);
+    return x;
+}
+
+template <typename T>
+static std::vector<T> reference_spmv(const CsrMatrix<T>& a, const std::vector<T>& x)
+{
+    std::vector<T> y(a.rows);
+    for (usize r = 0; r < a.rows; ++r)
+    {
+        T sum{0};
+        for (u64 e = a.offsets[r]; e < a.offsets[r + 1]; ++e) sum += a.values[e] * x[a.indices[e]];
+        y[r] = sum;
+    }
+    return y;
+}
+
+template <typename T>
+static void expect_close(const std::vector<T>& got, const std::vector<T>& expected)
+{
+    EXPECT_EQ(got.size(), expected.size());
+    for (usize i = 0; i < got.size(); ++i)
+    {
+        EXPECT_TRUE(nearly_equal(got[i], expected[i], static_cast<T>(1e-4), static_cast<T>(1e-4)));
+    }
+}
+
+static void test_coo_to_csr()
+{
+    CooMatrix<f64> coo{3, 4};
+    coo.add(2, 1, 1.0);
+    coo.add(0, 3, 2.0);
+    coo.add(0, 1, 3.0);
+    coo.add(2, 1, 0.5); // repeat, summed
+    const auto csr = to_csr(coo);
+    EXPECT_EQ(csr.nnz(), 3u);
+    EXPECT_TRUE((csr.offsets == std::vector<u64>{0, 2, 2, 3}));
+    EXPECT_TRUE((csr.indices == std::vector<SparseIndex>{1, 3, 1}));
+    EXPECT_NEAR(csr.values[0], 3.0);
+    EXPECT_NEAR(csr.values[2], 1.5);
+    EXPECT_EQ(csr.row_indices(1).size(), 0u);
+
+    const auto dense = csr.to_dense();
+    EXPECT_NEAR(dense(0, 3), 2.0);
+    EXPECT_NEAR(dense(1, 1), 0.0);
+
+    const auto t = csr.transposed();
+    EXPECT_EQ(t.rows, 4u);
+    EXPECT_TRUE((t.offsets == std::vector<u64>{0, 0, 2, 2, 3}));
+    EXPECT_TRUE((t.indices == std::vector<SparseIndex>{0, 2, 0}));
+    EXPECT_NEAR(t.values[1], 1.5);
+
+    expect_exception([&] { coo.add(3, 0, 1.0); }, "entry outside the matrix should throw");
+    expect_exception([] { CooMatrix<f32> huge{max_sparse_dimension + 1, 1}; }, "oversized matrix should throw");
+}
+
+static void test_round_trips()
+{
+    const auto a = make_matrix<f64>(300, 200);
+    const auto csc = to_csc(a);
+    EXPECT_EQ(csc.rows, 300u);
+    EXPECT_EQ(csc.cols, 200u);
+    EXPECT_EQ(csc.nnz(), a.nnz());
+    for (usize j = 0; j < csc.cols; ++j)
+    {
+        const auto rows = csc.col_indices(j);
+        const auto vals = csc.col_values(j);
+        for (usize e = 0; e < rows.size(); ++e)
+        {
+            if (e > 0) EXPECT_TRUE(rows[e - 1] < rows[e]);
+            const auto cols = a.row_indices(rows[e]);
+            const auto it = std::ranges::lower_bound(cols, static_cast<SparseIndex>(j));
+            EXPECT_TRUE(it != cols.end() && *it == j);
+            EXPECT_NEAR(a.row_values(rows[e])[static_cast<usize>(it - cols.begin())], vals[e]);
+        }
+    }
+
+    const auto back = to_csr(csc);
+    EXPECT_TRUE(back.offsets == a.offsets);
+    EXPECT_TRUE(back.indices == a.indices);
+    const auto again = to_csr(to_coo(a));
+    EXPECT_TRUE(again.offsets == a.offsets);
+    EXPECT_TRUE(again.indices == a.indices);
+    for (usize e = 0; e < a.nnz(); ++e)
+    {
+        EXPECT_NEAR(back.values[e], a.values[e]);
+        EXPECT_NEAR(again.values[e], a.values[e]);
+    }
+}
+
+static void test_from_graph()
+{
+    // Row 0 is stored unsorted: (0, 2) = 3 before (0, 1) = 2.
+    CsrAdjacency adj;
+    adj.edges = {2, 1, 0};
+    adj.weights = {3, 2, 4};
+    adj.offsets = {0, 2, 2, 3};
+    const auto m = to_csr<f32>(adj);
+    EXPECT_TRUE((m.indices == std::vector<SparseIndex>{1, 2, 0}));
+    EXPECT_NEAR(m.values[0], 2.0f);
+    EXPECT_NEAR(m.values[1], 3.0f);
+    const auto ones = to_csr<f32>(adj, EdgeValues::Ones);
+    EXPECT_NEAR(ones.values[1], 1.0f);
+
+    Graph<int> g;
+    (void)g.create_node(0, 10);
+    (void)g.create_node(1, 20);
+    (void)g.create_node(2, 30);
+    EXPECT_TRUE(g.add_edge(10, 30, 5).has_value());
+    EXPECT_TRUE(g.add_edge(30, 20).has_value());
+    const auto from_graph = to_csr<f64>(g);
+    EXPECT_TRUE(from_graph.has_value());
+    EXPECT_EQ(from_graph->rows, 3u);
+    const auto dense = from_graph->to_dense();
+    EXPECT_NEAR(dense(0, 2), 5.0);
+    EXPECT_NEAR(dense(2, 1), static_cast<f64>(default_edge_weight));
+    EXPECT_NEAR(dense(1, 0), 0.0);
+}
+
+template <typename T>
+static void test_spmv_matches_reference()
+{
+    // The last size has enough entries to be split into several tasks.
+    for (const auto& [rows, cols] : {std::pair<usize, usize>{0, 0}, {1, 1}, {37, 19}, {20'000, 3'001}})
+    {
+        const auto a = make_matrix<T>(rows, cols);
+        const auto x = make_vector<T>(cols, 0.25);
+        std::vector<T> y(rows, T{-1});
+        spmv(a, x, y);
+        expect_close(y, reference_spmv(a, x));
+
+        // A^T x through the CSC view against the explicitly transposed CSR.
+        const auto xt = make_vector<T>(rows, -1.0);
+        std::vector<T> yt(cols);
+        spmv_transposed(to_csc(a), xt, yt);
+        expect_close(yt, reference_spmv(a.transposed(), xt));
+
+        for (usize sigma : {usize{1}, SellMatrix<T>::chunk, usize{1} << 20})
+        {
+            const auto sell = SellMatrix<T>::from_csr(a, sigma);
+            EXPECT_EQ(sell.nnz(), a.nnz());
+            EXPECT_TRUE(sell.fill_ratio() <= 1.0);
+            std::vector<T> ys(rows, T{-1});
+            spmv(sell, x, ys);
+            expect_close(ys, reference_spmv(a, x));
+        }
+    }
+}
+
+template <typename T>
+static void test_sell_padding_ignores_non_finite_x()
+{
+    // Column 0 is only touched by row 0; the padding (column 0, value 0) of
+    // the shorter rows must not turn them into NaN.
+    CooMatrix<T> coo{40, 8};
+    for (usize r = 0; r < 40; ++r)
+    {
+        for (usize j = 1; j <= r % 5; ++j) coo.add(static_cast<SparseIndex>(r), static_cast<SparseIndex>(j), T{1});
+    }
+    coo.add(0, 0, T{2});
+    const auto a = to_csr(coo);
+    for (T bad : {std::numeric_limits<T>::infinity(), std::numeric_limits<T>::quiet_NaN()})
+    {
+        auto x = make_vector<T>(a.cols, 1.0);
+        x[0] = bad;
+        std::vector<T> y(a.rows);
+        spmv(a, x, y);
+        for (usize sigma : {usize{1}, usize{64}})
+        {
+            std::vector<T> ys(a.rows);
+            spmv(SellMatrix<T>::from_csr(a, sigma), x, ys);
+            EXPECT_TRUE(!std::isfinite(ys[0]));
+            for (usize r = 1; r < a.rows; ++r) EXPECT_TRUE(std::isfinite(ys[r]) && nearly_equal(ys[r], y[r], static_cast<T>(1e-4), static_cast<T>(1e-4)));
+        }
+    }
+}
+
+static void test_sell_sorting_reduces_padding()
+{
+    // Rows alternate between 1 and 16 entries; sorting within sigma groups
+    // the long rows together.
+    CooMatrix<f32> coo{256, 64};
+    for (usize r = 0; r < 256; ++r)
+    {
+        const usize len = r % 2 == 0 ? 1 : 16;
+        for (usize j = 0; j < len; ++j) coo.add(static_cast<SparseIndex>(r), static_cast<SparseIndex>(j * 3), 1.0f);
+    }
+    const auto a = to_csr(coo);
+    const auto unsorted = SellMatrix<f32>::from_csr(a, 1);
+    const auto sorted = SellMatrix<f32>::from_csr(a, 256);
+    EXPECT_EQ(sorted.sigma, 256u);
+    if constexpr (SellMatrix<f32>::chunk > 1)
+    {
+        EXPECT_TRUE(sorted.fill_ratio() > unsorted.fill_ratio());
+    }
+    EXPECT_TRUE(sorted.fill_ratio() > 0.99);
+}
+
+template <typename T>
+static void test_spmm_matches_dense()
+{
+    const auto a = make_matrix<T>(513, 130);
+    const auto dense = a.to_dense();
+    for (usize k : {usize{1}, Simd<T>::lanes + 3, usize{70}})
+    {
+        DynMatrix<T> x(a.cols, k);
+        for (usize i = 0; i < x.rows(); ++i)
+        {
+            for (usize j = 0; j < k; ++j) x(i, j) = static_cast<T>(static_cast<f64>((i * 5 + j) % 11) * 0.5 - 2.0);
+        }
+        const DynMatrix<T> y = spmm(a, x);
+        EXPECT_EQ(y.rows(), a.rows);
+        EXPECT_EQ(y.cols(), k);
+        for (usize i = 0; i < y.rows(); ++i)
+        {
+            for (usize j = 0; j < k; ++j)
+            {
+                T expect{0};
+                for (usize p = 0; p < a.cols; ++p) expect += dense(i, p) * x(p, j);
+                EXPECT_TRUE(nearly_equal(y(i, j), expect, static_cast<T>(1e-4), static_cast<T>(1e-4)));
+            }
+        }
+    }
+    expect_exception([&] { (void)spmm(a, DynMatrix<T>(a.cols + 1, 2)); }, "spmm with mismatched shapes should throw");
+}
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_coo_to_csr();
+    test_round_trips();
+    test_from_graph();
+    test_spmv_matches_reference<dsalgo::f32>();
+    test_spmv_matches_reference<dsalgo::f64>();
+    test_sell_padding_ignores_non_finite_x<dsalgo::f32>();
+    test_sell_padding_ignores_non_finite_x<dsalgo::f64>();
+    test_sell_sorting_reduces_padding();
+    test_spmm_matches_dense<dsalgo::f32>();
+    test_spmm_matches_dense<dsalgo::f64>();
+    return 0;
+}
@@ -0,0 +1,103 @@
+// tests/test_spmv.cpp
+#include "common.hpp"
+#include "graph_fixtures.hpp"
+#include "spmv.hpp"
+
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static CsrAdjacency small_matrix()
+{
+    // Row 0: (0, 1) = 2, (0, 2) = 3; row 1: empty; row 2: (2, 0) = 4
+    CsrAdjacency a;
+    a.edges = {1, 2, 0};
+    a.weights = {2, 3, 4};
+    a.offsets = {0, 2, 2, 3};
+    return a;
+}
+
+static void test_weighted_and_pattern_products()
+{
+    const CsrAdjacency a = small_matrix();
+    const std::vector<double> x{1.0, 10.0, 100.0};
+    std::vector<double> y(3, -1.0);
+
+    spmv<double>(a, x, y);
+    EXPECT_NEAR(y[0], 320.0);
+    EXPECT_NEAR(y[1], 0.0);
+    EXPECT_NEAR(y[2], 4.0);
+
+    spmv<double>(a, x, y, EdgeValues::Ones);
+    EXPECT_NEAR(y[0], 110.0);
+    EXPECT_NEAR(y[2], 1.0);
+}
+
+static void test_unweighted_adjacency_uses_ones()
+{
+    CsrAdjacency a = small_matrix();
+    a.weights.clear();
+    const std::vector<float> x{1.0f, 2.0f, 4.0f};
+    std::vector<float> y(3);
+    spmv<float>(a, x, y);
+    EXPECT_NEAR(y[0], 6.0f);
+    EXPECT_NEAR(y[2], 1.0f);
+}
+
+static void test_many_rows()
+{
+    // Ring: row i has a single entry in column (i + 1) % n.
+    constexpr usize n = 50'000;
+    CsrAdjacency a;
+    for (usize i = 0; i < n; ++i)
+    {
+        a.edges.push_back(static_cast<VertexId>((i + 1) % n));
+        a.offsets.push_back(a.edges.size());
+    }
+    std::vector<double> x(n);
+    for (usize i = 0; i < n; ++i) x[i] = static_cast<double>(i);
+    std::vector<double> y(n);
+    spmv<double>(a, x, y);
+    for (usize i = 0; i < n; ++i) EXPECT_NEAR(y[i], static_cast<double>((i + 1) % n));
+}
+
+// Rows long enough for the SIMD path, with its scalar tail, against a plain
+// loop over the same entries.
+template <typename T>
+static void test_long_rows_match_scalar()
+{
+    CsrAdjacency a = random_adjacency(300, 20'000, 13);
+    for (usize e = 0; e < a.edges.size(); ++e) a.weights.push_back(static_cast<EdgeWeight>(e % 7 + 1));
+    std::vector<T> x(a.vertex_count());
+    for (usize i = 0; i < x.size(); ++i) x[i] = static_cast<T>(i % 11) * T(0.5) - T(2);
+
+    for (EdgeValues values : {EdgeValues::Weights, EdgeValues::Ones})
+    {
+        std::vector<T> y(a.vertex_count());
+        spmv<T>(a, x, y, values);
+        for (VertexId v = 0; v < a.vertex_count(); ++v)
+        {
+            T expected{0};
+            for (u64 e = a.offsets[v]; e < a.offsets[v + 1]; ++e)
+            {
+                const T w = values == EdgeValues::Weights ? static_cast<T>(a.weights[e]) : T{1};
+                expected += w * x[a.edges[e]];
+            }
+            EXPECT_TRUE(nearly_equal(y[v], expected, static_cast<T>(1e-5), static_cast<T>(1e-4)));
+        }
+    }
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_weighted_and_pattern_products();
+    test_unweighted_adjacency_uses_ones();
+    test_many_rows();
+    test_long_rows_match_scalar<float>();
+    test_long_rows_match_scalar<double>();
+    return 0;
+}
@@ -0,0 +1,158 @@
+// tests/test_sssp.cpp
+#include "common.hpp"
+#include "graph_fixtures.hpp"
+#include "graph.hpp"
+#include "sssp.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static std::vector<PathLength> bellman_ford(const CsrAdjacency& g, VertexId source)
+{
+    std::vector<PathLength> dist(g.vertex_count(), SsspResult::unreachable);
+    dist[source] = 0;
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (VertexId u = 0; u < g.vertex_count(); ++u)
+        {
+            if (dist[u] == SsspResult::unreachable) continue;
+            for (u64 e = g.offsets[u]; e < g.offsets[u + 1]; ++e)
+            {
+                const PathLength nd = dist[u] + g.weight(e);
+                if (nd < dist[g.edges[e]])
+                {
+                    dist[g.edges[e]] = nd;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return dist;
+}
+
+static void expect_valid_tree(const CsrAdjacency& g, const SsspResult& r, VertexId source)
+{
+    EXPECT_TRUE(r.distance == bellman_ford(g, source));
+    EXPECT_EQ(r.parent[source], source);
+    for (VertexId v = 0; v < g.vertex_count(); ++v)
+    {
+        if (v == source) continue;
+        if (!r.reached(v))
+        {
+            EXPECT_EQ(r.parent[v], invalid_vertex);
+            continue;
+        }
+        const VertexId p = r.parent[v];
+        const auto ns = g.neighbors(p);
+        const auto it = std::ranges::lower_bound(ns, v);
+        EXPECT_TRUE(it != ns.end() && *it == v);
+        EXPECT_EQ(r.distance[p] + g.weight(g.offsets[p] + static_cast<u64>(it - ns.begin())), r.distance[v]);
+
+        // Zero-weight edges must not let the parents form a cycle.
+        VertexId u = v;
+        usize steps = 0;
+        while (u != source && steps++ < g.vertex_count()) u = r.parent[u];
+        EXPECT_EQ(u, source);
+    }
+}
+
+static void test_radix_heap_pops_in_order()
+{
+    RadixHeap<int> heap;
+    for (u64 k : {50u, 3u, 1000u, 3u, 77u}) heap.push(k, static_cast<int>(k));
+    EXPECT_EQ(heap.pop().first, 3u);
+    heap.push(10, 10); // not below the last popped key
+    std::vector<u64> order;
+    while (!heap.empty()) order.push_back(heap.pop().first);
+    EXPECT_TRUE((order == std::vector<u64>{3, 10, 50, 77, 1000}));
+}
+
+static void test_dijkstra_and_delta_stepping_agree()
+{
+    const auto g = random_weighted(3000, 15000, 1, 100, 3);
+    expect_valid_tree(g, dijkstra(g, 0), 0);
+    for (PathLength delta : {1u, 25u, 400u, 1'000'000u})
+    {
+        expect_valid_tree(g, delta_stepping(g, 0, delta), 0);
+    }
+    expect_valid_tree(g, delta_stepping(g, 1234, 50), 1234);
+}
+
+static void test_zero_weight_edges()
+{
+    // 0 -1-> 3 -0-> 1 <-0-> 2: 1 and 2 are tight for each other.
+    CsrAdjacency adj;
+    adj.edges = {3, 2, 1, 1};
+    adj.weights = {1, 0, 0, 0};
+    adj.offsets = {0, 1, 2, 3, 4};
+    for (PathLength delta : {1u, 100u})
+    {
+        const auto r = delta_stepping(adj, 0, delta);
+        expect_valid_tree(adj, r, 0);
+        EXPECT_EQ(r.parent[1], 3u);
+        EXPECT_EQ(r.parent[2], 1u);
+    }
+    expect_valid_tree(adj, dijkstra(adj, 0), 0);
+
+    const auto g = random_weighted(3000, 15000, 0, 3, 5);
+    expect_valid_tree(g, dijkstra(g, 0), 0);
+    for (PathLength delta : {1u, 4u, 1'000'000u})
+    {
+        expect_valid_tree(g, delta_stepping(g, 0, delta), 0);
+    }
+}
+
+static void test_unweighted_adjacency_counts_hops()
+{
+    CsrAdjacency adj;
+    adj.edges = {1, 2, 3};
+    adj.offsets = {0, 2, 3, 3, 3}; // 0 -> {1, 2}, 1 -> 3
+    const auto r = dijkstra(adj, 0);
+    EXPECT_EQ(r.distance[3], 2u);
+    EXPECT_EQ(delta_stepping(adj, 0, 1).distance[3], 2u);
+    EXPECT_TRUE(!dijkstra(adj, 3).reached(0));
+}
+
+static void test_graph_overload_uses_weights()
+{
+    using WE = Graph<int>::WeightedEdge;
+    Graph<int> g;
+    for (GraphIndex idx : {GraphIndex{10}, GraphIndex{20}, GraphIndex{30}}) (void)g.create_node(0, idx);
+    const std::vector<WE> edges{{10, 30, 9}, {10, 20, 2}, {20, 30, 3}};
+    EXPECT_EQ(g.add_edges(edges).added, 3zu);
+
+    const auto r = dijkstra(g, 10);
+    EXPECT_TRUE(r.has_value());
+    EXPECT_EQ(r->distance(30).value(), 5u);
+    EXPECT_EQ(r->parent(30).value(), 20u);
+
+    const auto missing = dijkstra(g, 11);
+    EXPECT_TRUE(!missing.has_value() && missing.error() == SsspError::SourceMissing);
+
+    const auto stepped = delta_stepping(g, 10, 2);
+    EXPECT_TRUE(stepped.has_value());
+    EXPECT_EQ(stepped->distance(30).value(), 5u);
+    EXPECT_EQ(stepped->parent(30).value(), 20u);
+    EXPECT_TRUE(!stepped->distance(11).has_value());
+    const auto stepped_missing = delta_stepping(g, 11, 2);
+    EXPECT_TRUE(!stepped_missing.has_value() && stepped_missing.error() == SsspError::SourceMissing);
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_radix_heap_pops_in_order();
+    test_dijkstra_and_delta_stepping_agree();
+    test_zero_weight_edges();
+    test_unweighted_adjacency_counts_hops();
+    test_graph_overload_uses_weights();
+    return 0;
+}
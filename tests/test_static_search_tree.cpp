@@ -0,0 +1,96 @@
+// tests/test_static_search_tree.cpp
+#include "common.hpp"
+#include "static_search_tree.hpp"
+
+#include <algorithm>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static void test_branchless_lower_bound_matches_std()
+{
+    const std::vector<u64> empty;
+    EXPECT_TRUE(branchless_lower_bound(std::span<const u64>{empty}, u64{3}) == empty.data());
+
+    std::vector<u64> xs{1, 3, 3, 3, 7, 9, 20};
+    const std::span<const u64> s{xs};
+    for (u64 x = 0; x < 25; ++x)
+    {
+        const auto* got = branchless_lower_bound(s, x);
+        const auto want = std::lower_bound(xs.begin(), xs.end(), x);
+        EXPECT_EQ(got - xs.data(), want - xs.begin());
+    }
+}
+
+static void test_empty_tree()
+{
+    StaticSearchTree<u32> t;
+    EXPECT_TRUE(t.empty());
+    EXPECT_EQ(t.lower_bound(5), 0zu);
+    EXPECT_TRUE(!t.contains(5));
+    EXPECT_EQ(t.find(5), StaticSearchTree<u32>::npos);
+
+    const std::vector<u32> none;
+    StaticSearchTree<u32> t2{none};
+    EXPECT_EQ(t2.size(), 0zu);
+    EXPECT_EQ(t2.lower_bound(1), 0zu);
+}
+
+static void test_lower_bound_all_sizes()
+{
+    // Every size up to a few complete levels, so partial last levels are covered.
+    for (usize n = 1; n <= 70; ++n)
+    {
+        std::vector<u32> xs(n);
+        for (usize i = 0; i < n; ++i) xs[i] = static_cast<u32>(2 * i + 1); // odd keys
+
+        const StaticSearchTree<u32> t{xs};
+        EXPECT_EQ(t.size(), n);
+        for (u32 x = 0; x <= 2 * n + 1; ++x)
+        {
+            const auto want = static_cast<usize>(std::lower_bound(xs.begin(), xs.end(), x) - xs.begin());
+            EXPECT_EQ(t.lower_bound(x), want);
+            EXPECT_EQ(t.contains(x), (x & 1u) == 1u && x < 2 * n + 1);
+        }
+    }
+}
+
+static void test_duplicates_and_random()
+{
+    std::mt19937_64 rng(3);
+    std::vector<i64> xs(5000);
+    for (auto& x : xs) x = static_cast<i64>(rng() % 1000) - 500;
+    std::ranges::sort(xs);
+
+    const StaticSearchTree<i64> t{xs};
+    for (i64 x = -510; x <= 510; ++x)
+    {
+        const auto want = static_cast<usize>(std::ranges::lower_bound(xs, x) - xs.begin());
+        EXPECT_EQ(t.lower_bound(x), want);
+        const bool present = std::ranges::binary_search(xs, x);
+        EXPECT_EQ(t.find(x) == StaticSearchTree<i64>::npos, !present);
+        if (present) EXPECT_EQ(t.find(x), want);
+    }
+}
+
+static void test_unsorted_input_throws()
+{
+    const std::vector<u32> xs{3, 1, 2};
+    EXPECT_THROW(StaticSearchTree<u32>{xs});
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_branchless_lower_bound_matches_std();
+    test_empty_tree();
+    test_lower_bound_all_sizes();
+    test_duplicates_and_random();
+    test_unsorted_input_throws();
+    return 0;
+}
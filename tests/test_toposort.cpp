@@ -0,0 +1,99 @@
+// tests/test_toposort.cpp
+#include "common.hpp"
+#include "graph_fixtures.hpp"
+#include "graph.hpp"
+#include "toposort.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static void test_levels_of_small_dag()
+{
+    // 0 -> 2, 1 -> 2, 2 -> 3, 0 -> 3, 4 isolated.
+    const TopologicalOrder t = topological_sort(CsrAdjacency::from_lists({{2, 3}, {2}, {3}, {}, {}}));
+    EXPECT_TRUE(t.acyclic());
+    EXPECT_EQ(t.level_count(), 3zu);
+    EXPECT_TRUE(std::ranges::equal(t.level(0), std::vector<VertexId>{0, 1, 4}));
+    EXPECT_TRUE(std::ranges::equal(t.level(1), std::vector<VertexId>{2}));
+    EXPECT_TRUE(std::ranges::equal(t.level(2), std::vector<VertexId>{3}));
+}
+
+static void test_random_dag_order_is_valid()
+{
+    constexpr usize n = 50'000;
+    const CsrAdjacency g = random_dag(n, 4 * n, 3);
+
+    const TopologicalOrder t = topological_sort(g);
+    EXPECT_TRUE(t.acyclic());
+    EXPECT_EQ(t.order.size(), n);
+    std::vector<usize> level_of(n);
+    for (usize k = 0; k < t.level_count(); ++k)
+    {
+        for (VertexId v : t.level(k)) level_of[v] = k;
+    }
+    for (VertexId u = 0; u < n; ++u)
+    {
+        for (VertexId v : g.neighbors(u)) EXPECT_TRUE(level_of[u] < level_of[v]);
+    }
+    // Every vertex past level 0 has a predecessor exactly one level up.
+    const CsrAdjacency in = g.transposed();
+    for (VertexId v = 0; v < n; ++v)
+    {
+        if (level_of[v] == 0) continue;
+        EXPECT_TRUE(std::ranges::any_of(in.neighbors(v), [&](VertexId u) { return level_of[u] + 1 == level_of[v]; }));
+    }
+}
+
+static void test_cycle_is_reported()
+{
+    // 0 -> 1 -> 2 -> 3 -> 1 and 3 -> 4; only 0 can be ordered.
+    const CsrAdjacency g = CsrAdjacency::from_lists({{1}, {2}, {3}, {1, 4}, {}});
+    const TopologicalOrder t = topological_sort(g);
+    EXPECT_TRUE(!t.acyclic());
+    EXPECT_TRUE(t.order == std::vector<VertexId>{0});
+
+    auto cycle = t.cycle;
+    EXPECT_EQ(cycle.size(), 3zu);
+    for (usize i = 0; i < cycle.size(); ++i)
+    {
+        const VertexId u = cycle[i];
+        const VertexId v = cycle[(i + 1) % cycle.size()];
+        EXPECT_TRUE(std::ranges::binary_search(g.neighbors(u), v));
+    }
+    std::ranges::sort(cycle);
+    EXPECT_TRUE(cycle == (std::vector<VertexId>{1, 2, 3}));
+}
+
+static void test_graph_overload()
+{
+    Graph<int> g;
+    for (GraphIndex idx : {GraphIndex{10}, GraphIndex{20}, GraphIndex{30}}) (void)g.create_node(0, idx);
+    (void)g.add_edge(30, 10);
+    (void)g.add_edge(10, 20);
+
+    const auto t = topological_sort(g);
+    EXPECT_TRUE(t.has_value() && t->result.acyclic());
+    EXPECT_TRUE(t->order() == (std::vector<GraphIndex>{30, 10, 20}));
+
+    (void)g.add_edge(20, 30);
+    const auto c = topological_sort(g);
+    EXPECT_TRUE(c.has_value() && !c->result.acyclic());
+    EXPECT_EQ(c->cycle().size(), 3zu);
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_levels_of_small_dag();
+    test_random_dag_order_is_valid();
+    test_cycle_is_reported();
+    test_graph_overload();
+    return 0;
+}
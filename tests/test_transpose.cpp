@@ -0,0 +1,80 @@
+// tests/test_transpose.cpp
+#include "common.hpp"
+#include "transpose.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace dsalgo::Test
+{
+static f64 value_at(usize i, usize j)
+{
+    return static_cast<f64>(i) * 1000.0 + static_cast<f64>(j);
+}
+
+static void test_out_of_place()
+{
+    // Shapes below, at and across the tile size, and large enough (both tall
+    // and wide) to go through the parallel bands.
+    const std::pair<usize, usize> shapes[] = {{0, 5}, {1, 1}, {1, 70}, {31, 33}, {64, 64}, {97, 45}, {1500, 130}, {70, 2049}};
+    for (const auto& [rows, cols] : shapes)
+    {
+        // Padded strides on both sides; the padding must be left alone.
+        const usize lds = cols + 3;
+        const usize ldd = rows + 5;
+        std::vector<f64> src(rows * lds, -1.0);
+        for (usize i = 0; i < rows; ++i)
+        {
+            for (usize j = 0; j < cols; ++j) src[i * lds + j] = value_at(i, j);
+        }
+        std::vector<f64> dst(cols * ldd, -2.0);
+        transpose(src.data(), rows, cols, lds, dst.data(), ldd);
+        bool ok = true;
+        for (usize j = 0; j < cols; ++j)
+        {
+            for (usize i = 0; i < ldd; ++i)
+            {
+                const f64 expected = i < rows ? value_at(i, j) : -2.0;
+                ok = ok && nearly_equal(dst[j * ldd + i], expected, 0.0, 0.0);
+            }
+        }
+        EXPECT_TRUE(ok);
+    }
+}
+
+static void test_in_place()
+{
+    for (usize n : {usize{0}, usize{1}, usize{5}, usize{32}, usize{33}, usize{300}})
+    {
+        const usize ld = n + 2;
+        std::vector<f32> a(n * ld, -1.0f);
+        for (usize i = 0; i < n; ++i)
+        {
+            for (usize j = 0; j < n; ++j) a[i * ld + j] = static_cast<f32>(value_at(i, j));
+        }
+        transpose_in_place(a.data(), n, ld);
+        bool ok = true;
+        for (usize i = 0; i < n; ++i)
+        {
+            for (usize j = 0; j < ld; ++j)
+            {
+                const f32 expected = j < n ? static_cast<f32>(value_at(j, i)) : -1.0f;
+                ok = ok && nearly_equal(a[i * ld + j], expected, 0.0f, 0.0f);
+            }
+        }
+        EXPECT_TRUE(ok);
+
+        // Twice is the identity.
+        transpose_in_place(a.data(), n, ld);
+        if (n > 1) EXPECT_NEAR(a[ld], static_cast<f32>(value_at(1, 0)));
+    }
+}
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_out_of_place();
+    test_in_place();
+    return 0;
+}
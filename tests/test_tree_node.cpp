@@ -1,11 +1,16 @@
 // tests/test_tree_node.cpp
 #include "common.hpp"
+#include "small_stack.hpp"
 #include "tree_node.hpp"
 
+#include <cstdio>
 #include <format>
 #include <string>
 #include <type_traits>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 namespace dsalgo::Test
 {
 
@@ -86,6 +91,105 @@ static void test_formatter_smoke()
     EXPECT_TRUE(s.find("0: 42") != std::string::npos); // nested child index at that level
 }
 
+static void test_formatter_exact_layout()
+{
+    TreeNode<int> root{0};
+    root.create_new_child(1);
+    root.create_new_child(2);
+    root.child_ptr(0)->create_new_child(10);
+    root.child_ptr(0)->child_ptr(0)->create_new_child(100);
+
+    const std::string expected =
+        "root: 0\n"
+        "├── 0: 1\n"
+        "│   └── 0: 10\n"
+        "│       └── 0: 100\n"
+        "└── 1: 2\n";
+    EXPECT_EQ(std::format("{}", root), expected);
+}
+
+static void test_write_tree_streams_same_output()
+{
+    TreeNode<int> root{0};
+    for (int i = 1; i <= 50; ++i) root.create_new_child(i);
+    root.child_ptr(7)->create_new_child(700);
+
+    std::FILE* f = std::tmpfile();
+    EXPECT_TRUE(f != nullptr);
+    // Tiny buffer so the sink is flushed many times mid-walk.
+    EXPECT_TRUE(write_tree(f, root, 16).has_value());
+
+    std::string streamed(static_cast<usize>(std::ftell(f)), '\0');
+    std::rewind(f);
+    EXPECT_EQ(std::fread(streamed.data(), 1, streamed.size(), f), streamed.size());
+    std::fclose(f);
+
+    EXPECT_EQ(streamed, std::format("{}", root));
+}
+
+static std::string read_back(std::FILE* f)
+{
+    std::string s(static_cast<usize>(std::ftell(f)), '\0');
+    std::rewind(f);
+    EXPECT_EQ(std::fread(s.data(), 1, s.size(), f), s.size());
+    return s;
+}
+
+static void test_write_tree_to_fd()
+{
+    TreeNode<int> root{0};
+    for (int i = 1; i <= 50; ++i) root.create_new_child(i);
+    root.child_ptr(3)->create_new_child(300);
+
+    std::FILE* f = std::tmpfile();
+    EXPECT_TRUE(f != nullptr);
+    EXPECT_TRUE(write_tree(fileno(f), root, 16).has_value());
+    // The fd path bypasses the FILE buffer, so sync the position first.
+    std::fseek(f, 0, SEEK_END);
+    EXPECT_EQ(read_back(f), std::format("{}", root));
+    std::fclose(f);
+
+    const int read_only = ::open("/dev/null", O_RDONLY);
+    EXPECT_TRUE(read_only >= 0);
+    const auto failed = write_tree(read_only, root);
+    EXPECT_TRUE(!failed.has_value() && failed.error() == TreeWriteError::WriteFailed);
+    ::close(read_only);
+}
+
+static TreeNode<u32> make_chain(u32 depth)
+{
+    TreeNode<u32> root{0};
+    TreeNode<u32>* node = &root;
+    for (u32 i = 1; i <= depth; ++i)
+    {
+        node->create_new_child(i);
+        node = node->child_ptr(0);
+    }
+    return root;
+}
+
+static void test_deep_chain_on_small_stack()
+{
+    // A recursive dump or destructor needs well over 128 KiB for these depths.
+    // The dump stays shallower because its output is quadratic in depth.
+    run_on_small_stack(128 * 1024, [] {
+        {
+            const auto root = make_chain(1'000'000);
+            EXPECT_EQ(root.child_ptr(0)->value(), 1u);
+        }
+
+        const auto root = make_chain(4'000);
+        std::FILE* f = std::tmpfile();
+        EXPECT_TRUE(f != nullptr);
+        EXPECT_TRUE(write_tree(fileno(f), root).has_value());
+        std::fseek(f, 0, SEEK_END);
+        const std::string dumped = read_back(f);
+        std::fclose(f);
+        EXPECT_EQ(dumped, std::format("{}", root));
+        EXPECT_TRUE(dumped.ends_with("└── 0: 4000\n"));
+    });
+}
+
 static void test_type_traits_move_only_node()
 {
     static_assert(std::is_move_constructible_v<TreeNode<int>>);
@@ -102,6 +206,10 @@ int main()
     test_const_accessors();
     test_move_only_type_supported();
     test_formatter_smoke();
+    test_formatter_exact_layout();
+    test_write_tree_streams_same_output();
+    test_write_tree_to_fd();
+    test_deep_chain_on_small_stack();
     test_type_traits_move_only_node();
     return 0;
 }
\ No newline at end of file
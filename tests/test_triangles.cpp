@@ -0,0 +1,134 @@
+// tests/test_triangles.cpp
+#include "common.hpp"
+#include "graph_fixtures.hpp"
+#include "triangles.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static void test_intersect_matches_merge()
+{
+    u64 state = 7;
+    for (usize round = 0; round < 500; ++round)
+    {
+        const auto a = random_set(state, round % 37, 64);
+        const auto b = random_set(state, (round * 7) % 53, 64);
+        std::vector<VertexId> expected;
+        std::ranges::set_intersection(a, b, std::back_inserter(expected));
+
+        std::vector<VertexId> got;
+        const usize count = intersect(a, b, [&](VertexId x) { got.push_back(x); });
+        std::ranges::sort(got);
+        EXPECT_EQ(count, expected.size());
+        EXPECT_TRUE(got == expected);
+        EXPECT_EQ(intersection_size(b, a), expected.size());
+    }
+}
+
+static void test_symmetrized()
+{
+    // 0 -> 1, 1 -> 0, 1 -> 2, 2 -> 2 (self-loop), 3 isolated.
+    const CsrAdjacency s = CsrAdjacency::from_lists({{1}, {0, 2}, {2}, {}}).symmetrized();
+    EXPECT_EQ(s.vertex_count(), 4zu);
+    EXPECT_TRUE(std::ranges::equal(s.neighbors(0), std::vector<VertexId>{1}));
+    EXPECT_TRUE(std::ranges::equal(s.neighbors(1), std::vector<VertexId>{0, 2}));
+    EXPECT_TRUE(std::ranges::equal(s.neighbors(2), std::vector<VertexId>{1}));
+    EXPECT_EQ(s.degree(3), 0zu);
+}
+
+static void test_complete_graph()
+{
+    // K5 as a directed half: every pair appears once.
+    constexpr usize n = 5;
+    std::vector<std::vector<VertexId>> lists(n);
+    for (usize u = 0; u < n; ++u)
+    {
+        for (usize v = u + 1; v < n; ++v) lists[u].push_back(static_cast<VertexId>(v));
+    }
+    const CsrAdjacency sym = CsrAdjacency::from_lists(lists).symmetrized();
+    EXPECT_EQ(count_triangles(sym), 10u);
+
+    const Clustering c = clustering(sym);
+    EXPECT_EQ(c.total_triangles, 10u);
+    for (usize v = 0; v < n; ++v)
+    {
+        EXPECT_EQ(c.triangles[v], 6u);
+        EXPECT_NEAR(c.local[v], 1.0);
+    }
+    EXPECT_NEAR(c.global, 1.0);
+    EXPECT_NEAR(c.average_local, 1.0);
+}
+
+static void test_star_and_triangle()
+{
+    // Triangle 0-1-2 with a pendant 3 on vertex 0.
+    const CsrAdjacency sym = CsrAdjacency::from_lists({{1, 2, 3}, {2}, {}, {}}).symmetrized();
+    const Clustering c = clustering(sym);
+    EXPECT_EQ(c.total_triangles, 1u);
+    EXPECT_NEAR(c.local[0], 1.0 / 3.0);
+    EXPECT_NEAR(c.local[1], 1.0);
+    EXPECT_NEAR(c.local[3], 0.0);
+    // Wedges: 3 at vertex 0, 1 each at 1 and 2.
+    EXPECT_NEAR(c.global, 3.0 / 5.0);
+    EXPECT_NEAR(c.average_local, (1.0 / 3.0 + 2.0) / 4.0);
+}
+
+static void test_random_graph_matches_brute_force()
+{
+    const CsrAdjacency sym = random_symmetric(300, 3000, 11);
+    const usize n = sym.vertex_count();
+    std::vector<std::vector<bool>> adj(n, std::vector<bool>(n, false));
+    for (VertexId u = 0; u < n; ++u)
+    {
+        for (VertexId v : sym.neighbors(u)) adj[u][v] = true;
+    }
+
+    u64 total = 0;
+    std::vector<u64> per_vertex(n, 0);
+    for (usize u = 0; u < n; ++u)
+    {
+        for (usize v = u + 1; v < n; ++v)
+        {
+            if (!adj[u][v]) continue;
+            for (usize w = v + 1; w < n; ++w)
+            {
+                if (!adj[u][w] || !adj[v][w]) continue;
+                ++total;
+                ++per_vertex[u];
+                ++per_vertex[v];
+                ++per_vertex[w];
+            }
+        }
+    }
+
+    EXPECT_EQ(count_triangles(sym), total);
+    const Clustering c = clustering(sym);
+    EXPECT_EQ(c.total_triangles, total);
+    EXPECT_TRUE(c.triangles == per_vertex);
+}
+
+static void test_csr_graph_overload()
+{
+    // Directed 3-cycle with external ids: one undirected triangle.
+    const CsrGraph<int> g({5, 6, 7}, {0, 0, 0}, CsrAdjacency::from_lists({{1}, {2}, {0}}));
+    EXPECT_EQ(count_triangles(g), 1u);
+    EXPECT_NEAR(clustering(g).global, 1.0);
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_intersect_matches_merge();
+    test_symmetrized();
+    test_complete_graph();
+    test_star_and_triangle();
+    test_random_graph_matches_brute_force();
+    test_csr_graph_overload();
+    return 0;
+}
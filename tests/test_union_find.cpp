@@ -0,0 +1,69 @@
+// tests/test_union_find.cpp
+#include "common.hpp"
+#include "parallel.hpp"
+#include "union_find.hpp"
+
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static void test_serial_unions()
+{
+    ConcurrentUnionFind uf{10};
+    EXPECT_EQ(uf.size(), 10zu);
+    EXPECT_TRUE(uf.unite(3, 7));
+    EXPECT_TRUE(uf.unite(7, 9));
+    EXPECT_TRUE(!uf.unite(9, 3));
+    EXPECT_TRUE(uf.unite(1, 9));
+    EXPECT_TRUE(uf.same(1, 3));
+    EXPECT_TRUE(!uf.same(1, 2));
+
+    // The representative is the smallest member.
+    EXPECT_EQ(uf.find(9), 1u);
+    const auto labels = uf.labels();
+    EXPECT_TRUE((labels == std::vector<VertexId>{0, 1, 2, 1, 4, 5, 6, 1, 8, 1}));
+}
+
+static void test_concurrent_chain_merges_everything()
+{
+    constexpr usize n = 100'000;
+    ConcurrentUnionFind uf{n};
+    ThreadPool pool{4};
+    // Every pair (i, i + 1) united from many threads in scrambled order.
+    pool.run(64, [&](usize task, usize) {
+        for (usize i = task; i + 1 < n; i += 64) uf.unite(static_cast<VertexId>(i + 1), static_cast<VertexId>(i));
+    });
+    for (VertexId v : uf.labels()) EXPECT_EQ(v, 0u);
+}
+
+static void test_concurrent_unions_count_once()
+{
+    constexpr usize n = 4096;
+    ConcurrentUnionFind uf{n};
+    ThreadPool pool{4};
+    std::vector<usize> merged(64, 0);
+    // Every thread tries the same unions; each must succeed exactly once overall.
+    pool.run(64, [&](usize task, usize) {
+        for (usize i = 0; i + 2 < n; i += 2)
+        {
+            merged[task] += uf.unite(static_cast<VertexId>(i), static_cast<VertexId>(i + 2));
+        }
+    });
+    usize total = 0;
+    for (usize m : merged) total += m;
+    EXPECT_EQ(total, n / 2 - 1);
+    EXPECT_TRUE(uf.same(0, n - 2));
+    EXPECT_TRUE(!uf.same(0, 1));
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_serial_unions();
+    test_concurrent_chain_merges_everything();
+    test_concurrent_unions_count_once();
+    return 0;
+}
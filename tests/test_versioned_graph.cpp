@@ -0,0 +1,229 @@
+// tests/test_versioned_graph.cpp
+#include "common.hpp"
+#include "graph.hpp"
+#include "util.hpp"
+#include "versioned_graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace dsalgo::Test
+{
+
+static GraphBatch<int> random_batch(u64& state, GraphIndex id_range, usize ops)
+{
+    const auto next = [&] {
+        state = hash_int(state);
+        return state;
+    };
+    GraphBatch<int> b;
+    for (usize i = 0; i < ops; ++i)
+    {
+        const u64 r = next();
+        const GraphIndex a = r % id_range;
+        const GraphIndex c = (r >> 32) % id_range;
+        switch (next() % 8)
+        {
+            case 0: b.remove_nodes.push_back(a); break;
+            case 1: b.add_nodes.emplace_back(a, static_cast<int>(c)); break;
+            case 2:
+            case 3: b.remove_edges.emplace_back(a, c); break;
+            default: b.add_edges.push_back({a, c, static_cast<EdgeWeight>(r % 100)}); break;
+        }
+    }
+    return b;
+}
+
+static bool same_graph(const CsrGraph<int>& a, const CsrGraph<int>& b)
+{
+    return std::ranges::equal(a.external_ids(), b.external_ids()) && std::ranges::equal(a.values(), b.values()) &&
+           std::ranges::equal(a.adjacency().offsets, b.adjacency().offsets) &&
+           std::ranges::equal(a.adjacency().edges, b.adjacency().edges) &&
+           std::ranges::equal(a.adjacency().weights, b.adjacency().weights);
+}
+
+// A large first batch over few ids builds hubs that span several neighbor
+// blocks; the later ones split, edit and empty them.
+static void test_matches_graph_apply(GraphIndex id_range, usize first_ops, usize ops)
+{
+    Graph<int> reference;
+    VersionedGraph<int> versioned{16};
+    u64 state = 5;
+    for (usize round = 0; round < 30; ++round)
+    {
+        const GraphBatch<int> batch = random_batch(state, id_range, round == 0 ? first_ops : ops);
+        const auto expected = reference.apply(batch);
+        const auto got = versioned.apply(batch);
+        EXPECT_EQ(got.nodes_added, expected.nodes_added);
+        EXPECT_EQ(got.nodes_rejected, expected.nodes_rejected);
+        EXPECT_EQ(got.nodes_removed, expected.nodes_removed);
+        EXPECT_EQ(got.nodes_missing, expected.nodes_missing);
+        EXPECT_EQ(got.removed_edges.removed, expected.removed_edges.removed);
+        EXPECT_EQ(got.removed_edges.rejected(), expected.removed_edges.rejected());
+        EXPECT_EQ(got.added_edges.added, expected.added_edges.added);
+        EXPECT_EQ(got.added_edges.edge_exists, expected.added_edges.edge_exists);
+        EXPECT_EQ(got.added_edges.node_to_missing, expected.added_edges.node_to_missing);
+
+        const auto snap = versioned.snapshot();
+        EXPECT_EQ(snap->version(), round + 1);
+        EXPECT_EQ(snap->node_count(), reference.node_count());
+        EXPECT_TRUE(same_graph(*snap->freeze(), *reference.freeze()));
+    }
+}
+
+static void test_snapshots_are_stable_and_shared()
+{
+    VersionedGraph<int> g{8};
+    GraphBatch<int> build;
+    for (GraphIndex i = 0; i < 100; ++i) build.add_nodes.emplace_back(i, static_cast<int>(i));
+    for (GraphIndex i = 0; i + 1 < 100; ++i) build.add_edges.push_back({i, i + 1});
+    (void)g.apply(build);
+
+    const auto before = g.snapshot();
+    GraphBatch<int> change;
+    change.remove_nodes = {50};
+    change.add_edges = {{0, 99}};
+    (void)g.apply(change);
+    const auto after = g.snapshot();
+
+    // The old version still sees node 50 and its edges.
+    EXPECT_EQ(before->version(), 1u);
+    EXPECT_EQ(before->node_count(), 100zu);
+    EXPECT_TRUE(before->contains_edge(49, 50) && before->contains_edge(50, 51));
+    EXPECT_TRUE(!before->contains_edge(0, 99));
+
+    EXPECT_EQ(after->version(), 2u);
+    EXPECT_EQ(after->node_count(), 99zu);
+    EXPECT_TRUE(after->node(50) == nullptr);
+    EXPECT_TRUE(!after->contains_edge(49, 50));
+    EXPECT_TRUE(after->contains_edge(0, 99));
+
+    // Untouched nodes are the very same objects in both versions.
+    EXPECT_TRUE(before->node(10) == after->node(10));
+    EXPECT_TRUE(before->node(49) != after->node(49));
+    EXPECT_TRUE(before->node(0) != after->node(0));
+
+    // So are the shards the batch did not reach (nodes shard on hash_int).
+    usize touched = 0;
+    for (usize s = 0; s < after->shard_count(); ++s)
+    {
+        const auto shard_of = [](GraphIndex i) { return hash_int(i) % 8; };
+        const bool hit = s == shard_of(50) || s == shard_of(49) || s == shard_of(0);
+        touched += hit ? 1u : 0u;
+        EXPECT_TRUE(hit ? before->shard_root(s) != after->shard_root(s) : before->shard_root(s) == after->shard_root(s));
+    }
+    EXPECT_TRUE(touched < 8zu);
+}
+
+template <typename Node>
+static void collect_index(const Node* n, std::unordered_set<const void*>& seen)
+{
+    seen.insert(n);
+    for (const auto& e : n->entries)
+    {
+        if (e.child) collect_index(e.child.get(), seen);
+        else seen.insert(e.value.get());
+    }
+}
+
+// One edit to a large single-shard graph copies one index path, one node and
+// the neighbor blocks it touches, not the shard or the hub's whole list.
+static void test_batch_copies_only_touched_data()
+{
+    constexpr GraphIndex n = 20000;
+    VersionedGraph<int> g{1};
+    GraphBatch<int> build;
+    for (GraphIndex i = 0; i < n; ++i) build.add_nodes.emplace_back(i, 0);
+    for (GraphIndex i = 1; i < n; ++i) build.add_edges.push_back({0, i, static_cast<EdgeWeight>(i)});
+    (void)g.apply(build);
+    const auto before = g.snapshot();
+
+    GraphBatch<int> change;
+    change.remove_edges = {{0, 5000}};
+    change.add_edges = {{0, 5000, 1}, {7, 8}};
+    (void)g.apply(change);
+    const auto after = g.snapshot();
+    EXPECT_EQ(after->node(0)->weight_to(5000), std::optional<EdgeWeight>{1});
+    EXPECT_EQ(after->node(0)->weight_to(4999), std::optional<EdgeWeight>{4999});
+    EXPECT_TRUE(after->contains_edge(7, 8) && !before->contains_edge(7, 8));
+
+    std::unordered_set<const void*> old_objects;
+    collect_index(before->shard_root(0), old_objects);
+    std::unordered_set<const void*> new_objects;
+    collect_index(after->shard_root(0), new_objects);
+    usize fresh = 0;
+    for (const void* p : new_objects) fresh += old_objects.contains(p) ? 0u : 1u;
+    // Two root-to-leaf paths of at most four levels, plus nodes 0 and 7; the
+    // shard holds over 25,000 objects.
+    EXPECT_TRUE(fresh <= 10zu);
+
+    const auto* hub_before = before->node(0);
+    const auto* hub_after = after->node(0);
+    EXPECT_EQ(hub_after->degree(), static_cast<usize>(n - 1));
+    EXPECT_TRUE(hub_before->block_count() > 100zu);
+    EXPECT_EQ(hub_after->block_count(), hub_before->block_count());
+    usize copied = 0;
+    for (usize b = 0; b < hub_after->block_count(); ++b) copied += &hub_before->block(b) == &hub_after->block(b) ? 0u : 1u;
+    EXPECT_EQ(copied, 1zu);
+}
+
+static void test_readers_during_writes()
+{
+    VersionedGraph<int> g;
+    GraphBatch<int> ring;
+    constexpr GraphIndex n = 64;
+    for (GraphIndex i = 0; i < n; ++i) ring.add_nodes.emplace_back(i, 0);
+    (void)g.apply(ring);
+
+    // Each batch moves every edge i -> i+k to i -> i+k+1, so any consistent
+    // snapshot has exactly n edges, all with the same stride.
+    std::atomic<bool> done{false};
+    std::atomic<usize> bad{0};
+    std::jthread reader([&] {
+        while (!done.load())
+        {
+            const auto snap = g.snapshot();
+            usize edges = 0;
+            std::vector<GraphIndex> strides;
+            snap->for_each_node([&](const VersionedNode<int>& node) {
+                edges += node.degree();
+                node.for_each_neighbor([&](GraphIndex to) { strides.push_back((to + n - node.get_idx()) % n); });
+            });
+            const bool uniform = std::ranges::all_of(strides, [&](GraphIndex s) { return s == strides.front(); });
+            if ((snap->version() > 1 && edges != n) || !uniform) ++bad;
+        }
+    });
+
+    for (GraphIndex k = 1; k < 40; ++k)
+    {
+        GraphBatch<int> step;
+        for (GraphIndex i = 0; i < n; ++i)
+        {
+            step.remove_edges.emplace_back(i, (i + k - 1) % n);
+            step.add_edges.push_back({i, (i + k) % n});
+        }
+        (void)g.apply(step);
+    }
+    done = true;
+    reader.join();
+    EXPECT_EQ(bad.load(), 0zu);
+    EXPECT_EQ(g.snapshot()->version(), 40u);
+}
+
+} // namespace dsalgo::Test
+
+int main()
+{
+    using namespace dsalgo::Test;
+    test_matches_graph_apply(200, 2000, 400);
+    test_matches_graph_apply(400, 200000, 20000);
+    test_snapshots_are_stable_and_shared();
+    test_batch_copies_only_touched_data();
+    test_readers_during_writes();
+    return 0;
+}